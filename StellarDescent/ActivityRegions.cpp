@@ -0,0 +1,64 @@
+#include "ActivityRegions.h"
+
+namespace
+{
+    Rectangle Around(Vector2 p, float radius)
+    {
+        return { p.x - radius, p.y - radius, radius * 2.0f, radius * 2.0f };
+    }
+}
+
+void ActivityRegions::SetView(Rectangle v)
+{
+    view = { v.x - settings.viewMargin, v.y - settings.viewMargin,
+        v.width + settings.viewMargin * 2.0f, v.height + settings.viewMargin * 2.0f };
+    hasView = true;
+}
+
+void ActivityRegions::Step(ObstacleField& field, CollisionWorld& world, double t, Vector2 focus)
+{
+    // Fold the finished step (including its on-demand syncs) into the totals
+    posedTotal += stats.Posed();
+    steps++;
+
+    stats = Stats();
+    stats.total = field.Size();
+
+    // -------------------- SMALL FIELDS --------------------
+    if (field.Size() <= settings.fullRateMax) {
+        field.SetTime(t);
+        stats.active = stats.total;
+        return;
+    }
+
+    field.SetTimeDeferred(t);
+
+    // -------------------- ACTIVE REGION --------------------
+    world.Query(Around(focus, settings.activeRadius), ids);
+    stats.active += field.SyncMany(ids.data(), (int)ids.size());
+
+    if (hasView) {
+        world.Query(view, ids);
+        stats.active += field.SyncMany(ids.data(), (int)ids.size());
+    }
+
+    // -------------------- MIDDLE BAND --------------------
+    // Already-posed active obstacles are skipped by Sync()
+    if (settings.middleInterval <= 1 || steps % settings.middleInterval == 0) {
+        world.Query(Around(focus, settings.middleRadius), ids);
+        stats.middle += field.SyncMany(ids.data(), (int)ids.size());
+    }
+}
+
+double ActivityRegions::GetMeanPosed() const
+{
+    if (steps == 0) return 0.0;
+    return (double)(posedTotal + stats.Posed()) / (double)steps;
+}
+
+void ActivityRegions::ResetCounters()
+{
+    stats = Stats();
+    steps = 0;
+    posedTotal = 0;
+}
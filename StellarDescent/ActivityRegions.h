@@ -0,0 +1,85 @@
+#pragma once
+#include "raylib.h"
+#include <vector>
+
+#include "CollisionWorld.h"
+#include "ObstacleField.h"
+
+/**
+ * @brief Simulation level of detail for obstacles.
+ *
+ * Each step, obstacles whose motion envelope lies within the active
+ * radius of the rocket (or inside the camera view) are posed at full
+ * rate. A middle band is posed every few steps, and everything further
+ * out stays dormant. Because obstacle motion is a closed-form function of
+ * level time, a dormant obstacle is re-synced exactly whenever something
+ * touches it (ObstacleField::Sync), so collisions, and therefore gameplay
+ * results, are identical to posing everything every step.
+ *
+ * Small fields skip all of this: below FullRateMax obstacles one SIMD
+ * pass over the field is cheaper than the region queries.
+ */
+class ActivityRegions {
+public:
+    struct Settings {
+        float activeRadius = 600.0f;   // px around the rocket, full rate
+        float middleRadius = 1200.0f;  // px around the rocket, reduced rate
+        int middleInterval = 8;        // middle band is posed every N steps
+        float viewMargin = 64.0f;      // px added around the camera view
+        int fullRateMax = 4096;        // pose everything up to this many
+    };
+
+    /// Obstacle counts for one step.
+    struct Stats {
+        int total = 0;
+        int active = 0;    // posed by the active region
+        int middle = 0;    // posed by the middle band
+        int onDemand = 0;  // posed because a query touched them (Sync)
+
+        int Posed() const { return active + middle + onDemand; }
+        int Dormant() const { return total - Posed(); }
+    };
+
+    ActivityRegions() = default;
+    explicit ActivityRegions(const Settings& settings) : settings(settings) {}
+
+    const Settings& GetSettings() const { return settings; }
+    void SetSettings(const Settings& s) { settings = s; }
+
+    /// Keep obstacles inside this world-space rectangle at full rate.
+    void SetView(Rectangle view);
+    void ClearView() { hasView = false; }
+
+    /**
+     * @brief Move the field to level time @p t, posing what is near @p focus.
+     *
+     * @p world must index @p field (same obstacles, same order).
+     */
+    void Step(ObstacleField& field, CollisionWorld& world, double t, Vector2 focus);
+
+    /// Pose obstacle @p id for this step if it is stale, counting it.
+    void Sync(ObstacleField& field, int id)
+    {
+        if (field.Sync(id)) stats.onDemand++;
+    }
+
+    /// Counts for the last Step() (and the Sync() calls after it).
+    const Stats& GetStats() const { return stats; }
+
+    /// Mean obstacles posed per step since the last ResetCounters().
+    double GetMeanPosed() const;
+
+    void ResetCounters();
+
+private:
+    Settings settings;
+
+    Rectangle view = { 0, 0, 0, 0 };
+    bool hasView = false;
+
+    Stats stats;
+    long long steps = 0;
+    long long posedTotal = 0;   // excluding the current step's stats
+
+    std::vector<int> ids;
+};
@@ -0,0 +1,221 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "StateHash.h"
+
+using namespace AssetArchiveFormat;
+
+namespace
+{
+    bool Fail(std::string* error, const char* path, const char* what)
+    {
+        if (error) *error = std::string(path) + ": " + what;
+        return false;
+    }
+
+    size_t AlignUp(size_t offset) { return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, size_t offset, const T& value)
+    {
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+}
+
+// -------------------- ARCHIVE --------------------
+bool AssetArchive::Open(const char* filePath, std::string* error)
+{
+    Close();
+
+    MappedFile mapped;
+    if (!mapped.Open(filePath, error)) return false;
+    const uint8_t* bytes = mapped.GetData();
+    const size_t size = mapped.GetSize();
+
+    if (size < sizeof(Header)) return Fail(error, filePath, "too small for an asset archive");
+    const Header* h = (const Header*)bytes;
+    if (h->magic != MAGIC) return Fail(error, filePath, "not an asset archive");
+    if (h->version != VERSION) return Fail(error, filePath, "asset archive version not supported (cook it again)");
+    if (h->fileSize != size) return Fail(error, filePath, "asset archive truncated or padded");
+
+    // Table of contents: small, so it is checked in full here
+    if (h->entryOffset % 8 != 0 || h->entryOffset < sizeof(Header) || h->entryOffset > size ||
+        (uint64_t)h->entryCount * sizeof(Entry) > size - h->entryOffset ||
+        h->stringOffset < sizeof(Header) || h->stringOffset > size || h->stringBytes > size - h->stringOffset ||
+        h->stringBytes == 0 || bytes[h->stringOffset + h->stringBytes - 1] != 0) {
+        return Fail(error, filePath, "asset archive table of contents out of bounds");
+    }
+
+    StateHash toc;
+    toc.Add(HashBytes(bytes + h->entryOffset, (size_t)h->entryCount * sizeof(Entry)));
+    toc.Add(HashBytes(bytes + h->stringOffset, h->stringBytes));
+    if (toc.Get() != h->tocHash) return Fail(error, filePath, "asset archive table of contents damaged");
+
+    const Entry* e = (const Entry*)(bytes + h->entryOffset);
+    for (uint32_t i = 0; i < h->entryCount; ++i) {
+        if (e[i].name >= h->stringBytes || e[i].offset % ALIGNMENT != 0 ||
+            e[i].offset > size || e[i].size > size - e[i].offset) {
+            return Fail(error, filePath, "asset archive entry out of bounds");
+        }
+    }
+
+    file = std::move(mapped);
+    path = filePath;
+    header = h;
+    entries = e;
+    strings = (const char*)(bytes + h->stringOffset);
+    return true;
+}
+
+void AssetArchive::Close()
+{
+    file.Close();
+    path.clear();
+    header = nullptr;
+    entries = nullptr;
+    strings = nullptr;
+}
+
+int AssetArchive::Find(const char* name) const
+{
+    // Entries are sorted by name
+    int lo = 0, hi = GetEntryCount();
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int c = std::strcmp(GetName(mid), name);
+        if (c == 0) return mid;
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return -1;
+}
+
+void AssetArchive::PageIn(int index) const
+{
+    const Entry& e = entries[index];
+    file.WillNeed((size_t)e.offset, (size_t)e.size);
+
+    // 4 KiB is the smallest page anywhere we run; on larger pages this
+    // only touches some twice
+    const uint8_t* data = GetData(index);
+    uint8_t sum = 0;
+    for (uint64_t i = 0; i < e.size; i += 4096) sum ^= data[i];
+    if (e.size > 0) sum ^= data[e.size - 1];
+    volatile uint8_t sink = sum;
+    (void)sink;
+}
+
+bool AssetArchive::VerifyEntry(int index) const
+{
+    const Entry& e = entries[index];
+    return HashBytes(GetData(index), (size_t)e.size) == e.hash;
+}
+
+uint64_t AssetArchive::HashBytes(const uint8_t* data, size_t size)
+{
+    // Four independent chains over interleaved words: one chain is bound
+    // by the mixer's latency, four keep up with streaming from disk
+    StateHash lanes[4];
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        uint64_t words[4];
+        std::memcpy(words, data + i, 32);
+        for (int k = 0; k < 4; ++k) lanes[k].Add(words[k]);
+    }
+    for (int k = 0; i < size; i += 8, k = (k + 1) % 4) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, size - i < 8 ? size - i : 8);
+        lanes[k].Add(word);
+    }
+
+    StateHash h;
+    h.Add((uint64_t)size);
+    for (const StateHash& lane : lanes) h.Add(lane.Get());
+    return h.Get();
+}
+
+// -------------------- WRITER --------------------
+void AssetArchiveWriter::Add(const std::string& name, AssetType type,
+    std::initializer_list<uint32_t> params, const void* data, size_t size)
+{
+    Asset asset;
+    asset.name = name;
+    asset.type = type;
+    std::fill(std::begin(asset.params), std::end(asset.params), 0u);
+    std::copy_n(params.begin(), std::min((int)params.size(), PARAM_COUNT), asset.params);
+    asset.bytes.assign((const uint8_t*)data, (const uint8_t*)data + size);
+    assets.push_back(std::move(asset));
+}
+
+bool AssetArchiveWriter::Build(std::vector<uint8_t>& out, std::string& error) const
+{
+    std::vector<const Asset*> sorted;
+    for (const Asset& a : assets) sorted.push_back(&a);
+    std::sort(sorted.begin(), sorted.end(), [](const Asset* a, const Asset* b) { return a->name < b->name; });
+
+    std::string names;
+    std::vector<uint32_t> nameOffsets;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        if (sorted[i]->name.empty()) {
+            error = "asset with an empty name";
+            return false;
+        }
+        if (i > 0 && sorted[i]->name == sorted[i - 1]->name) {
+            error = "asset added twice: " + sorted[i]->name;
+            return false;
+        }
+        nameOffsets.push_back((uint32_t)names.size());
+        names += sorted[i]->name;
+        names += '\0';
+    }
+    if (names.empty()) names += '\0';
+
+    // -------------------- LAYOUT --------------------
+    Header h = {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.entryCount = (uint32_t)sorted.size();
+    h.entryOffset = (uint32_t)sizeof(Header);
+    h.stringOffset = (uint32_t)(h.entryOffset + sorted.size() * sizeof(Entry));
+    h.stringBytes = (uint32_t)names.size();
+
+    std::vector<Entry> entries(sorted.size());
+    size_t offset = AlignUp(h.stringOffset + names.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const Asset& a = *sorted[i];
+        Entry& e = entries[i];
+        e = {};
+        e.name = nameOffsets[i];
+        e.type = a.type;
+        e.offset = offset;
+        e.size = a.bytes.size();
+        e.hash = AssetArchive::HashBytes(a.bytes.data(), a.bytes.size());
+        std::copy(std::begin(a.params), std::end(a.params), e.params);
+        offset = AlignUp(offset + a.bytes.size());
+    }
+    h.fileSize = offset;
+
+    out.assign(offset, 0);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        Put(out, h.entryOffset + i * sizeof(Entry), entries[i]);
+        if (!sorted[i]->bytes.empty()) {
+            std::memcpy(out.data() + entries[i].offset, sorted[i]->bytes.data(), sorted[i]->bytes.size());
+        }
+    }
+    std::memcpy(out.data() + h.stringOffset, names.data(), names.size());
+
+    StateHash toc;
+    toc.Add(AssetArchive::HashBytes(out.data() + h.entryOffset, entries.size() * sizeof(Entry)));
+    toc.Add(AssetArchive::HashBytes(out.data() + h.stringOffset, names.size()));
+    h.tocHash = toc.Get();
+    Put(out, 0, h);
+    return true;
+}
+
+bool AssetArchiveWriter::Write(const char* path, std::string& error) const
+{
+    std::vector<uint8_t> image;
+    return Build(image, error) && MappedFile::Replace(path, image.data(), image.size(), error);
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "MappedFile.h"
+
+/**
+ * @brief On-disk layout of a cooked asset archive (*.sdpak).
+ *
+ * One header, a table of contents (one Entry per asset, sorted by name),
+ * a string table of NUL-terminated names, then every asset's payload at a
+ * 64-byte aligned offset. Payloads are already in the form the game hands
+ * to raylib (decoded pixels, rasterized font atlases, converted PCM), so
+ * loading one is a copy to the GPU or audio device and nothing else.
+ * asset_cook writes it; all fields are little-endian.
+ *
+ * Names are the paths the game used to load the loose files with, relative
+ * to assets/ ("textures/starfield.png").
+ */
+namespace AssetArchiveFormat
+{
+    constexpr uint32_t MAGIC = 0x52414453;   // "SDAR"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t ALIGNMENT = 64;
+    constexpr int PARAM_COUNT = 6;
+
+    enum class AssetType : uint32_t {
+        TEXTURE = 1,   // pixels in the texture's raylib PixelFormat
+        FONT = 2,      // Glyph records, then the atlas pixels
+        SOUND = 3,     // PCM frames
+        STREAM = 4,    // the source file as is (music, decoded while it plays)
+    };
+
+    // Entry::params by type
+    enum TextureParam { TEXTURE_WIDTH, TEXTURE_HEIGHT, TEXTURE_FORMAT, TEXTURE_MIPMAPS };
+    enum FontParam { FONT_BASE_SIZE, FONT_GLYPH_COUNT, FONT_GLYPH_PADDING, FONT_ATLAS_WIDTH, FONT_ATLAS_HEIGHT, FONT_ATLAS_FORMAT };
+    enum SoundParam { SOUND_FRAME_COUNT, SOUND_SAMPLE_RATE, SOUND_SAMPLE_SIZE, SOUND_CHANNELS };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fileSize;
+        uint64_t tocHash;            // of the entries and the string table
+        uint32_t entryCount;
+        uint32_t entryOffset;
+        uint32_t stringBytes;
+        uint32_t stringOffset;
+        uint32_t reserved[6];        // zero
+    };
+
+    struct Entry {
+        uint32_t name;               // string table offset
+        AssetType type;
+        uint64_t offset;             // payload, ALIGNMENT-aligned
+        uint64_t size;
+        uint64_t hash;               // AssetArchive::HashBytes of the payload
+        uint32_t params[PARAM_COUNT];
+    };
+
+    /// One glyph of a FONT: raylib's GlyphInfo (without its image) plus its atlas rectangle.
+    struct Glyph {
+        int32_t value;               // codepoint
+        int32_t offsetX;
+        int32_t offsetY;
+        int32_t advanceX;
+        float x;
+        float y;
+        float width;
+        float height;
+    };
+
+    static_assert(sizeof(Header) == 64, "asset archive header layout changed");
+    static_assert(sizeof(Entry) == 56, "asset archive entry layout changed");
+    static_assert(sizeof(Glyph) == 32, "asset archive glyph layout changed");
+    static_assert(std::is_trivially_copyable<Entry>::value && std::is_standard_layout<Entry>::value,
+        "asset archive records are used in place");
+}
+
+/**
+ * @brief A cooked asset archive, mapped and used in place.
+ *
+ * Open() checks the header and the table of contents (every payload lies
+ * inside the file) but reads no payload, so it costs the same for any
+ * archive size; AssetLoader pages the payloads in on a worker thread.
+ */
+class AssetArchive {
+public:
+    /// Map and check an archive. Leaves it closed on failure.
+    bool Open(const char* path, std::string* error = nullptr);
+
+    void Close();
+
+    bool IsOpen() const { return header != nullptr; }
+    const std::string& GetPath() const { return path; }
+    size_t GetSize() const { return file.GetSize(); }
+
+    int GetEntryCount() const { return header ? (int)header->entryCount : 0; }
+    const AssetArchiveFormat::Entry& GetEntry(int index) const { return entries[index]; }
+    const char* GetName(int index) const { return strings + entries[index].name; }
+    const uint8_t* GetData(int index) const { return file.GetData() + entries[index].offset; }
+
+    /// Entry index of @p name, or -1.
+    int Find(const char* name) const;
+
+    /// Fault the entry's payload in from disk: read-ahead advice, then one
+    /// read per page. Checks nothing.
+    void PageIn(int index) const;
+
+    /// Recompute the entry's payload hash and compare (reads every byte).
+    bool VerifyEntry(int index) const;
+
+    static uint64_t HashBytes(const uint8_t* data, size_t size);
+
+private:
+    MappedFile file;
+    std::string path;
+
+    const AssetArchiveFormat::Header* header = nullptr;
+    const AssetArchiveFormat::Entry* entries = nullptr;
+    const char* strings = nullptr;
+};
+
+/**
+ * @brief Lays out a cooked asset archive (asset_cook, tests).
+ */
+class AssetArchiveWriter {
+public:
+    /// Add an asset; @p params are the type's Entry::params (missing ones are zero).
+    void Add(const std::string& name, AssetArchiveFormat::AssetType type,
+        std::initializer_list<uint32_t> params, const void* data, size_t size);
+
+    int GetEntryCount() const { return (int)assets.size(); }
+
+    /// The archive image. Fails on duplicate or empty names.
+    bool Build(std::vector<uint8_t>& out, std::string& error) const;
+
+    /// Build and write it over @p path (see MappedFile::Replace).
+    bool Write(const char* path, std::string& error) const;
+
+private:
+    struct Asset {
+        std::string name;
+        AssetArchiveFormat::AssetType type;
+        uint32_t params[AssetArchiveFormat::PARAM_COUNT];
+        std::vector<uint8_t> bytes;
+    };
+    std::vector<Asset> assets;
+};
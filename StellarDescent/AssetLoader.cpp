@@ -0,0 +1,90 @@
+#include "AssetLoader.h"
+#include <chrono>
+
+#include "AssetArchive.h"
+
+AssetLoader::AssetLoader(const AssetArchive& archive, bool verifyPayloads)
+    : archive(archive),
+    verifyPayloads(verifyPayloads),
+    entryCount(archive.GetEntryCount()),
+    states(new std::atomic<int>[entryCount > 0 ? entryCount : 1])
+{
+    for (int i = 0; i < entryCount; ++i) {
+        states[i].store(QUEUED, std::memory_order_relaxed);
+        totalBytes += (size_t)archive.GetEntry(i).size;
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    worker.join();
+}
+
+void AssetLoader::Start()
+{
+    if (worker.joinable()) return;
+    worker = std::thread([this]() { WorkerLoop(); });
+}
+
+float AssetLoader::GetProgress() const
+{
+    if (totalBytes == 0) return IsDone() ? 1.0f : 0.0f;
+    return (float)((double)streamedBytes.load(std::memory_order_relaxed) / (double)totalBytes);
+}
+
+bool AssetLoader::Wait(int index)
+{
+    if (!worker.joinable() && states[index].load(std::memory_order_acquire) == QUEUED) Stream(index);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    streamed.wait(lock, [&]() { return states[index].load(std::memory_order_acquire) != QUEUED; });
+    return states[index].load(std::memory_order_acquire) == STREAMED;
+}
+
+AssetLoader::Stats AssetLoader::GetStats() const
+{
+    Stats stats;
+    for (int i = 0; i < entryCount; ++i) {
+        int state = states[i].load(std::memory_order_acquire);
+        if (state == STREAMED) stats.streamed++;
+        else if (state == FAILED) stats.failed++;
+    }
+    stats.bytes = streamedBytes.load(std::memory_order_relaxed);
+    stats.workerSeconds = (double)workerMicros.load(std::memory_order_relaxed) * 1e-6;
+    return stats;
+}
+
+// -------------------- STREAMING --------------------
+void AssetLoader::Stream(int index)
+{
+    // Either way every page of the payload is read
+    bool ok = true;
+    if (verifyPayloads) ok = archive.VerifyEntry(index);
+    else archive.PageIn(index);
+    streamedBytes.fetch_add((size_t)archive.GetEntry(index).size, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        states[index].store(ok ? STREAMED : FAILED, std::memory_order_release);
+    }
+    finished.fetch_add(1, std::memory_order_acq_rel);
+    streamed.notify_all();
+}
+
+void AssetLoader::WorkerLoop()
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < entryCount; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return;
+        }
+        if (states[i].load(std::memory_order_acquire) == QUEUED) Stream(i);
+    }
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    workerMicros.store((long long)micros.count(), std::memory_order_relaxed);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class AssetArchive;
+
+/**
+ * @brief Streams a mapped AssetArchive in on a background thread.
+ *
+ * The archive is mapped, so loading an entry means faulting its pages in
+ * from disk, which the worker does with one read per page. Entries are
+ * streamed in archive order while the main thread draws a loading screen
+ * from GetProgress(); by the time it creates textures and sounds from
+ * them, nothing is left to read or decode. Only the main thread calls the
+ * public methods.
+ *
+ * Payload hashes are not checked at startup by default: that reads every
+ * byte on every launch, for damage asset_cook --check finds once. Tools
+ * pass verifyPayloads to have each entry hashed as it streams.
+ */
+class AssetLoader {
+public:
+    struct Stats {
+        int streamed = 0;           // entries paged in (and verified, if asked)
+        int failed = 0;             // entries whose payload hash did not match (verifyPayloads only)
+        size_t bytes = 0;           // payload bytes streamed
+        double workerSeconds = 0.0; // from Start() until the worker finished
+    };
+
+    /// @p archive must stay open while the loader exists.
+    explicit AssetLoader(const AssetArchive& archive, bool verifyPayloads = false);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /// Start streaming every entry.
+    void Start();
+
+    /// Every entry streamed (or failed).
+    bool IsDone() const { return finished.load(std::memory_order_acquire) == entryCount; }
+
+    /// Fraction of payload bytes streamed, for a progress bar.
+    float GetProgress() const;
+
+    /**
+     * @brief Block until entry @p index is streamed.
+     *
+     * Streams it on the calling thread if the worker was never started.
+     * @return false if its payload is damaged (load the loose file instead);
+     * always true unless verifyPayloads.
+     */
+    bool Wait(int index);
+
+    Stats GetStats() const;
+
+private:
+    enum State : int { QUEUED, STREAMED, FAILED };
+
+    const AssetArchive& archive;
+    bool verifyPayloads;
+    int entryCount = 0;
+    size_t totalBytes = 0;
+    std::unique_ptr<std::atomic<int>[]> states;
+    std::atomic<int> finished{ 0 };
+    std::atomic<size_t> streamedBytes{ 0 };
+    std::atomic<long long> workerMicros{ 0 };
+
+    std::mutex mutex;
+    std::condition_variable streamed;   // an entry finished
+    bool stopping = false;
+    std::thread worker;
+
+    void Stream(int index);
+    void WorkerLoop();
+};
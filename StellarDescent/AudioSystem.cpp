@@ -1,18 +1,19 @@
 #include "AudioSystem.h"
+#include "GameAssets.h"
 #include "raylib.h"
 
-void AudioSystem::Init() {
+void AudioSystem::Init(GameAssets& assets) {
     // Initialize audio hardware
     InitAudioDevice();
     SetMasterVolume(1.0f);
 
     // Load background music (looped by default)
-    bgMusic = LoadMusicStream("assets/audio/music.wav");
+    bgMusic = assets.LoadMusic("audio/music.wav");
 
     // Load sound effects
-    sfxThrust = LoadMusicStream("assets/audio/thrust.wav");
-    sfxCrash = LoadSound("assets/audio/crash.wav");
-    sfxLand = LoadSound("assets/audio/land.wav");
+    sfxThrust = assets.LoadMusic("audio/thrust.wav");
+    sfxCrash = assets.LoadSound("audio/crash.wav");
+    sfxLand = assets.LoadSound("audio/land.wav");
 
     // Start background music
     PlayMusicStream(bgMusic);
@@ -1,6 +1,8 @@
 #pragma once
 #include "raylib.h"
 
+class GameAssets;
+
 /**
  * @brief Handles all audio functionality for the Stellar Descent game.
  *
@@ -15,8 +17,10 @@ public:
      *
      * Opens the audio device and loads all music and sound assets.
      * This should be called once at the start of the game.
+     *
+     * @param assets Where the music and sounds come from (cooked or loose).
      */
-    void Init();
+    void Init(GameAssets& assets);
 
     /**
      * @brief Update the audio system.
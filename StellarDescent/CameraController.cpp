@@ -1,20 +1,25 @@
 #include "CameraController.h"
 #include "raymath.h" // for Vector2Lerp
+#include "SimMath.h"
 
 void CameraController::Init(Vector2 startPos) {
     camera.target = startPos;
     camera.offset = { 640, 360 };
     camera.rotation = 0.0f;
     camera.zoom = 1.0f;
+    prevTarget = startPos;
 }
 
 void CameraController::Update(Vector2 target, float dt) {
+    prevTarget = camera.target;
+
     // Smooth follow using linear interpolation
     Vector2 desired = target;
 
-    // Lerp each axis separately
-    camera.target.x = camera.target.x + (desired.x - camera.target.x) * (1 - expf(-dt / smoothTime));
-    camera.target.y = camera.target.y + (desired.y - camera.target.y) * (1 - expf(-dt / smoothTime));
+    // Lerp each axis separately (owned exp: a replay frames the same everywhere)
+    float follow = 1 - SimMath::Exp(-dt / smoothTime);
+    camera.target.x = camera.target.x + (desired.x - camera.target.x) * follow;
+    camera.target.y = camera.target.y + (desired.y - camera.target.y) * follow;
 
     // Clamp to scroll limits
     if (camera.target.x < minScroll.x) camera.target.x = minScroll.x;
@@ -22,3 +27,17 @@ void CameraController::Update(Vector2 target, float dt) {
     if (camera.target.y < minScroll.y) camera.target.y = minScroll.y;
     if (camera.target.y > maxScroll.y) camera.target.y = maxScroll.y;
 }
+
+void CameraController::Shift(Vector2 delta) {
+    camera.target.x += delta.x;
+    camera.target.y += delta.y;
+    prevTarget.x += delta.x;
+    prevTarget.y += delta.y;
+}
+
+Camera2D CameraController::GetRenderCamera(float alpha) const {
+    Camera2D render = camera;
+    render.target.x = prevTarget.x + (camera.target.x - prevTarget.x) * alpha;
+    render.target.y = prevTarget.y + (camera.target.y - prevTarget.y) * alpha;
+    return render;
+}
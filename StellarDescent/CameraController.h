@@ -31,11 +31,22 @@ public:
      */
     void Update(Vector2 target, float dt);  // pass dt for smoothing
 
+    /**
+     * @brief Camera to render with, blended between the last two updates.
+     *
+     * @param alpha Interpolation factor (0 = previous update, 1 = latest).
+     */
+    Camera2D GetRenderCamera(float alpha) const;
+
+    /// Move the camera by @p delta without smoothing (floating-origin rebase).
+    void Shift(Vector2 delta);
+
     Vector2 minScroll = { -1000, -1000 }; // left/top world bounds
     Vector2 maxScroll = { 1000, 1000 };   // right/bottom world bounds
 
 private:
 
+    Vector2 prevTarget = { 0, 0 }; // target before the last Update (render interpolation)
     Vector2 velocity = { 0, 0 }; // for smooth dampening
     const float smoothTime = 0.1f; // smoothing factor
 };
@@ -0,0 +1,220 @@
+#include "ChunkStreamer.h"
+
+ChunkStreamer::ChunkStreamer(Generator generator)
+    : generator(generator)
+{
+    // All chunk storage up front: exploring never grows it
+    for (Slot& slot : slots) slot.obstacles.reserve(MAX_OBSTACLES_PER_CHUNK);
+
+    worker = std::thread([this]() { WorkerLoop(); });
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void ChunkStreamer::Reset(uint64_t newSeed)
+{
+    // Wait out anything the worker is building, then drop every chunk
+    std::unique_lock<std::mutex> lock(mutex);
+    queue.clear();
+    built.wait(lock, [this]() {
+        for (const Slot& slot : slots) {
+            if (slot.state.load(std::memory_order_acquire) == BUILDING) return false;
+        }
+        return true;
+    });
+
+    for (Slot& slot : slots) {
+        slot.obstacles.clear();
+        slot.state.store(FREE, std::memory_order_relaxed);
+    }
+    seed = newSeed;
+}
+
+// -------------------- SLOTS --------------------
+int ChunkStreamer::Find(ChunkCoord coord) const
+{
+    for (int i = 0; i < POOL_SIZE; ++i) {
+        if (slots[i].state.load(std::memory_order_acquire) != FREE && slots[i].coord == coord) return i;
+    }
+    return -1;
+}
+
+int ChunkStreamer::Allocate(ChunkCoord coord)
+{
+    int slot = -1;
+    for (int i = 0; i < POOL_SIZE && slot < 0; ++i) {
+        if (slots[i].state.load(std::memory_order_acquire) == FREE) slot = i;
+    }
+    if (slot < 0) return -1;
+
+    slots[slot].coord = coord;
+    slots[slot].seed = seed;
+    return slot;
+}
+
+void ChunkStreamer::Free(int slot)
+{
+    slots[slot].obstacles.clear();
+    slots[slot].state.store(FREE, std::memory_order_release);
+    stats.released++;
+}
+
+int ChunkStreamer::Reclaim(ChunkCoord coord)
+{
+    // Pool exhausted (callers release first, so this is a bug upstream):
+    // recycle a finished chunk, else take back one still queued, else wait
+    // for the worker to finish one, rather than fail
+    for (;;) {
+        for (int i = 0; i < POOL_SIZE; ++i) {
+            if (slots[i].state.load(std::memory_order_acquire) == READY) {
+                Free(i);
+                return Allocate(coord);
+            }
+        }
+        for (int i = 0; i < POOL_SIZE; ++i) {
+            int expected = QUEUED;
+            if (slots[i].state.compare_exchange_strong(expected, FREE, std::memory_order_acq_rel)) {
+                stats.released++;
+                return Allocate(coord);
+            }
+        }
+
+        stats.waits++;
+        std::unique_lock<std::mutex> lock(mutex);
+        built.wait(lock, [this]() {
+            for (const Slot& slot : slots) {
+                if (slot.state.load(std::memory_order_acquire) == READY) return true;
+            }
+            return false;
+        });
+    }
+}
+
+void ChunkStreamer::Build(int slot)
+{
+    Slot& s = slots[slot];
+    s.obstacles.clear();
+    generator(s.seed, s.coord, s.obstacles);
+}
+
+// -------------------- MAIN THREAD --------------------
+bool ChunkStreamer::Prefetch(ChunkCoord coord)
+{
+    if (Find(coord) >= 0) return true;
+
+    int slot = Allocate(coord);
+    if (slot < 0) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        slots[slot].state.store(QUEUED, std::memory_order_release);
+        queue.push_back(slot);
+    }
+    wake.notify_one();
+    return true;
+}
+
+const std::vector<MovingObstacle>& ChunkStreamer::Require(ChunkCoord coord)
+{
+    int slot = Find(coord);
+
+    if (slot < 0) {
+        slot = Allocate(coord);
+        if (slot < 0) slot = Reclaim(coord);
+        slots[slot].state.store(BUILDING, std::memory_order_relaxed);
+        Build(slot);
+        slots[slot].state.store(READY, std::memory_order_release);
+        stats.generatedInline++;
+        return slots[slot].obstacles;
+    }
+
+    // Still queued: take it off the worker and build it here
+    int expected = QUEUED;
+    if (slots[slot].state.compare_exchange_strong(expected, BUILDING, std::memory_order_acq_rel)) {
+        Build(slot);
+        slots[slot].state.store(READY, std::memory_order_release);
+        stats.generatedInline++;
+        return slots[slot].obstacles;
+    }
+
+    // The worker is on it right now: wait for it to finish
+    if (slots[slot].state.load(std::memory_order_acquire) != READY) {
+        stats.waits++;
+        std::unique_lock<std::mutex> lock(mutex);
+        built.wait(lock, [&]() { return slots[slot].state.load(std::memory_order_acquire) == READY; });
+    }
+    return slots[slot].obstacles;
+}
+
+void ChunkStreamer::Release(ChunkCoord coord)
+{
+    int slot = Find(coord);
+    if (slot >= 0) Release(slot);
+}
+
+void ChunkStreamer::Release(int slot)
+{
+    // A queued chunk is dropped before the worker reaches it (the worker
+    // skips its stale queue entry); one being built is released later
+    int expected = QUEUED;
+    if (slots[slot].state.compare_exchange_strong(expected, FREE, std::memory_order_acq_rel)) {
+        stats.released++;
+        return;
+    }
+    if (expected == READY) Free(slot);
+}
+
+ChunkStreamer::Stats ChunkStreamer::GetStats() const
+{
+    Stats out = stats;
+    out.prefetched = workerBuilt.load(std::memory_order_relaxed);
+    out.inUse = 0;
+    for (const Slot& slot : slots) {
+        if (slot.state.load(std::memory_order_acquire) != FREE) out.inUse++;
+    }
+    return out;
+}
+
+size_t ChunkStreamer::GetReservedBytes() const
+{
+    size_t bytes = 0;
+    for (const Slot& slot : slots) bytes += slot.obstacles.capacity() * sizeof(MovingObstacle);
+    return bytes;
+}
+
+// -------------------- WORKER THREAD --------------------
+void ChunkStreamer::WorkerLoop()
+{
+    for (;;) {
+        int slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) return;
+
+            slot = queue.front();
+            queue.pop_front();
+
+            // Skip entries the main thread built or dropped meanwhile
+            int expected = QUEUED;
+            if (!slots[slot].state.compare_exchange_strong(expected, BUILDING, std::memory_order_acq_rel)) continue;
+        }
+
+        Build(slot);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slots[slot].state.store(READY, std::memory_order_release);
+        }
+        workerBuilt.fetch_add(1, std::memory_order_relaxed);
+        built.notify_all();
+    }
+}
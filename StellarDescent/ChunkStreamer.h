@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MovingObstacle.h"
+
+/// Integer chunk coordinate in the absolute (never rebased) world grid.
+struct ChunkCoord {
+    int64_t x = 0;
+    int64_t y = 0;
+
+    bool operator==(const ChunkCoord& o) const { return x == o.x && y == o.y; }
+    bool operator!=(const ChunkCoord& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Generates world chunks on a background thread into a fixed pool.
+ *
+ * A chunk is the list of obstacles of one square of the world, in
+ * chunk-local coordinates, produced by a generator that depends only on
+ * (seed, coordinate). Prefetch() queues a chunk for the worker; Require()
+ * returns it ready to use, generating it on the calling thread only if the
+ * worker has not got to it yet (counted in Stats::generatedInline). Release()
+ * recycles the slot.
+ *
+ * The pool has POOL_SIZE slots whose obstacle lists are reserved up front,
+ * so memory stays the same however far the world is explored. Only the
+ * main thread calls the public methods.
+ */
+class ChunkStreamer {
+public:
+    static constexpr int POOL_SIZE = 48;
+    static constexpr int MAX_OBSTACLES_PER_CHUNK = 64;
+
+    /// Fills @p out (already cleared) with the chunk's obstacles.
+    using Generator = void (*)(uint64_t seed, ChunkCoord coord, std::vector<MovingObstacle>& out);
+
+    struct Stats {
+        long long prefetched = 0;       // chunks generated by the worker
+        long long generatedInline = 0;  // chunks the main thread had to generate itself
+        long long waits = 0;            // Require() calls that blocked on the worker
+        long long released = 0;
+        int inUse = 0;                  // slots holding, queued for or building a chunk
+    };
+
+    explicit ChunkStreamer(Generator generator);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    /// Drop every chunk and start a new world from @p seed.
+    void Reset(uint64_t seed);
+
+    /**
+     * @brief Queue a chunk for the worker.
+     *
+     * No-op if it is already queued or ready. @return false when the pool
+     * is full.
+     */
+    bool Prefetch(ChunkCoord coord);
+
+    /// The chunk's obstacles, generating them now if need be (never null).
+    const std::vector<MovingObstacle>& Require(ChunkCoord coord);
+
+    /// True if @p coord holds a slot (queued, building or ready).
+    bool Contains(ChunkCoord coord) const { return Find(coord) >= 0; }
+
+    /// Recycle the chunk's slot.
+    void Release(ChunkCoord coord);
+
+    /**
+     * @brief Release every chunk for which @p keep returns false.
+     *
+     * Queued chunks are dropped before the worker gets to them; slots the
+     * worker is still building are left alone.
+     */
+    template <typename Keep>
+    void ReleaseUnless(Keep keep)
+    {
+        for (int i = 0; i < POOL_SIZE; ++i) {
+            int state = slots[i].state.load(std::memory_order_acquire);
+            if ((state == QUEUED || state == READY) && !keep(slots[i].coord)) Release(i);
+        }
+    }
+
+    Stats GetStats() const;
+
+    /// Bytes reserved for chunk obstacle lists (constant after construction).
+    size_t GetReservedBytes() const;
+
+private:
+    enum State : int { FREE, QUEUED, BUILDING, READY };
+
+    struct Slot {
+        std::atomic<int> state{ FREE };
+        ChunkCoord coord;
+        uint64_t seed = 0;
+        std::vector<MovingObstacle> obstacles;
+    };
+
+    Generator generator;
+    uint64_t seed = 0;
+    Slot slots[POOL_SIZE];
+    Stats stats;
+    std::atomic<long long> workerBuilt{ 0 };
+
+    // Worker queue: slot indices in request order
+    std::mutex mutex;
+    std::condition_variable wake;   // work queued or stopping
+    std::condition_variable built;  // a slot finished building
+    std::deque<int> queue;
+    bool stopping = false;
+    std::thread worker;
+
+    int Find(ChunkCoord coord) const;
+    int Allocate(ChunkCoord coord);
+    int Reclaim(ChunkCoord coord);
+    void Free(int slot);
+    void Release(int slot);
+    void Build(int slot);
+    void WorkerLoop();
+};
@@ -0,0 +1,113 @@
+#include "CollisionWorld.h"
+#include <algorithm>
+#include <cmath>
+
+CollisionWorld::CollisionWorld(float cellSize)
+    : cellSize(cellSize),
+    invCellSize(1.0f / cellSize)
+{
+}
+
+CollisionWorld::CellRange CollisionWorld::RangeFor(Rectangle b) const
+{
+    CellRange r;
+    r.minX = (int)floorf(b.x * invCellSize);
+    r.minY = (int)floorf(b.y * invCellSize);
+    r.maxX = (int)floorf((b.x + b.width) * invCellSize);
+    r.maxY = (int)floorf((b.y + b.height) * invCellSize);
+    return r;
+}
+
+uint32_t CollisionWorld::BucketFor(int cx, int cy) const
+{
+    uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u;
+    return h & bucketMask;
+}
+
+void CollisionWorld::Insert(int id, const CellRange& r)
+{
+    for (int cy = r.minY; cy <= r.maxY; ++cy) {
+        for (int cx = r.minX; cx <= r.maxX; ++cx) {
+            buckets[BucketFor(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void CollisionWorld::Remove(int id, const CellRange& r)
+{
+    for (int cy = r.minY; cy <= r.maxY; ++cy) {
+        for (int cx = r.minX; cx <= r.maxX; ++cx) {
+            std::vector<int>& bucket = buckets[BucketFor(cx, cy)];
+
+            // Order inside a bucket does not matter: swap-with-last
+            auto it = std::find(bucket.begin(), bucket.end(), id);
+            if (it != bucket.end()) {
+                *it = bucket.back();
+                bucket.pop_back();
+            }
+        }
+    }
+}
+
+void CollisionWorld::Rebuild(const ObstacleField& obstacles)
+{
+    // -------------------- BUCKET ARRAY --------------------
+    // About two buckets per obstacle keeps chains short; never below 1024
+    uint32_t bucketCount = 1024;
+    while (bucketCount < (uint32_t)obstacles.Size() * 2) bucketCount <<= 1;
+
+    if (buckets.size() != bucketCount) {
+        buckets.assign(bucketCount, {});
+    }
+    else {
+        for (auto& b : buckets) b.clear();   // keep capacity
+    }
+    bucketMask = bucketCount - 1;
+
+    // -------------------- REGISTER --------------------
+    ranges.resize(obstacles.Size());
+    stamps.assign(obstacles.Size(), 0);
+    stamp = 0;
+    moveCount = 0;
+
+    for (int i = 0; i < obstacles.Size(); ++i) {
+        ranges[i] = RangeFor(obstacles.GetMotionBounds(i));
+        Insert(i, ranges[i]);
+    }
+}
+
+void CollisionWorld::Update(int id, const ObstacleField& obstacles)
+{
+    if (id < 0 || id >= (int)ranges.size()) return;
+
+    CellRange r = RangeFor(obstacles.GetMotionBounds(id));
+    if (r == ranges[id]) return;
+
+    Remove(id, ranges[id]);
+    Insert(id, r);
+    ranges[id] = r;
+    moveCount++;
+}
+
+void CollisionWorld::Query(Rectangle area, std::vector<int>& out)
+{
+    out.clear();
+    if (ranges.empty()) return;
+
+    // New stamp per query; on wrap-around clear the old marks
+    if (++stamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0u);
+        stamp = 1;
+    }
+
+    CellRange r = RangeFor(area);
+    for (int cy = r.minY; cy <= r.maxY; ++cy) {
+        for (int cx = r.minX; cx <= r.maxX; ++cx) {
+            for (int id : buckets[BucketFor(cx, cy)]) {
+                if (stamps[id] == stamp) continue;
+                stamps[id] = stamp;
+                out.push_back(id);
+            }
+        }
+    }
+}
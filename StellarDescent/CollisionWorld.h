@@ -0,0 +1,78 @@
+#pragma once
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ObstacleField.h"
+
+/**
+ * @brief Uniform-grid spatial hash over the level's obstacles.
+ *
+ * The world is cut into square cells; each obstacle is registered in every
+ * cell touched by its motion envelope (ObstacleField::GetMotionBounds), so
+ * an obstacle moving along its pattern never has to be re-bucketed. Cells
+ * are hashed into a fixed, power-of-two bucket array, so memory does not
+ * depend on how far apart obstacles are.
+ *
+ * Obstacles are tracked by their index in the simulation's ObstacleField.
+ * Per-step cost is Query() alone: O(cells covered + candidates), no matter
+ * how many obstacles the level holds.
+ */
+class CollisionWorld {
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 128.0f;
+
+    explicit CollisionWorld(float cellSize = DEFAULT_CELL_SIZE);
+
+    /// Drop everything and register all obstacles from scratch.
+    void Rebuild(const ObstacleField& obstacles);
+
+    /**
+     * @brief Re-register one obstacle after its motion envelope changed.
+     *
+     * Buckets are only touched when the envelope crosses into other cells.
+     */
+    void Update(int id, const ObstacleField& obstacles);
+
+    /**
+     * @brief Collect indices of obstacles that may overlap an area.
+     *
+     * Each index is reported once. Candidates still need a narrow-phase test.
+     */
+    void Query(Rectangle area, std::vector<int>& out);
+
+    size_t GetObjectCount() const { return ranges.size(); }
+
+    /// Obstacles re-bucketed by Update() since the last Rebuild()
+    long long GetMoveCount() const { return moveCount; }
+
+private:
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+
+        bool operator==(const CellRange& o) const
+        {
+            return minX == o.minX && minY == o.minY && maxX == o.maxX && maxY == o.maxY;
+        }
+    };
+
+    float cellSize;
+    float invCellSize;
+
+    std::vector<std::vector<int>> buckets;
+    uint32_t bucketMask = 0;
+
+    std::vector<CellRange> ranges;   // current cells per obstacle
+
+    // Query de-duplication: an obstacle is reported once per query stamp
+    std::vector<uint32_t> stamps;
+    uint32_t stamp = 0;
+
+    long long moveCount = 0;
+
+    CellRange RangeFor(Rectangle bounds) const;
+    uint32_t BucketFor(int cx, int cy) const;
+    void Insert(int id, const CellRange& r);
+    void Remove(int id, const CellRange& r);
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * @brief Pilot commands for one simulation step.
+ *
+ * This is the only thing the rocket simulation needs from the outside
+ * world, so the same physics can be driven by a keyboard, a script, a
+ * recording or an AI pilot.
+ */
+struct ControlInput {
+    /// Engine throttle, 0 (off) to 1 (full thrust)
+    float throttle = 0.0f;
+
+    /// Rotation command, -1 (full left) to +1 (full right)
+    float rotate = 0.0f;
+};
@@ -0,0 +1,105 @@
+#include "CpuFeatures.h"
+
+#if SD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+    struct Features {
+        bool sse2 = false;
+        bool avx2 = false;
+    };
+
+#if SD_X86
+    void Cpuid(int leaf, int subleaf, unsigned regs[4])
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, leaf, subleaf);
+        for (int i = 0; i < 4; ++i) regs[i] = (unsigned)info[i];
+#else
+        if (!__get_cpuid_count((unsigned)leaf, (unsigned)subleaf,
+            &regs[0], &regs[1], &regs[2], &regs[3])) {
+            regs[0] = regs[1] = regs[2] = regs[3] = 0;
+        }
+#endif
+    }
+
+    unsigned long long ReadXcr0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return ((unsigned long long)hi << 32) | lo;
+#endif
+    }
+#endif
+
+    Features Detect()
+    {
+        Features f;
+#if SD_X86
+        unsigned regs[4];
+        Cpuid(0, 0, regs);
+        unsigned maxLeaf = regs[0];
+
+        Cpuid(1, 0, regs);
+        f.sse2 = (regs[3] & (1u << 26)) != 0;
+
+        bool osxsave = (regs[2] & (1u << 27)) != 0;
+        bool avx = (regs[2] & (1u << 28)) != 0;
+
+        // YMM registers are only usable if the OS saves XMM+YMM state
+        bool ymmEnabled = osxsave && avx && (ReadXcr0() & 0x6) == 0x6;
+
+        if (maxLeaf >= 7 && ymmEnabled) {
+            Cpuid(7, 0, regs);
+            f.avx2 = (regs[1] & (1u << 5)) != 0;
+        }
+#endif
+        return f;
+    }
+
+    const Features& Get()
+    {
+        static const Features features = Detect();
+        return features;
+    }
+}
+
+bool CpuFeatures::HasSSE2() { return Get().sse2; }
+bool CpuFeatures::HasAVX2() { return Get().avx2; }
+
+CpuFeatures::SimdPath CpuFeatures::BestSimdPath()
+{
+    return HasAVX2() ? SimdPath::AVX2 :
+        HasSSE2() ? SimdPath::SSE2 :
+        SimdPath::SCALAR;
+}
+
+bool CpuFeatures::IsSupported(SimdPath path)
+{
+    switch (path) {
+    case SimdPath::SCALAR: return true;
+    case SimdPath::SSE2:   return HasSSE2();
+    case SimdPath::AVX2:   return HasAVX2();
+    }
+    return false;
+}
+
+const char* CpuFeatures::SimdPathName(SimdPath path)
+{
+    switch (path) {
+    case SimdPath::SCALAR: return "scalar";
+    case SimdPath::SSE2:   return "sse2";
+    case SimdPath::AVX2:   return "avx2";
+    }
+    return "unknown";
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// -------------------- ARCHITECTURE / TARGET MACROS --------------------
+// SD_X86 is set when SSE/AVX intrinsics can be compiled.
+// SD_TARGET_AVX2 marks a function that may use AVX2 instructions even when
+// the rest of the translation unit is built for the SSE2 baseline.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SD_X86 1
+#else
+#define SD_X86 0
+#endif
+
+#if SD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SD_TARGET_AVX2
+#endif
+
+/**
+ * @brief Runtime CPU feature detection (cpuid), evaluated once.
+ *
+ * Used by the SIMD kernels to pick the widest instruction set the machine
+ * and the operating system both support.
+ */
+namespace CpuFeatures {
+    bool HasSSE2();
+
+    /// True only when the CPU has AVX2 and the OS saves YMM state.
+    bool HasAVX2();
+
+    /// Instruction set a batched kernel runs with.
+    enum class SimdPath {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    /// Widest path this machine supports.
+    SimdPath BestSimdPath();
+
+    bool IsSupported(SimdPath path);
+
+    const char* SimdPathName(SimdPath path);
+}
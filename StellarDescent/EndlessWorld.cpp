@@ -0,0 +1,200 @@
+#include "EndlessWorld.h"
+#include "Random.h"
+#include <cmath>
+
+namespace
+{
+    // Obstacles per chunk: a few near the top, ramping up with depth
+    constexpr int BASE_OBSTACLES = 8;
+    constexpr int OBSTACLES_PER_ROW = 2;
+    constexpr int MAX_OBSTACLES = 48;
+
+    // Nothing is generated this close to the rocket's start
+    constexpr float SPAWN_CLEARANCE = 200.0f;
+}
+
+EndlessWorld::EndlessWorld()
+    : EndlessWorld(Settings{})
+{
+}
+
+EndlessWorld::EndlessWorld(const Settings& settings)
+    : settings(settings),
+    streamer(GenerateChunk)
+{
+    int rows = settings.rowsAbove + settings.rowsBelow + 1;
+    merged.reserve((size_t)(2 * settings.haloX + 1) * rows * ChunkStreamer::MAX_OBSTACLES_PER_CHUNK);
+}
+
+// -------------------- GENERATION --------------------
+void EndlessWorld::GenerateChunk(uint64_t seed, ChunkCoord coord, std::vector<MovingObstacle>& out)
+{
+    // Open sky above the start
+    if (coord.y < 0) return;
+
+    Pcg32 rng(MixSeed(MixSeed(seed, (uint64_t)coord.x), (uint64_t)coord.y), RngStream::CHUNKS);
+
+    int64_t ramp = BASE_OBSTACLES + coord.y * OBSTACLES_PER_ROW;
+    int count = ramp < MAX_OBSTACLES ? (int)ramp : MAX_OBSTACLES;
+
+    const Vector2 spawn = { CHUNK_SIZE * 0.5f, CHUNK_SIZE * 0.25f };
+
+    for (int i = 0; i < count; ++i) {
+        float w = (float)rng.NextInt(40, 120);
+        float h = (float)rng.NextInt(8, 18);
+        float x = rng.Range(0.0f, CHUNK_SIZE - w);
+        float y = rng.Range(0.0f, CHUNK_SIZE - h);
+
+        int patternRoll = rng.NextInt(0, 2);
+        ObstaclePattern pattern =
+            (patternRoll == 0) ? ObstaclePattern::STATIC :
+            (patternRoll == 1) ? ObstaclePattern::HORIZONTAL :
+            ObstaclePattern::VERTICAL;
+
+        float amplitude = (pattern == ObstaclePattern::STATIC) ? 0.0f : (float)rng.NextInt(20, 80);
+        float frequency = (pattern == ObstaclePattern::STATIC) ? 0.0f : (float)rng.NextInt(1, 3) / 2.0f;
+        float phase = (float)rng.NextInt(0, 628) / 100.0f;
+        float angVel = (float)rng.NextInt(-90, 90);
+
+        // Drawn either way so the rest of the chunk does not depend on it
+        if (coord.x == 0 && coord.y == 0) {
+            float dx = x + w * 0.5f - spawn.x;
+            float dy = y + h * 0.5f - spawn.y;
+            if (dx * dx + dy * dy < SPAWN_CLEARANCE * SPAWN_CLEARANCE) continue;
+        }
+
+        out.emplace_back(Rectangle{ x, y, w, h }, pattern, amplitude, frequency, phase, angVel);
+    }
+}
+
+// -------------------- RUN --------------------
+void EndlessWorld::Begin(Simulation& sim, uint64_t seed)
+{
+    streamer.Reset(seed);
+    origin = { 0, 0 };
+
+    // No ground and nowhere to land: the run ends in a crash or never
+    sim.terrain.Clear();
+    sim.planet.gravity = settings.gravity;
+    sim.planet.landingPad = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    startY = CHUNK_SIZE * 0.25f;
+    sim.rocket.SetDifficultyParams(settings.gravity, settings.startingFuel);
+    sim.rocket.Reset({ CHUNK_SIZE * 0.5f, startY });
+
+    center = ChunkOf(sim.rocket.position);
+    deepestRow = center.y;
+
+    sim.obstacles.Assign({}, 0.0);
+    Merge(sim);
+    Prefetch();
+
+    // The first chunks are generated up front, like a normal level
+    rebases = 0;
+    hitches = 0;
+}
+
+Vector2 EndlessWorld::Update(Simulation& sim)
+{
+    Vector2 shift = { 0.0f, 0.0f };
+    ChunkCoord c = ChunkOf(sim.rocket.position);
+
+    // -------------------- FLOATING ORIGIN --------------------
+    if (fabsf(sim.rocket.position.x) > REBASE_DISTANCE || fabsf(sim.rocket.position.y) > REBASE_DISTANCE) {
+        shift = { -(float)(c.x - origin.x) * CHUNK_SIZE, -(float)(c.y - origin.y) * CHUNK_SIZE };
+        origin = c;
+        sim.ShiftOrigin(shift);
+        rebases++;
+    }
+
+    // -------------------- FUEL --------------------
+    if (c.y > deepestRow) {
+        deepestRow = c.y;
+        float fuel = sim.rocket.fuel + settings.refuelPerRow;
+        sim.rocket.fuel = fuel < sim.rocket.maxFuel ? fuel : sim.rocket.maxFuel;
+    }
+
+    // -------------------- CHUNK WINDOW --------------------
+    bool moved = c != center;
+    if (moved) {
+        center = c;
+        streamer.ReleaseUnless([this](ChunkCoord k) { return InWindow(k); });
+    }
+
+    // Obstacles are stored relative to the origin, so a rebase re-merges too
+    if (moved || shift.x != 0.0f || shift.y != 0.0f) {
+        ChunkStreamer::Stats before = streamer.GetStats();
+        Merge(sim);
+        ChunkStreamer::Stats after = streamer.GetStats();
+        hitches += (after.generatedInline - before.generatedInline) + (after.waits - before.waits);
+    }
+    if (moved) Prefetch();
+
+    return shift;
+}
+
+void EndlessWorld::Restore(Simulation& sim, const State& state)
+{
+    origin = state.origin;
+    deepestRow = state.deepestRow;
+
+    center = ChunkOf(sim.rocket.position);
+    streamer.ReleaseUnless([this](ChunkCoord k) { return InWindow(k); });
+    Merge(sim);
+    Prefetch();
+}
+
+double EndlessWorld::GetDepth(const Simulation& sim) const
+{
+    return (double)origin.y * CHUNK_SIZE + sim.rocket.position.y - startY;
+}
+
+ChunkCoord EndlessWorld::ChunkOf(Vector2 local) const
+{
+    return { origin.x + (int64_t)floorf(local.x / CHUNK_SIZE), origin.y + (int64_t)floorf(local.y / CHUNK_SIZE) };
+}
+
+// -------------------- WINDOW --------------------
+bool EndlessWorld::InWindow(ChunkCoord k) const
+{
+    // Merged rows and prefetched rows, plus one chunk of slack on every side
+    return k.x >= center.x - settings.haloX - 1 && k.x <= center.x + settings.haloX + 1 &&
+        k.y >= center.y - settings.rowsAbove - 1 && k.y <= center.y + settings.rowsBelow + settings.prefetchRows;
+}
+
+void EndlessWorld::Prefetch()
+{
+    // Rows ahead first (the way the rocket is usually going)...
+    for (int64_t y = center.y + settings.rowsBelow + 1; y <= center.y + settings.rowsBelow + settings.prefetchRows; ++y) {
+        for (int64_t x = center.x - settings.haloX; x <= center.x + settings.haloX; ++x) {
+            streamer.Prefetch({ x, y });
+        }
+    }
+
+    // ...then the columns to either side and the row above
+    for (int64_t y = center.y - settings.rowsAbove; y <= center.y + settings.rowsBelow; ++y) {
+        streamer.Prefetch({ center.x - settings.haloX - 1, y });
+        streamer.Prefetch({ center.x + settings.haloX + 1, y });
+    }
+    for (int64_t x = center.x - settings.haloX; x <= center.x + settings.haloX; ++x) {
+        streamer.Prefetch({ x, center.y - settings.rowsAbove - 1 });
+    }
+}
+
+void EndlessWorld::Merge(Simulation& sim)
+{
+    merged.clear();
+    for (int64_t y = center.y - settings.rowsAbove; y <= center.y + settings.rowsBelow; ++y) {
+        for (int64_t x = center.x - settings.haloX; x <= center.x + settings.haloX; ++x) {
+            Vector2 offset = { (float)(x - origin.x) * CHUNK_SIZE, (float)(y - origin.y) * CHUNK_SIZE };
+            for (const MovingObstacle& o : streamer.Require({ x, y })) {
+                merged.push_back(o);
+                merged.back().Translate(offset);
+            }
+        }
+    }
+
+    // Same level time: obstacles carry on where they were, only relocated
+    sim.obstacles.Assign(merged, sim.obstacles.GetTime());
+    sim.OnObstaclesChanged();
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+#include "ChunkStreamer.h"
+#include "MovingObstacle.h"
+#include "Simulation.h"
+
+/**
+ * @brief Endless Descent: an unbounded world streamed in chunks.
+ *
+ * The world is a grid of CHUNK_SIZE squares in absolute chunk coordinates.
+ * Each chunk's obstacles depend only on (seed, coordinate), so the world
+ * is the same however it is explored. The chunks around the rocket are
+ * merged into Simulation::obstacles; the rows ahead are generated on the
+ * ChunkStreamer worker before the rocket reaches them, and chunks that
+ * fall out of the window go back to the pool.
+ *
+ * Floating origin: simulation coordinates are relative to the corner of
+ * the chunk `origin`. Once the rocket is REBASE_DISTANCE from it, the origin
+ * jumps by whole chunks and everything is shifted by the same exact amount
+ * (multiples of CHUNK_SIZE are exact in float at these magnitudes), so
+ * local coordinates, and their precision, stay bounded at any depth.
+ */
+class EndlessWorld {
+public:
+    static constexpr float CHUNK_SIZE = 1024.0f;
+
+    /// Rebase once the rocket is this far (px, either axis) from the origin
+    static constexpr float REBASE_DISTANCE = 4.0f * CHUNK_SIZE;
+
+    struct Settings {
+        int haloX = 1;             // chunk columns merged on each side of the rocket
+        int rowsAbove = 1;         // chunk rows merged above the rocket
+        int rowsBelow = 1;         // chunk rows merged below the rocket
+        int prefetchRows = 2;      // rows generated ahead of the merged ones
+        float gravity = 60.0f;
+        float startingFuel = 100.0f;
+        float refuelPerRow = 25.0f;  // fuel added on reaching a new deepest row
+    };
+
+    /// Where the world stands, beyond what the Simulation holds.
+    struct State {
+        ChunkCoord origin;
+        int64_t deepestRow = 0;
+    };
+
+    EndlessWorld();
+    explicit EndlessWorld(const Settings& settings);
+
+    /**
+     * @brief Start a new descent from @p seed.
+     *
+     * Clears the terrain and pad, resets the rocket near the origin and
+     * merges the starting chunks. Does not touch the run state (timer,
+     * outcome); call Simulation::ResetRun() as for a normal level.
+     */
+    void Begin(Simulation& sim, uint64_t seed);
+
+    /**
+     * @brief Keep the world around the rocket; call after every Simulation::Step.
+     *
+     * @return Shift applied by a rebase this call ({0, 0} if none). Anything
+     *         else the caller keeps in world space (camera, particles) must
+     *         move by it too.
+     */
+    Vector2 Update(Simulation& sim);
+
+    State GetState() const { return { origin, deepestRow }; }
+
+    /**
+     * @brief Continue from a saved State (replay seeking).
+     *
+     * @p sim must already be in the matching state (Simulation::RestoreState)
+     * and the world started with the same seed.
+     */
+    void Restore(Simulation& sim, const State& state);
+
+    /// Rocket depth below its starting point in px (absolute, not rebased).
+    double GetDepth(const Simulation& sim) const;
+
+    /// Chunk the simulation's local origin sits at.
+    ChunkCoord GetOrigin() const { return origin; }
+
+    /// Absolute chunk containing a point in simulation coordinates.
+    ChunkCoord ChunkOf(Vector2 local) const;
+
+    const ChunkStreamer& GetStreamer() const { return streamer; }
+    const Settings& GetSettings() const { return settings; }
+
+    long long GetRebaseCount() const { return rebases; }
+
+    /// Chunks merged since Begin() that the worker had not generated yet.
+    long long GetHitchCount() const { return hitches; }
+
+    /// Deterministic chunk generator (ChunkStreamer::Generator).
+    static void GenerateChunk(uint64_t seed, ChunkCoord coord, std::vector<MovingObstacle>& out);
+
+private:
+    Settings settings;
+    ChunkStreamer streamer;
+
+    ChunkCoord origin;
+    ChunkCoord center;         // rocket chunk at the last merge
+    int64_t deepestRow = 0;
+    float startY = 0.0f;       // rocket start, local to chunk (0, 0)
+
+    std::vector<MovingObstacle> merged;
+
+    long long rebases = 0;
+    long long hitches = 0;
+
+    bool InWindow(ChunkCoord c) const;
+    void Prefetch();
+    void Merge(Simulation& sim);
+};
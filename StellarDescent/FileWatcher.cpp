@@ -0,0 +1,52 @@
+#include "FileWatcher.h"
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+FileWatcher::FileWatcher(std::string path, float interval)
+    : interval(interval)
+{
+    Watch(std::move(path));
+}
+
+void FileWatcher::Watch(std::string newPath)
+{
+    path = std::move(newPath);
+    sinceCheck = 0.0f;
+    last = Read();
+}
+
+bool FileWatcher::Update(float dt)
+{
+    sinceCheck += dt;
+    if (sinceCheck < interval) return false;
+    sinceCheck = 0.0f;
+    return Poll();
+}
+
+bool FileWatcher::Poll()
+{
+    Stamp now = Read();
+    if (now == last) return false;
+    last = now;
+    return true;
+}
+
+FileWatcher::Stamp FileWatcher::Read() const
+{
+    namespace fs = std::filesystem;
+
+    Stamp stamp;
+    if (path.empty()) return stamp;
+
+    std::error_code ec;
+    auto modified = fs::last_write_time(path, ec);
+    if (ec) return stamp;
+    auto size = fs::file_size(path, ec);
+    if (ec) return stamp;
+
+    stamp.exists = true;
+    stamp.modified = (int64_t)modified.time_since_epoch().count();
+    stamp.size = (uint64_t)size;
+    return stamp;
+}
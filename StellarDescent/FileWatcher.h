@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Notices when a file on disk changes, for hot reloading.
+ *
+ * Polls the file's modification time and size every interval seconds of
+ * Update() time, so it costs one stat() call per interval and needs no
+ * platform watch API. Appearing and disappearing count as changes.
+ * Writers should replace the file atomically (write elsewhere, rename
+ * over), so a change is never seen half-written.
+ */
+class FileWatcher {
+public:
+    explicit FileWatcher(std::string path = std::string(), float interval = 0.5f);
+
+    /// Watch @p path from now on (its current state is not a change).
+    void Watch(std::string path);
+
+    /// Advance by @p dt seconds; true if the file changed since the last
+    /// change was reported.
+    bool Update(float dt);
+
+    /// Check right away, whatever the interval.
+    bool Poll();
+
+    const std::string& GetPath() const { return path; }
+
+private:
+    struct Stamp {
+        bool exists = false;
+        int64_t modified = 0;
+        uint64_t size = 0;
+
+        bool operator==(const Stamp& o) const { return exists == o.exists && modified == o.modified && size == o.size; }
+    };
+
+    std::string path;
+    float interval;
+    float sinceCheck = 0.0f;
+    Stamp last;
+
+    Stamp Read() const;
+};
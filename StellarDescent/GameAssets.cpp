@@ -0,0 +1,136 @@
+#include "GameAssets.h"
+#include <cstring>
+
+using namespace AssetArchiveFormat;
+
+bool GameAssets::Open(const char* archivePath, std::string* error)
+{
+    loader.reset();
+    if (!archive.Open(archivePath, error)) return false;
+
+    loader = std::make_unique<AssetLoader>(archive);
+    loader->Start();
+    return true;
+}
+
+int GameAssets::Take(const char* name, AssetType type)
+{
+    if (!archive.IsOpen()) return -1;
+    int index = archive.Find(name);
+    if (index < 0 || archive.GetEntry(index).type != type) return -1;
+    if (!loader->Wait(index)) {
+        TraceLog(LOG_WARNING, "ASSETS: %s is damaged in %s", name, archive.GetPath().c_str());
+        return -1;
+    }
+    return index;
+}
+
+// -------------------- TEXTURES --------------------
+Texture2D GameAssets::LoadTexture(const char* name)
+{
+    int index = Take(name, AssetType::TEXTURE);
+    if (index >= 0) {
+        const Entry& e = archive.GetEntry(index);
+        Image image = {};
+        image.data = (void*)archive.GetData(index);   // only read by the upload
+        image.width = (int)e.params[TEXTURE_WIDTH];
+        image.height = (int)e.params[TEXTURE_HEIGHT];
+        image.mipmaps = 1;
+        image.format = (int)e.params[TEXTURE_FORMAT];
+
+        if (image.width > 0 && image.height > 0 &&
+            (uint64_t)GetPixelDataSize(image.width, image.height, image.format) == e.size) {
+            cookedCount++;
+            return LoadTextureFromImage(image);
+        }
+    }
+    looseCount++;
+    return ::LoadTexture(LoosePath(name).c_str());
+}
+
+// -------------------- FONTS --------------------
+Font GameAssets::LoadFont(const char* name, int fontSize, const int* codepoints, int codepointCount)
+{
+    int index = Take(name, AssetType::FONT);
+    if (index >= 0) {
+        const Entry& e = archive.GetEntry(index);
+        const int glyphCount = (int)e.params[FONT_GLYPH_COUNT];
+        const Glyph* glyphs = (const Glyph*)archive.GetData(index);
+
+        Image atlas = {};
+        atlas.data = (void*)(archive.GetData(index) + (size_t)glyphCount * sizeof(Glyph));
+        atlas.width = (int)e.params[FONT_ATLAS_WIDTH];
+        atlas.height = (int)e.params[FONT_ATLAS_HEIGHT];
+        atlas.mipmaps = 1;
+        atlas.format = (int)e.params[FONT_ATLAS_FORMAT];
+
+        // Cooked from the same size and characters LoadFontEx would use
+        // (raylib's default set is ASCII 32..126)?
+        bool matches = (int)e.params[FONT_BASE_SIZE] == fontSize &&
+            glyphCount == (codepointCount > 0 ? codepointCount : 95) &&
+            atlas.width > 0 && atlas.height > 0 &&
+            (uint64_t)glyphCount * sizeof(Glyph) + (uint64_t)GetPixelDataSize(atlas.width, atlas.height, atlas.format) == e.size;
+        for (int i = 0; matches && i < glyphCount; ++i) {
+            matches = glyphs[i].value == (codepointCount > 0 ? codepoints[i] : 32 + i);
+        }
+
+        if (matches) {
+            // Same arrays LoadFontEx allocates, so UnloadFont frees them as usual.
+            // Glyph images stay empty: they only serve ImageDrawText.
+            Font font = {};
+            font.baseSize = fontSize;
+            font.glyphCount = glyphCount;
+            font.glyphPadding = (int)e.params[FONT_GLYPH_PADDING];
+            font.recs = (Rectangle*)MemAlloc((unsigned int)(glyphCount * sizeof(Rectangle)));
+            font.glyphs = (GlyphInfo*)MemAlloc((unsigned int)(glyphCount * sizeof(GlyphInfo)));
+            for (int i = 0; i < glyphCount; ++i) {
+                const Glyph& g = glyphs[i];
+                font.recs[i] = { g.x, g.y, g.width, g.height };
+                font.glyphs[i].value = g.value;
+                font.glyphs[i].offsetX = g.offsetX;
+                font.glyphs[i].offsetY = g.offsetY;
+                font.glyphs[i].advanceX = g.advanceX;
+            }
+            font.texture = LoadTextureFromImage(atlas);
+            cookedCount++;
+            return font;
+        }
+        TraceLog(LOG_WARNING, "ASSETS: %s was cooked with other settings, loading the font file", name);
+    }
+    looseCount++;
+    return LoadFontEx(LoosePath(name).c_str(), fontSize, (int*)codepoints, codepointCount);
+}
+
+// -------------------- AUDIO --------------------
+Sound GameAssets::LoadSound(const char* name)
+{
+    int index = Take(name, AssetType::SOUND);
+    if (index >= 0) {
+        const Entry& e = archive.GetEntry(index);
+        Wave wave = {};
+        wave.frameCount = e.params[SOUND_FRAME_COUNT];
+        wave.sampleRate = e.params[SOUND_SAMPLE_RATE];
+        wave.sampleSize = e.params[SOUND_SAMPLE_SIZE];
+        wave.channels = e.params[SOUND_CHANNELS];
+        wave.data = (void*)archive.GetData(index);    // copied into the audio buffer
+
+        if ((uint64_t)wave.frameCount * wave.channels * (wave.sampleSize / 8) == e.size && e.size > 0) {
+            cookedCount++;
+            return LoadSoundFromWave(wave);
+        }
+    }
+    looseCount++;
+    return ::LoadSound(LoosePath(name).c_str());
+}
+
+Music GameAssets::LoadMusic(const char* name)
+{
+    int index = Take(name, AssetType::STREAM);
+    const char* extension = std::strrchr(name, '.');
+    if (index >= 0 && extension) {
+        cookedCount++;
+        return LoadMusicStreamFromMemory(extension, archive.GetData(index), (int)archive.GetEntry(index).size);
+    }
+    looseCount++;
+    return LoadMusicStream(LoosePath(name).c_str());
+}
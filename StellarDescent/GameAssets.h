@@ -0,0 +1,64 @@
+#pragma once
+#include "raylib.h"
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "AssetArchive.h"
+#include "AssetLoader.h"
+
+/**
+ * @brief Where the game gets its textures, fonts and sounds from.
+ *
+ * With a cooked archive open (asset_cook builds assets/assets.sdpak), the
+ * Load functions create each asset straight from its pre-decoded payload:
+ * no PNG decoding, font rasterizing or WAV parsing at startup. Open()
+ * starts streaming the archive in on a worker thread; show a loading
+ * screen while IsStreaming(). Payloads are paged in, not hashed (see
+ * AssetLoader); the size checks below still keep a damaged one in bounds.
+ *
+ * Any asset the archive lacks, or cooked with other settings than asked
+ * for (a stale archive), is loaded from its loose file under assets/ as
+ * before, so the game runs the same with or without an archive.
+ */
+class GameAssets {
+public:
+    /// @p looseDir holds the loose files, under the same names.
+    explicit GameAssets(std::string looseDir = "assets") : looseDir(std::move(looseDir)) {}
+
+    // The loader refers to the archive member
+    GameAssets(const GameAssets&) = delete;
+    GameAssets& operator=(const GameAssets&) = delete;
+
+    /// Map a cooked archive and start streaming it. On failure the loose
+    /// files are used and @p error (if given) says why.
+    bool Open(const char* archivePath, std::string* error = nullptr);
+
+    bool IsCooked() const { return archive.IsOpen(); }
+    bool IsStreaming() const { return loader && !loader->IsDone(); }
+    float GetProgress() const { return loader ? loader->GetProgress() : 1.0f; }
+
+    // Names are paths relative to assets/, e.g. "textures/starfield.png"
+    Texture2D LoadTexture(const char* name);
+    Font LoadFont(const char* name, int fontSize, const int* codepoints, int codepointCount);
+    Sound LoadSound(const char* name);
+
+    /// Cooked music streams read from the archive, which stays mapped
+    /// while the GameAssets exists.
+    Music LoadMusic(const char* name);
+
+    int GetCookedCount() const { return cookedCount; }
+    int GetLooseCount() const { return looseCount; }
+
+private:
+    std::string looseDir;
+    AssetArchive archive;
+    std::unique_ptr<AssetLoader> loader;
+    int cookedCount = 0;
+    int looseCount = 0;
+
+    /// Entry for @p name if it is cooked as @p type and streamed intact, else -1.
+    int Take(const char* name, AssetArchiveFormat::AssetType type);
+
+    std::string LoosePath(const char* name) const { return looseDir + "/" + name; }
+};
@@ -0,0 +1,41 @@
+#include "InputSource.h"
+
+// -------------------- SCRIPTED --------------------
+void ScriptedInput::AddStep(int ticks, ControlInput input)
+{
+    if (ticks <= 0) return;
+    steps.push_back({ ticks, input });
+}
+
+ControlInput ScriptedInput::Poll()
+{
+    if (IsFinished()) return ControlInput{};
+
+    ControlInput input = steps[stepIndex].input;
+
+    // Move on to the next step once this one has been held long enough
+    if (++tickInStep >= steps[stepIndex].ticks) {
+        stepIndex++;
+        tickInStep = 0;
+    }
+    return input;
+}
+
+void ScriptedInput::Restart()
+{
+    stepIndex = 0;
+    tickInStep = 0;
+}
+
+// -------------------- RECORDED --------------------
+void RecordedInput::Clear()
+{
+    frames.clear();
+    cursor = 0;
+}
+
+ControlInput RecordedInput::Poll()
+{
+    if (IsFinished()) return ControlInput{};
+    return frames[cursor++];
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "ControlInput.h"
+#include <vector>
+
+/**
+ * @brief Produces one ControlInput per simulation tick.
+ *
+ * The game loop (or a headless tool) calls Poll() exactly once before each
+ * fixed simulation step and feeds the result to Rocket::Update.
+ */
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    /// Input for the next simulation tick.
+    virtual ControlInput Poll() = 0;
+
+    /// Rewind to the first tick (no-op for live sources).
+    virtual void Restart() {}
+};
+
+/**
+ * @brief Plays back a hand-written list of timed commands.
+ *
+ * Each step holds an input for a number of ticks; once the script runs out
+ * the source returns a neutral input (engine off, no rotation).
+ */
+class ScriptedInput : public InputSource {
+public:
+    /// Append a step that holds @p input for @p ticks ticks.
+    void AddStep(int ticks, ControlInput input);
+
+    ControlInput Poll() override;
+    void Restart() override;
+
+    bool IsFinished() const { return stepIndex >= (int)steps.size(); }
+
+private:
+    struct Step {
+        int ticks;
+        ControlInput input;
+    };
+
+    std::vector<Step> steps;
+    int stepIndex = 0;
+    int tickInStep = 0;
+};
+
+/**
+ * @brief Tick-by-tick input log that can be recorded and played back.
+ */
+class RecordedInput : public InputSource {
+public:
+    /// Append the input used for one tick.
+    void Record(ControlInput input) { frames.push_back(input); }
+
+    /// Forget every recorded tick.
+    void Clear();
+
+    ControlInput Poll() override;
+    void Restart() override { cursor = 0; }
+
+    int GetTickCount() const { return (int)frames.size(); }
+    bool IsFinished() const { return cursor >= (int)frames.size(); }
+
+    const std::vector<ControlInput>& GetFrames() const { return frames; }
+
+private:
+    std::vector<ControlInput> frames;
+    int cursor = 0;
+};
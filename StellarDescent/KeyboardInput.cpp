@@ -0,0 +1,15 @@
+#include "KeyboardInput.h"
+#include "raylib.h"
+
+ControlInput KeyboardInput::Poll()
+{
+    ControlInput input;
+
+    // Holding both arrows cancels out, same as the old per-key rotation
+    if (IsKeyDown(KEY_LEFT))  input.rotate -= 1.0f;
+    if (IsKeyDown(KEY_RIGHT)) input.rotate += 1.0f;
+
+    if (IsKeyDown(KEY_UP)) input.throttle = 1.0f;
+
+    return input;
+}
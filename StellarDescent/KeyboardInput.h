@@ -0,0 +1,13 @@
+#pragma once
+#include "InputSource.h"
+
+/**
+ * @brief Live keyboard pilot: UP = thrust, LEFT/RIGHT = rotate.
+ *
+ * The only input source that talks to raylib; everything downstream of
+ * Poll() is window-free.
+ */
+class KeyboardInput : public InputSource {
+public:
+    ControlInput Poll() override;
+};
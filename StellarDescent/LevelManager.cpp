@@ -1,73 +1,143 @@
 #include "LevelManager.h"
+#include "LevelPackCompiler.h"
 #include "raylib.h"
 #include <cmath>
+#include <utility>
 
-LevelManager::LevelManager()
+LevelManager::LevelManager(uint64_t seed)
     : currentDifficultyIndex(1), // Normal
-    currentLevelIndex(0)      // First level
-{
-}
-
-void LevelManager::Init(Rocket& rocket, Planet& planet, std::vector<MovingObstacle>& obstacles)
-{
-    // -------------------- DIFFICULTY PRESETS --------------------
-    difficulties[0] = { "Easy",   60.0f, 150.0f, 140.0f, 2 };
-    difficulties[1] = { "Normal", 80.0f, 100.0f, 100.0f, 4 };
-    difficulties[2] = { "Hard",  100.0f,  70.0f,  70.0f, 6 };
-
-    // -------------------- LEVEL PRESETS --------------------
-    // You can tweak these numbers however you like.
-    // y is mostly the spawn height; pad is always at y = 310 in ApplyCurrentPreset.
-
-    // 0: Straightforward central drop
-    levels[0] = {
-        "Central Valley",
-        {   0.0f,  -200.0f },   // start pos
-        0.0f                     // pad center X
-    };
-
-    // 1: Approach from the far left
-    levels[1] = {
-        "Left Approach",
-        { -260.0f, -220.0f },
-        -180.0f
-    };
-
-    // 2: Approach from the far right
-    levels[2] = {
-        "Right Ridge",
-        {  260.0f, -220.0f },
-        180.0f
-    };
-
-    // 3: High drop over central pad (more time to drift)
-    levels[3] = {
-        "High Descent",
-        {   0.0f,  -320.0f },
-        0.0f
-    };
-
-    // 4: Off-screen left start, pad near center
-    levels[4] = {
-        "Blind Left",
-        { -380.0f, -240.0f },  // start way off-screen on the left
-        -60.0f                 // pad slightly left
-    };
-
-    // 5: Off-screen right start, pad near center
-    levels[5] = {
-        "Blind Right",
-        {  380.0f, -240.0f },
-        60.0f
-    };
+    currentLevelIndex(0),     // First level
+    rng(seed)
+{
+}
+
+LevelManager::~LevelManager()
+{
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(prebuildMutex);
+        stopping = true;
+    }
+    prebuildWake.notify_all();
+    worker.join();
+}
+
+void LevelManager::SetSeed(uint64_t seed)
+{
+    rng.Seed(seed);
+}
+
+namespace
+{
+    // The presets the game shipped with, used when no level pack is loaded
+    // (assets/levels/levels.txt holds the same ones as text).
+    LevelPackSource BuiltinPresets()
+    {
+        LevelPackSource pack;
+
+        // -------------------- DIFFICULTY PRESETS --------------------
+        pack.difficulties.resize(3);
+        pack.difficulties[0] = { "Easy",   60.0f, 150.0f, 140.0f, 2 };
+        pack.difficulties[1] = { "Normal", 80.0f, 100.0f, 100.0f, 4 };
+        pack.difficulties[2] = { "Hard",  100.0f,  70.0f,  70.0f, 6 };
+
+        // -------------------- LEVEL PRESETS --------------------
+        // You can tweak these numbers however you like.
+        // y is mostly the spawn height; pad is always at y = 310 in BuildLevel.
+        auto level = [&](const char* name, Vector2 startPos, float padCenterX) {
+            LevelPackSource::Level l;
+            l.name = name;
+            l.startX = startPos.x;
+            l.startY = startPos.y;
+            l.padCenterX = padCenterX;
+            pack.levels.push_back(l);
+        };
+
+        // 0: Straightforward central drop
+        level("Central Valley",
+            {   0.0f,  -200.0f },   // start pos
+            0.0f);                   // pad center X
+
+        // 1: Approach from the far left
+        level("Left Approach",
+            { -260.0f, -220.0f },
+            -180.0f);
+
+        // 2: Approach from the far right
+        level("Right Ridge",
+            {  260.0f, -220.0f },
+            180.0f);
+
+        // 3: High drop over central pad (more time to drift)
+        level("High Descent",
+            {   0.0f,  -320.0f },
+            0.0f);
+
+        // 4: Off-screen left start, pad near center
+        level("Blind Left",
+            { -380.0f, -240.0f },  // start way off-screen on the left
+            -60.0f);               // pad slightly left
+
+        // 5: Off-screen right start, pad near center
+        level("Blind Right",
+            {  380.0f, -240.0f },
+            60.0f);
+
+        return pack;
+    }
+}
+
+void LevelManager::Init(Simulation& sim)
+{
+    if (!pack.IsOpen()) UseBuiltinPack();
 
     // Apply starting difficulty & level to world
-    ApplyCurrentPreset(rocket, planet, obstacles);
+    ApplyCurrentPreset(sim);
+}
+
+// -------------------- LEVEL PACKS --------------------
+void LevelManager::UseBuiltinPack()
+{
+    std::vector<uint8_t> image;
+    std::string error;
+    LevelPack builtin;
+    LevelPackCompiler::Compile(BuiltinPresets(), image, error);
+    builtin.Adopt(std::move(image));
+    AdoptPack(builtin);
 }
 
-void LevelManager::SetupObstacles(const DifficultyPreset& diff,
-    const LevelPreset& level,
-    std::vector<MovingObstacle>& obstacles)
+bool LevelManager::LoadPack(const char* path, std::string* error)
+{
+    LevelPack loaded;
+    if (!loaded.Open(path, error)) return false;
+    AdoptPack(loaded);
+    return true;
+}
+
+void LevelManager::AdoptPack(LevelPack& newPack)
+{
+    // The worker reads presets while it builds: let it finish, and drop
+    // whatever it built from the old ones
+    WaitForWorker();
+    prebuildRequested = false;
+
+    std::swap(pack, newPack);
+    if (currentDifficultyIndex >= pack.GetDifficultyCount()) currentDifficultyIndex = 0;
+    if (currentLevelIndex >= pack.GetLevelCount()) currentLevelIndex = 0;
+    snapshot.Clear();
+}
+
+void LevelManager::WaitForWorker()
+{
+    if (!prebuilt) return;
+    std::unique_lock<std::mutex> lock(prebuildMutex);
+    prebuildDone.wait(lock, [this]() { return builtId == requestId; });
+}
+
+void LevelManager::SetupObstacles(const LevelPackFormat::Difficulty& diff,
+    const LevelPackFormat::Level& level,
+    Pcg32& layoutRng,
+    std::vector<MovingObstacle>& obstacles) const
 {
     obstacles.clear();
 
@@ -79,15 +149,15 @@ void LevelManager::SetupObstacles(const DifficultyPreset& diff,
     float maxY = 260.0f; // above ground (y=310)
 
     for (int i = 0; i < diff.obstacleCount; ++i) {
-        float w = (float)GetRandomValue(40, 80);
-        float h = (float)GetRandomValue(8, 18);
+        float w = (float)layoutRng.NextInt(40, 80);
+        float h = (float)layoutRng.NextInt(8, 18);
 
-        float x = (float)GetRandomValue((int)minX, (int)maxX);
-        float y = (float)GetRandomValue((int)minY, (int)maxY);
+        float x = (float)layoutRng.NextInt((int)minX, (int)maxX);
+        float y = (float)layoutRng.NextInt((int)minY, (int)maxY);
 
         Rectangle r{ x, y, w, h };
 
-        int patternRoll = GetRandomValue(0, 2);
+        int patternRoll = layoutRng.NextInt(0, 2);
         ObstaclePattern pattern =
             (patternRoll == 0) ? ObstaclePattern::STATIC :
             (patternRoll == 1) ? ObstaclePattern::HORIZONTAL :
@@ -95,111 +165,269 @@ void LevelManager::SetupObstacles(const DifficultyPreset& diff,
 
         float amplitude = (pattern == ObstaclePattern::STATIC)
             ? 0.0f
-            : (float)GetRandomValue(20, 80);
+            : (float)layoutRng.NextInt(20, 80);
 
         float frequency = (pattern == ObstaclePattern::STATIC)
             ? 0.0f
-            : (float)GetRandomValue(1, 3) / 2.0f; // 0.51.5
+            : (float)layoutRng.NextInt(1, 3) / 2.0f; // 0.51.5
 
-        float phase = (float)GetRandomValue(0, 628) / 100.0f; // 06.28
-        float angVel = (float)GetRandomValue(-90, 90);         // -90..90 deg/sec
+        float phase = (float)layoutRng.NextInt(0, 628) / 100.0f; // 06.28
+        float angVel = (float)layoutRng.NextInt(-90, 90);         // -90..90 deg/sec
 
         obstacles.emplace_back(r, pattern, amplitude, frequency, phase, angVel);
     }
 }
 
-void LevelManager::ApplyCurrentPreset(Rocket& rocket,
-    Planet& planet,
-    std::vector<MovingObstacle>& obstacles)
+uint64_t LevelManager::DrawLayoutSeed(Pcg32& from)
 {
-    DifficultyPreset& d = difficulties[currentDifficultyIndex];
-    LevelPreset& l = levels[currentLevelIndex];
+    return ((uint64_t)from.NextU32() << 32) | from.NextU32();
+}
+
+void LevelManager::ApplyCurrentPreset(Simulation& sim)
+{
+    // A fresh layout every rebuild, reproducible from this one seed
+    layoutSeed = DrawLayoutSeed(rng);
+    BuildLayout(sim);
+}
+
+void LevelManager::BuildLayout(Simulation& sim)
+{
+    BuildLevel(currentDifficultyIndex, currentLevelIndex, layoutSeed, obstacleLayout, sim);
+
+    // Restarts copy this back instead of building it again
+    snapshot.Capture(sim);
+}
+
+void LevelManager::BuildLevel(int difficultyIndex, int levelIndex, uint64_t seed,
+    std::vector<MovingObstacle>& obstacles, Simulation& sim) const
+{
+    const LevelPackFormat::Difficulty& d = pack.GetDifficulty(difficultyIndex);
+    const LevelPackFormat::Level& l = pack.GetLevel(levelIndex);
+    const Vector2 startPos = { l.startX, l.startY };
+
+    Planet& planet = sim.planet;
+    Rocket& rocket = sim.rocket;
+    Pcg32 layoutRng(seed, RngStream::OBSTACLES);
 
     // Planet settings
     planet.gravity = d.gravity;
-    planet.landingPad.y = 310.0f;
+    planet.landingPad.y = Simulation::GROUND_Y;
     planet.landingPad.height = 10.0f;
     planet.landingPad.width = d.padWidth;
     planet.landingPad.x = l.padCenterX - d.padWidth / 2.0f;
 
     // Rocket settings
     rocket.SetDifficultyParams(d.gravity, d.startingFuel);
-    rocket.Reset(l.startPos);
+    rocket.Reset(startPos);
+
+    // Obstacles: the difficulty's generated ones, then the level's authored ones
+    SetupObstacles(d, l, layoutRng, obstacles);
+    int authoredCount = 0;
+    const LevelPackFormat::Obstacle* authored = pack.GetObstacles(l, authoredCount);
+    for (int i = 0; i < authoredCount; ++i) {
+        const LevelPackFormat::Obstacle& o = authored[i];
+        ObstaclePattern pattern = o.pattern <= (uint32_t)ObstaclePattern::VERTICAL ? (ObstaclePattern)o.pattern : ObstaclePattern::STATIC;
+        obstacles.emplace_back(Rectangle{ o.x, o.y, o.width, o.height }, pattern,
+            o.amplitude, o.frequency, o.phase, o.angularVelocity);
+    }
+    sim.obstacles.Assign(obstacles);
+    sim.OnObstaclesChanged();
+
+    // Terrain: hills and craters around a flat plateau under the pad
+    const LevelPackFormat::TerrainParams& t = l.terrain;
+    Terrain::Settings terrain;
+    terrain.minX = t.minX;
+    terrain.maxX = t.maxX;
+    terrain.spacing = t.spacing;
+    terrain.baseY = Simulation::GROUND_Y;
+    terrain.hillHeight = t.hillHeight;
+    terrain.hillWavelength = t.hillWavelength;
+    terrain.craterCount = t.craterCount;
+    terrain.craterMinRadius = t.craterMinRadius;
+    terrain.craterMaxRadius = t.craterMaxRadius;
+    terrain.craterDepth = t.craterDepth;
+    terrain.padCenterX = l.padCenterX;
+    terrain.padHalfWidth = d.padWidth / 2.0f;
+    terrain.padMargin = t.padMargin;
+    terrain.padBlend = t.padBlend;
+    sim.terrain.Generate(terrain, seed);
+}
+
+void LevelManager::SetDifficulty(int index, Simulation& sim)
+{
+    if (index < 0 || index >= pack.GetDifficultyCount()) return;
+
+    currentDifficultyIndex = index;
+    ApplyCurrentPreset(sim);
+}
+
+void LevelManager::SetLevel(int index, Simulation& sim)
+{
+    if (index < 0 || index >= pack.GetLevelCount()) return;
 
-    // Obstacles
-    SetupObstacles(d, l, obstacles);
+    currentLevelIndex = index;
+    ApplyCurrentPreset(sim);
 }
 
-void LevelManager::HandleMenu(GameState& state,
-    Rocket& rocket,
-    Planet& planet,
-    std::vector<MovingObstacle>& obstacles,
-    float& timer,
-    bool& startGame)
+void LevelManager::SetPreset(int difficultyIndex, int levelIndex, Simulation& sim)
 {
-    bool difficultyChanged = false;
-    bool levelChanged = false;
+    if (difficultyIndex < 0 || difficultyIndex >= pack.GetDifficultyCount()) return;
+    if (levelIndex < 0 || levelIndex >= pack.GetLevelCount()) return;
 
-    // Change difficulty with 1/2/3
-    if (IsKeyPressed(KEY_ONE)) { currentDifficultyIndex = 0; difficultyChanged = true; }
-    if (IsKeyPressed(KEY_TWO)) { currentDifficultyIndex = 1; difficultyChanged = true; }
-    if (IsKeyPressed(KEY_THREE)) { currentDifficultyIndex = 2; difficultyChanged = true; }
+    currentDifficultyIndex = difficultyIndex;
+    currentLevelIndex = levelIndex;
+    ApplyCurrentPreset(sim);
+}
 
-    // Change level with LEFT/RIGHT
-    if (IsKeyPressed(KEY_LEFT)) {
-        currentLevelIndex--;
-        if (currentLevelIndex < 0) currentLevelIndex = LEVEL_COUNT - 1;
-        levelChanged = true;
+void LevelManager::CycleLevel(int direction, Simulation& sim)
+{
+    currentLevelIndex += (direction < 0) ? -1 : 1;
+    if (currentLevelIndex < 0) currentLevelIndex = pack.GetLevelCount() - 1;
+    if (currentLevelIndex >= pack.GetLevelCount()) currentLevelIndex = 0;
+
+    ApplyCurrentPreset(sim);
+}
+
+void LevelManager::RestartCurrentLevel(Simulation& sim)
+{
+    // Same layout again. Rebuilt from its seed only if something else (an
+    // Endless Descent) has replaced the level in the meantime.
+    if (snapshot.Matches(sim)) {
+        snapshot.Restore(sim);
+        return;
     }
-    if (IsKeyPressed(KEY_RIGHT)) {
-        currentLevelIndex++;
-        if (currentLevelIndex >= LEVEL_COUNT) currentLevelIndex = 0;
-        levelChanged = true;
+    BuildLayout(sim);
+    sim.ResetRun();
+}
+
+void LevelManager::AdvanceToNextLevel(Simulation& sim)
+{
+    int next = (currentLevelIndex + 1) % pack.GetLevelCount();
+    if (prebuildRequested && requestedKey.difficultyIndex == currentDifficultyIndex &&
+        requestedKey.levelIndex == next && SwapInPrebuilt(sim, true)) {
+        return;
     }
 
-    if (difficultyChanged || levelChanged) {
-        ApplyCurrentPreset(rocket, planet, obstacles);
+    prebuildRequested = false;
+    currentLevelIndex = next;
+    ApplyCurrentPreset(sim);
+    sim.ResetRun();
+}
+
+// -------------------- BACKGROUND BUILDS --------------------
+void LevelManager::Prebuild(int difficultyIndex, int levelIndex)
+{
+    if (difficultyIndex < 0 || difficultyIndex >= pack.GetDifficultyCount()) return;
+    if (levelIndex < 0 || levelIndex >= pack.GetLevelCount()) return;
+
+    if (!prebuilt) {
+        prebuilt = std::make_unique<Prebuilt>();
+        worker = std::thread([this]() { WorkerLoop(); });
     }
 
-    // ENTER starts the level
-    if (IsKeyPressed(KEY_ENTER)) {
-        timer = 0.0f;
-        startGame = false;
-        state = GameState::PLAYING;
+    // Peek at the seed the next rebuild draws; it is only consumed on swap
+    Pcg32 next = rng;
+    {
+        std::lock_guard<std::mutex> lock(prebuildMutex);
+        requestedKey = { difficultyIndex, levelIndex, DrawLayoutSeed(next) };
+        requestId++;
     }
+    prebuildWake.notify_one();
+    prebuildRequested = true;
 }
 
-void LevelManager::RestartCurrentLevel(Rocket& rocket,
-    Planet& planet,
-    std::vector<MovingObstacle>& obstacles,
-    float& timer,
-    bool& startGame)
+void LevelManager::PrebuildNextLevel()
 {
-    ApplyCurrentPreset(rocket, planet, obstacles);
-    timer = 0.0f;
-    startGame = false;
+    Prebuild(currentDifficultyIndex, (currentLevelIndex + 1) % pack.GetLevelCount());
 }
 
-void LevelManager::AdvanceToNextLevel(Rocket& rocket,
-    Planet& planet,
-    std::vector<MovingObstacle>& obstacles,
-    float& timer,
-    bool& startGame)
+bool LevelManager::IsPrebuildReady()
 {
-    currentLevelIndex++;
-    if (currentLevelIndex >= LEVEL_COUNT) currentLevelIndex = 0;
+    if (!prebuildRequested) return false;
+    std::lock_guard<std::mutex> lock(prebuildMutex);
+    return builtId == requestId;
+}
 
-    ApplyCurrentPreset(rocket, planet, obstacles);
-    timer = 0.0f;
-    startGame = false;
+bool LevelManager::SwapInPrebuilt(Simulation& sim, bool wait)
+{
+    if (!prebuildRequested) return false;
+    {
+        std::unique_lock<std::mutex> lock(prebuildMutex);
+        if (builtId != requestId) {
+            if (!wait) return false;
+            prebuildDone.wait(lock, [this]() { return builtId == requestId; });
+        }
+    }
+    prebuildRequested = false;
+
+    // Built from a seed a synchronous rebuild has drawn since: build the
+    // preset here from the next one instead
+    const LevelKey key = prebuilt->key;
+    Pcg32 next = rng;
+    if (DrawLayoutSeed(next) != key.layoutSeed) {
+        SetPreset(key.difficultyIndex, key.levelIndex, sim);
+        sim.ResetRun();
+        return true;
+    }
+
+    rng = next;
+    currentDifficultyIndex = key.difficultyIndex;
+    currentLevelIndex = key.levelIndex;
+    layoutSeed = key.layoutSeed;
+
+    // Storage swaps only; the old level becomes the worker's next scratch
+    sim.SwapLevel(prebuilt->world);
+    obstacleLayout.swap(prebuilt->obstacleLayout);
+    std::swap(snapshot, prebuilt->snapshot);
+    snapshot.RestoreStart(sim);
+    return true;
+}
+
+void LevelManager::WorkerLoop()
+{
+    for (;;) {
+        long long id;
+        LevelKey key;
+        {
+            std::unique_lock<std::mutex> lock(prebuildMutex);
+            prebuildWake.wait(lock, [this]() { return stopping || builtId != requestId; });
+            if (stopping) return;
+            id = requestId;
+            key = requestedKey;
+        }
+
+        // Superseded requests are built to completion and then overwritten;
+        // levels are small enough that cancelling midway is not worth it
+        prebuilt->key = key;
+        BuildLevel(key.difficultyIndex, key.levelIndex, key.layoutSeed, prebuilt->obstacleLayout, prebuilt->world);
+        prebuilt->snapshot.Capture(prebuilt->world);
+
+        {
+            std::lock_guard<std::mutex> lock(prebuildMutex);
+            builtId = id;
+        }
+        prebuildDone.notify_all();
+    }
+}
+
+void LevelManager::LoadLayout(int difficultyIndex, int levelIndex, uint64_t seed, Simulation& sim)
+{
+    if (difficultyIndex < 0 || difficultyIndex >= pack.GetDifficultyCount()) return;
+    if (levelIndex < 0 || levelIndex >= pack.GetLevelCount()) return;
+
+    currentDifficultyIndex = difficultyIndex;
+    currentLevelIndex = levelIndex;
+    layoutSeed = seed;
+    BuildLayout(sim);
+    sim.ResetRun();
 }
 
 const char* LevelManager::GetDifficultyName() const
 {
-    return difficulties[currentDifficultyIndex].name;
+    return GetDifficultyName(currentDifficultyIndex);
 }
 
 const char* LevelManager::GetLevelName() const
 {
-    return levels[currentLevelIndex].name;
+    return GetLevelName(currentLevelIndex);
 }
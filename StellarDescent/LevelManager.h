@@ -1,85 +1,213 @@
 #pragma once
 #include "raylib.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include "LevelPack.h"
+#include "LevelSnapshot.h"
 #include "MovingObstacle.h"
-#include "Rocket.h"
-#include "Planet.h"
-#include "GameStateManager.h"
+#include "Random.h"
+#include "Simulation.h"
 
 /**
  * @brief Manages difficulty presets, level layouts, and obstacle generation.
  *
  * This keeps main.cpp cleaner by handling:
  *  - Difficulty & level selection
- *  - Applying presets to rocket / planet
+ *  - Applying presets to the simulation's rocket / planet
  *  - Spawning obstacles for the current level
+ *
+ * It has no input or window dependency: the menu in main.cpp maps keys
+ * onto presets, and headless tools call SetDifficulty()/CycleLevel() directly.
+ * Obstacle layouts come from a seeded generator, so a seed reproduces them.
+ *
+ * The presets come from a LevelPack: the built-in one compiled by Init(),
+ * or a compiled pack file mapped by LoadPack() (hot reload calls it again).
+ * Records are read in place, so the number of levels costs nothing until
+ * one is built.
+ *
+ * Levels can also be built ahead on a worker thread (Prebuild()) into a
+ * spare Simulation and swapped in later, which costs the same for any level
+ * size. The worker is started by the first Prebuild(), so tools that never
+ * call it run no extra thread. A prebuilt level is bit-identical to the one
+ * the same call would have built synchronously.
  */
 class LevelManager {
 public:
-    LevelManager();
-
-    // Initialize presets and apply the starting difficulty+level.
-    void Init(Rocket& rocket, Planet& planet, std::vector<MovingObstacle>& obstacles);
-
-    // Handle key input on the MENU screen:
-    //  - 1/2/3 change difficulty
-    //  - LEFT/RIGHT change level
-    //  - ENTER starts the level (sets state to PLAYING)
-    void HandleMenu(GameState& state,
-        Rocket& rocket,
-        Planet& planet,
-        std::vector<MovingObstacle>& obstacles,
-        float& timer,
-        bool& startGame);
-
-    // Restart the current level (used from PAUSED, WIN, CRASH when pressing R)
-    void RestartCurrentLevel(Rocket& rocket,
-        Planet& planet,
-        std::vector<MovingObstacle>& obstacles,
-        float& timer,
-        bool& startGame);
-
-    // Go to the next level (used from WIN when pressing ENTER)
-    void AdvanceToNextLevel(Rocket& rocket,
-        Planet& planet,
-        std::vector<MovingObstacle>& obstacles,
-        float& timer,
-        bool& startGame);
+    explicit LevelManager(uint64_t seed = 0x5eed);
+    ~LevelManager();
+
+    LevelManager(const LevelManager&) = delete;
+    LevelManager& operator=(const LevelManager&) = delete;
+
+    // Initialize presets and apply the starting difficulty+level. Uses the
+    // built-in presets unless LoadPack() already mapped a pack.
+    void Init(Simulation& sim);
+
+    // -------------------- LEVEL PACKS --------------------
+    // Map a compiled level pack (see LevelPackCompiler) and use its presets.
+    // The level in the Simulation stays as it was built; the next build,
+    // restarts included, uses the new presets (selections out of range go
+    // back to 0). On failure the presets in use are kept and @p error says
+    // why. Safe to call again on the same path to pick up a new version.
+    bool LoadPack(const char* path, std::string* error = nullptr);
+
+    // Go back to the presets compiled into the game.
+    void UseBuiltinPack();
+
+    const LevelPack& GetPack() const { return pack; }
+
+    // Replays store this to find their presets again
+    uint64_t GetPackHash() const { return pack.GetHash(); }
+
+    // Reseed the obstacle generator (affects the next layout that is built).
+    void SetSeed(uint64_t seed);
+
+    // Select a difficulty preset (0..GetDifficultyCount()-1) and rebuild the level.
+    void SetDifficulty(int index, Simulation& sim);
+
+    // Select a level preset (0..GetLevelCount()-1) and rebuild it.
+    void SetLevel(int index, Simulation& sim);
+
+    // Select both presets and rebuild the level once.
+    void SetPreset(int difficultyIndex, int levelIndex, Simulation& sim);
+
+    // Step the level selection by +1/-1 with wrap-around (menu LEFT/RIGHT).
+    void CycleLevel(int direction, Simulation& sim);
+
+    // Restart the current level with the same layout (used from PAUSED, WIN,
+    // CRASH when pressing R). Copies back a snapshot taken when the level was
+    // built: no regeneration and no allocation.
+    void RestartCurrentLevel(Simulation& sim);
+
+    // Go to the next level (used from WIN when pressing ENTER). Swaps in the
+    // level PrebuildNextLevel() built if there is one, else builds it now.
+    void AdvanceToNextLevel(Simulation& sim);
+
+    // -------------------- BACKGROUND BUILDS --------------------
+    // Start building a preset on the worker thread, with the layout seed the
+    // next rebuild would draw. Replaces any earlier request; nothing changes
+    // until SwapInPrebuilt().
+    void Prebuild(int difficultyIndex, int levelIndex);
+
+    // Prebuild() the level AdvanceToNextLevel() goes to (on entering WIN).
+    void PrebuildNextLevel();
+
+    // Make the requested level current and start a new run on it, as
+    // SetPreset() + ResetRun() would. With @p wait false this only happens
+    // if the worker has finished it; with @p wait true it waits for the
+    // worker (or builds here if the seed was drawn meanwhile).
+    // @return false if nothing was swapped in.
+    bool SwapInPrebuilt(Simulation& sim, bool wait);
+
+    // Forget the requested level (the player went elsewhere). A build in
+    // progress finishes and is thrown away.
+    void CancelPrebuild() { prebuildRequested = false; }
+
+    // Whether a Prebuild() has not been swapped in or cancelled yet.
+    bool HasPrebuild() const { return prebuildRequested; }
+
+    // Whether the worker has finished the requested level (SwapInPrebuilt()
+    // will not wait).
+    bool IsPrebuildReady();
+
+    // Preset the next SwapInPrebuilt() makes current, or the current one if
+    // none is pending (the menu shows these while the level builds).
+    int GetSelectedDifficultyIndex() const { return prebuildRequested ? requestedKey.difficultyIndex : currentDifficultyIndex; }
+    int GetSelectedLevelIndex() const { return prebuildRequested ? requestedKey.levelIndex : currentLevelIndex; }
+
+    // Rebuild one exact layout: the presets plus the layout seed it was
+    // generated from (replays store these). Starts a new run.
+    void LoadLayout(int difficultyIndex, int levelIndex, uint64_t layoutSeed, Simulation& sim);
+
+    // Seed the current obstacles and terrain were generated from. Each
+    // rebuild draws a fresh one from the generator seeded by SetSeed();
+    // restarts keep it.
+    uint64_t GetLayoutSeed() const { return layoutSeed; }
 
     // For UI
     const char* GetDifficultyName() const;
     const char* GetLevelName() const;
+    const char* GetDifficultyName(int index) const { return pack.GetName(pack.GetDifficulty(index).name); }
+    const char* GetLevelName(int index) const { return pack.GetName(pack.GetLevel(index).name); }
+
+    int GetDifficultyIndex() const { return currentDifficultyIndex; }
+    int GetLevelIndex() const { return currentLevelIndex; }
+
+    int GetDifficultyCount() const { return pack.GetDifficultyCount(); }
+    int GetLevelCount() const { return pack.GetLevelCount(); }
 
 private:
-    struct DifficultyPreset {
-        const char* name;
-        float gravity;
-        float startingFuel;
-        float padWidth;
-        int   obstacleCount;
+    // Presets in use (built-in image or mapped file)
+    LevelPack pack;
+
+    int currentDifficultyIndex;
+    int currentLevelIndex;
+
+    // Draws one layout seed per rebuild
+    Pcg32 rng;
+    uint64_t layoutSeed = 0;
+
+    // Obstacle descriptors for the current preset (reused between levels)
+    std::vector<MovingObstacle> obstacleLayout;
+
+    // The level as last built, for RestartCurrentLevel()
+    LevelSnapshot snapshot;
+
+    struct LevelKey {
+        int difficultyIndex = 0;
+        int levelIndex = 0;
+        uint64_t layoutSeed = 0;
     };
 
-    struct LevelPreset {
-        const char* name;
-        Vector2 startPos;   // where the rocket spawns
-        float padCenterX;   // X position of landing pad center
+    // A level built (or being built) by the worker thread. The worker owns
+    // it while building; the main thread only touches it once the worker
+    // has finished the latest request.
+    struct Prebuilt {
+        LevelKey key;
+        Simulation world;
+        std::vector<MovingObstacle> obstacleLayout;
+        LevelSnapshot snapshot;
     };
 
-    static constexpr int DIFFICULTY_COUNT = 3;
-    static constexpr int LEVEL_COUNT = 6;   // <-- now 6 levels
+    std::unique_ptr<Prebuilt> prebuilt;
+    bool prebuildRequested = false;         // main thread only
 
-    DifficultyPreset difficulties[DIFFICULTY_COUNT];
-    LevelPreset      levels[LEVEL_COUNT];
+    std::mutex prebuildMutex;
+    std::condition_variable prebuildWake;   // new request or stopping
+    std::condition_variable prebuildDone;   // a build finished
+    LevelKey requestedKey;                  // written by the main thread only
+    long long requestId = 0;                // bumped by every Prebuild()
+    long long builtId = 0;                  // request the worker last finished
+    bool stopping = false;
+    std::thread worker;
 
-    int currentDifficultyIndex;
-    int currentLevelIndex;
+    void ApplyCurrentPreset(Simulation& sim);
+    void BuildLayout(Simulation& sim);
+
+    // The whole level for one preset and seed into @p sim. Reads only the
+    // presets, so the worker thread can run it.
+    void BuildLevel(int difficultyIndex, int levelIndex, uint64_t seed,
+        std::vector<MovingObstacle>& obstacles, Simulation& sim) const;
+
+    // Next layout seed from @p from (advances it)
+    static uint64_t DrawLayoutSeed(Pcg32& from);
+
+    void WorkerLoop();
+
+    // Block until the worker is idle (it reads the pack while building)
+    void WaitForWorker();
 
-    void ApplyCurrentPreset(Rocket& rocket,
-        Planet& planet,
-        std::vector<MovingObstacle>& obstacles);
+    // Swap in a freshly opened pack and bring the selections into range
+    void AdoptPack(LevelPack& newPack);
 
-    void SetupObstacles(const DifficultyPreset& diff,
-        const LevelPreset& level,
-        std::vector<MovingObstacle>& obstacles);
+    void SetupObstacles(const LevelPackFormat::Difficulty& diff,
+        const LevelPackFormat::Level& level,
+        Pcg32& layoutRng,
+        std::vector<MovingObstacle>& obstacles) const;
 };
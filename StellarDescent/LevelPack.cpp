@@ -0,0 +1,131 @@
+#include "LevelPack.h"
+#include <cstring>
+#include <utility>
+
+#include "StateHash.h"
+
+using namespace LevelPackFormat;
+
+namespace
+{
+    bool Fail(std::string* error, const char* what)
+    {
+        if (error) *error = what;
+        return false;
+    }
+
+    // Section [offset, offset + count * stride) inside the file and aligned
+    bool SectionFits(uint32_t offset, uint32_t count, size_t stride, size_t fileSize)
+    {
+        if (offset % ALIGNMENT != 0 || offset < sizeof(Header) || offset > fileSize) return false;
+        return (uint64_t)count * stride <= fileSize - offset;
+    }
+}
+
+bool LevelPack::Open(const char* filePath, std::string* error)
+{
+    Close();
+
+    MappedFile mapped;
+    if (!mapped.Open(filePath, error)) return false;
+    if (!Bind(mapped.GetData(), mapped.GetSize(), error)) {
+        if (error) *error = std::string(filePath) + ": " + *error;
+        return false;
+    }
+
+    file = std::move(mapped);
+    path = filePath;
+    return true;
+}
+
+bool LevelPack::Adopt(std::vector<uint8_t> bytes, std::string* error)
+{
+    Close();
+
+    if (!Bind(bytes.data(), bytes.size(), error)) return false;
+    image = std::move(bytes);   // moving keeps the buffer, so the pointers stay valid
+    return true;
+}
+
+void LevelPack::Close()
+{
+    file.Close();
+    image.clear();
+    path.clear();
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    difficulties = nullptr;
+    levels = nullptr;
+    obstacles = nullptr;
+    strings = nullptr;
+}
+
+bool LevelPack::Bind(const uint8_t* bytes, size_t byteCount, std::string* error)
+{
+    // Header only: this runs at startup and on every hot reload
+    if (byteCount < sizeof(Header)) return Fail(error, "too small for a level pack");
+    if ((uintptr_t)bytes % ALIGNMENT != 0) return Fail(error, "misaligned image");
+
+    const Header* h = (const Header*)bytes;
+    if (h->magic != MAGIC) {
+        uint32_t swapped = (MAGIC >> 24) | ((MAGIC >> 8) & 0xff00) | ((MAGIC << 8) & 0xff0000) | (MAGIC << 24);
+        return Fail(error, h->magic == swapped ? "level pack of the wrong byte order" : "not a level pack");
+    }
+    if (h->version != VERSION) return Fail(error, "level pack version not supported (recompile it)");
+    if (h->fileSize != byteCount) return Fail(error, "level pack truncated or padded");
+    if (h->difficultyCount == 0 || h->levelCount == 0) return Fail(error, "level pack has no difficulties or no levels");
+
+    if (!SectionFits(h->difficultyOffset, h->difficultyCount, sizeof(Difficulty), byteCount) ||
+        !SectionFits(h->levelOffset, h->levelCount, sizeof(Level), byteCount) ||
+        !SectionFits(h->obstacleOffset, h->obstacleCount, sizeof(Obstacle), byteCount) ||
+        !SectionFits(h->stringOffset, h->stringBytes, 1, byteCount)) {
+        return Fail(error, "level pack section out of bounds");
+    }
+    if (h->stringBytes == 0 || bytes[h->stringOffset + h->stringBytes - 1] != 0) {
+        return Fail(error, "level pack string table not terminated");
+    }
+
+    data = bytes;
+    size = byteCount;
+    header = h;
+    difficulties = (const Difficulty*)(bytes + h->difficultyOffset);
+    levels = (const Level*)(bytes + h->levelOffset);
+    obstacles = (const Obstacle*)(bytes + h->obstacleOffset);
+    strings = (const char*)(bytes + h->stringOffset);
+    return true;
+}
+
+const char* LevelPack::GetName(uint32_t offset) const
+{
+    // The table ends in a NUL, so any offset inside it reads a terminated string
+    return header && offset < header->stringBytes ? strings + offset : "";
+}
+
+const Obstacle* LevelPack::GetObstacles(const Level& level, int& count) const
+{
+    if (!header || level.firstObstacle > header->obstacleCount ||
+        level.obstacleCount > header->obstacleCount - level.firstObstacle) {
+        count = 0;
+        return nullptr;
+    }
+    count = (int)level.obstacleCount;
+    return obstacles + level.firstObstacle;
+}
+
+uint64_t LevelPack::HashContent(const uint8_t* bytes, size_t byteCount)
+{
+    StateHash h;
+    h.Add((uint64_t)byteCount);
+    for (size_t i = sizeof(Header); i < byteCount; i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i, byteCount - i < 8 ? byteCount - i : 8);
+        h.Add(word);
+    }
+    return h.Get();
+}
+
+bool LevelPack::VerifyHash() const
+{
+    return header && HashContent(data, size) == header->contentHash;
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "MappedFile.h"
+
+/**
+ * @brief On-disk layout of a compiled level pack (*.sdpack).
+ *
+ * One header, then four sections at 8-byte aligned offsets: difficulty
+ * records, level records, every level's authored obstacles back to back,
+ * and a string table of NUL-terminated names. All fields are 4 or 8 bytes,
+ * little-endian, with no padding, so the records are read in place
+ * straight from the mapped file. LevelPackCompiler writes it.
+ *
+ * VERSION changes whenever a record changes; older packs are rejected and
+ * need recompiling from their text source.
+ */
+namespace LevelPackFormat
+{
+    constexpr uint32_t MAGIC = 0x504c4453;   // "SDLP"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t ALIGNMENT = 8;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fileSize;
+        uint64_t contentHash;        // of every byte after the header
+        uint32_t difficultyCount;
+        uint32_t difficultyOffset;
+        uint32_t levelCount;
+        uint32_t levelOffset;
+        uint32_t obstacleCount;
+        uint32_t obstacleOffset;
+        uint32_t stringBytes;
+        uint32_t stringOffset;
+        uint32_t reserved[2];        // zero
+    };
+
+    struct Difficulty {
+        uint32_t name;               // string table offset
+        float gravity;
+        float startingFuel;
+        float padWidth;
+        int32_t obstacleCount;       // generated per layout, on top of the authored ones
+    };
+
+    /// Terrain::Settings a level overrides (the rest follows from the pad).
+    struct TerrainParams {
+        float minX;
+        float maxX;
+        float spacing;
+        float hillHeight;
+        float hillWavelength;
+        int32_t craterCount;
+        float craterMinRadius;
+        float craterMaxRadius;
+        float craterDepth;
+        float padMargin;
+        float padBlend;
+    };
+
+    struct Level {
+        uint32_t name;               // string table offset
+        float startX;                // where the rocket spawns
+        float startY;
+        float padCenterX;            // X position of landing pad center
+        uint32_t firstObstacle;      // into the obstacle section
+        uint32_t obstacleCount;      // authored obstacles
+        TerrainParams terrain;
+    };
+
+    struct Obstacle {
+        float x;                     // top-left, like MovingObstacle::rect
+        float y;
+        float width;
+        float height;
+        uint32_t pattern;            // ObstaclePattern
+        float amplitude;
+        float frequency;
+        float phase;
+        float angularVelocity;       // deg/sec
+    };
+
+    static_assert(sizeof(Header) == 64, "level pack header layout changed");
+    static_assert(sizeof(Difficulty) == 20, "level pack difficulty layout changed");
+    static_assert(sizeof(TerrainParams) == 44, "level pack terrain layout changed");
+    static_assert(sizeof(Level) == 68, "level pack level layout changed");
+    static_assert(sizeof(Obstacle) == 36, "level pack obstacle layout changed");
+    static_assert(std::is_trivially_copyable<Level>::value && std::is_standard_layout<Level>::value,
+        "level pack records are used in place");
+}
+
+/**
+ * @brief A compiled level pack, used in place.
+ *
+ * Open() maps the file and checks only the header: magic, version, size
+ * and that every section lies inside the file. Nothing else is read, so
+ * opening costs the same for ten levels or ten thousand, and only the
+ * pages of the levels actually played are ever loaded. Record fields that
+ * point elsewhere (names, obstacle ranges) are bounds-checked where they
+ * are read.
+ *
+ * Adopt() takes an image compiled in memory instead (the built-in
+ * presets), which is used exactly the same way.
+ */
+class LevelPack {
+public:
+    /// Map and check a compiled pack. Leaves the pack closed on failure.
+    bool Open(const char* path, std::string* error = nullptr);
+
+    /// Use a compiled image held in memory. Leaves the pack closed on failure.
+    bool Adopt(std::vector<uint8_t> image, std::string* error = nullptr);
+
+    void Close();
+
+    bool IsOpen() const { return header != nullptr; }
+
+    /// File it was mapped from, empty for an adopted image.
+    const std::string& GetPath() const { return path; }
+
+    /// Identifies the contents: equal packs have equal hashes (replays store it).
+    uint64_t GetHash() const { return header ? header->contentHash : 0; }
+
+    /// Bytes of the compiled image (mapped, not necessarily resident).
+    size_t GetSize() const { return size; }
+
+    /// Recompute the content hash and compare (reads every byte; tools only).
+    bool VerifyHash() const;
+
+    int GetDifficultyCount() const { return header ? (int)header->difficultyCount : 0; }
+    int GetLevelCount() const { return header ? (int)header->levelCount : 0; }
+
+    const LevelPackFormat::Difficulty& GetDifficulty(int index) const { return difficulties[index]; }
+    const LevelPackFormat::Level& GetLevel(int index) const { return levels[index]; }
+
+    /// A name from the string table ("" if the offset is out of range).
+    const char* GetName(uint32_t offset) const;
+
+    /// The level's authored obstacles (@p count 0 if its range is out of bounds).
+    const LevelPackFormat::Obstacle* GetObstacles(const LevelPackFormat::Level& level, int& count) const;
+
+    /// Hash of a compiled image's payload, as stored in its header.
+    static uint64_t HashContent(const uint8_t* data, size_t size);
+
+private:
+    MappedFile file;
+    std::vector<uint8_t> image;
+    std::string path;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    const LevelPackFormat::Header* header = nullptr;
+    const LevelPackFormat::Difficulty* difficulties = nullptr;
+    const LevelPackFormat::Level* levels = nullptr;
+    const LevelPackFormat::Obstacle* obstacles = nullptr;
+    const char* strings = nullptr;
+
+    bool Bind(const uint8_t* bytes, size_t byteCount, std::string* error);
+};
@@ -0,0 +1,423 @@
+#include "LevelPackCompiler.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace LevelPackFormat;
+
+LevelPackFormat::TerrainParams LevelPackSource::DefaultTerrain()
+{
+    // The same numbers as Terrain::Settings, which LevelManager used before packs
+    TerrainParams t;
+    t.minX = -1000.0f;
+    t.maxX = 1000.0f;
+    t.spacing = 8.0f;
+    t.hillHeight = 40.0f;
+    t.hillWavelength = 320.0f;
+    t.craterCount = 3;
+    t.craterMinRadius = 40.0f;
+    t.craterMaxRadius = 90.0f;
+    t.craterDepth = 30.0f;
+    t.padMargin = 40.0f;
+    t.padBlend = 80.0f;
+    return t;
+}
+
+namespace
+{
+    const char* const PATTERN_NAMES[] = { "static", "horizontal", "vertical" };
+    constexpr size_t MAX_NAME_LENGTH = 64;
+
+    // -------------------- TEXT --------------------
+    // Splits a line into words; "quoted text" is one word without its quotes
+    bool Tokenize(const std::string& line, std::vector<std::string>& words, std::string& error)
+    {
+        words.clear();
+        size_t i = 0;
+        while (i < line.size()) {
+            char c = line[i];
+            if (c == '#') break;
+            if (c == ' ' || c == '\t' || c == '\r') {
+                ++i;
+                continue;
+            }
+            if (c == '"') {
+                size_t end = line.find('"', i + 1);
+                if (end == std::string::npos) {
+                    error = "unterminated quote";
+                    return false;
+                }
+                words.push_back(line.substr(i + 1, end - i - 1));
+                i = end + 1;
+                continue;
+            }
+            size_t end = i;
+            while (end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '\r' && line[end] != '#') ++end;
+            words.push_back(line.substr(i, end - i));
+            i = end;
+        }
+        return true;
+    }
+
+    bool ToFloat(const std::string& word, float& out)
+    {
+        if (word.empty()) return false;
+        char* end = nullptr;
+        out = std::strtof(word.c_str(), &end);
+        return *end == '\0' && std::isfinite(out);
+    }
+
+    bool ToInt(const std::string& word, int& out)
+    {
+        if (word.empty()) return false;
+        char* end = nullptr;
+        long v = std::strtol(word.c_str(), &end, 10);
+        out = (int)v;
+        return *end == '\0' && v >= -1000000000L && v <= 1000000000L;
+    }
+
+    // key=value words from @p first on, handed to @p set(key, value)
+    template <typename Set>
+    bool ParseKeys(const std::vector<std::string>& words, size_t first, std::string& error, Set&& set)
+    {
+        for (size_t i = first; i < words.size(); ++i) {
+            size_t eq = words[i].find('=');
+            if (eq == std::string::npos) {
+                error = "expected key=value, got '" + words[i] + "'";
+                return false;
+            }
+            std::string key = words[i].substr(0, eq);
+            std::string value = words[i].substr(eq + 1);
+            if (!set(key, value)) {
+                if (error.empty()) error = "bad value for '" + key + "': '" + value + "'";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ParseLine(const std::vector<std::string>& words, LevelPackSource& out, std::string& error)
+    {
+        const std::string& what = words[0];
+
+        if (what == "difficulty") {
+            if (words.size() < 2) {
+                error = "difficulty needs a name";
+                return false;
+            }
+            LevelPackSource::Difficulty d;
+            d.name = words[1];
+            bool ok = ParseKeys(words, 2, error, [&](const std::string& key, const std::string& value) {
+                if (key == "gravity") return ToFloat(value, d.gravity);
+                if (key == "fuel") return ToFloat(value, d.startingFuel);
+                if (key == "pad") return ToFloat(value, d.padWidth);
+                if (key == "obstacles") return ToInt(value, d.obstacleCount);
+                error = "unknown difficulty key '" + key + "'";
+                return false;
+            });
+            out.difficulties.push_back(d);
+            return ok;
+        }
+
+        if (what == "level") {
+            if (words.size() != 2) {
+                error = "level needs exactly one name";
+                return false;
+            }
+            out.levels.emplace_back();
+            out.levels.back().name = words[1];
+            return true;
+        }
+
+        // Everything else describes the level above it
+        if (out.levels.empty()) {
+            error = "'" + what + "' before the first level";
+            return false;
+        }
+        LevelPackSource::Level& level = out.levels.back();
+
+        if (what == "start") {
+            if (words.size() != 3 || !ToFloat(words[1], level.startX) || !ToFloat(words[2], level.startY)) {
+                error = "start needs X Y";
+                return false;
+            }
+            return true;
+        }
+        if (what == "pad") {
+            if (words.size() != 2 || !ToFloat(words[1], level.padCenterX)) {
+                error = "pad needs a center X";
+                return false;
+            }
+            return true;
+        }
+        if (what == "terrain") {
+            TerrainParams& t = level.terrain;
+            return ParseKeys(words, 1, error, [&](const std::string& key, const std::string& value) {
+                if (key == "min_x") return ToFloat(value, t.minX);
+                if (key == "max_x") return ToFloat(value, t.maxX);
+                if (key == "spacing") return ToFloat(value, t.spacing);
+                if (key == "hills") return ToFloat(value, t.hillHeight);
+                if (key == "wavelength") return ToFloat(value, t.hillWavelength);
+                if (key == "craters") {
+                    int count;
+                    if (!ToInt(value, count)) return false;
+                    t.craterCount = count;
+                    return true;
+                }
+                if (key == "crater_min") return ToFloat(value, t.craterMinRadius);
+                if (key == "crater_max") return ToFloat(value, t.craterMaxRadius);
+                if (key == "crater_depth") return ToFloat(value, t.craterDepth);
+                if (key == "pad_margin") return ToFloat(value, t.padMargin);
+                if (key == "pad_blend") return ToFloat(value, t.padBlend);
+                error = "unknown terrain key '" + key + "'";
+                return false;
+            });
+        }
+        if (what == "obstacle") {
+            LevelPackSource::Obstacle o;
+            if (words.size() < 5 || !ToFloat(words[1], o.x) || !ToFloat(words[2], o.y) ||
+                !ToFloat(words[3], o.width) || !ToFloat(words[4], o.height)) {
+                error = "obstacle needs X Y WIDTH HEIGHT";
+                return false;
+            }
+            bool ok = ParseKeys(words, 5, error, [&](const std::string& key, const std::string& value) {
+                if (key == "pattern") {
+                    for (int p = 0; p < 3; ++p) {
+                        if (value == PATTERN_NAMES[p]) {
+                            o.pattern = (ObstaclePattern)p;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                if (key == "amplitude") return ToFloat(value, o.amplitude);
+                if (key == "frequency") return ToFloat(value, o.frequency);
+                if (key == "phase") return ToFloat(value, o.phase);
+                if (key == "spin") return ToFloat(value, o.angularVelocity);
+                error = "unknown obstacle key '" + key + "'";
+                return false;
+            });
+            level.obstacles.push_back(o);
+            return ok;
+        }
+
+        error = "unknown line '" + what + "'";
+        return false;
+    }
+
+    // -------------------- BINARY --------------------
+    size_t AlignUp(size_t offset) { return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, size_t offset, const T& value)
+    {
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    bool CheckTerrain(const TerrainParams& t)
+    {
+        return t.minX < t.maxX && t.spacing >= 1.0f && (t.maxX - t.minX) / t.spacing <= 1e6f &&
+            t.hillWavelength > 0.0f && t.craterCount >= 0 && t.craterCount <= 1000 &&
+            t.craterMinRadius > 0.0f && t.craterMinRadius <= t.craterMaxRadius && t.padBlend > 0.0f;
+    }
+}
+
+// -------------------- PARSE --------------------
+bool LevelPackCompiler::Parse(const std::string& text, LevelPackSource& out, std::string& error)
+{
+    out = LevelPackSource();
+
+    std::vector<std::string> words;
+    size_t start = 0;
+    int lineNumber = 0;
+    while (start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+        ++lineNumber;
+
+        std::string lineError;
+        if (!Tokenize(line, words, lineError) || (!words.empty() && !ParseLine(words, out, lineError))) {
+            error = "line " + std::to_string(lineNumber) + ": " + lineError;
+            return false;
+        }
+    }
+    return true;
+}
+
+// -------------------- COMPILE --------------------
+bool LevelPackCompiler::Compile(const LevelPackSource& source, std::vector<uint8_t>& out, std::string& error)
+{
+    if (source.difficulties.empty() || source.levels.empty()) {
+        error = "a pack needs at least one difficulty and one level";
+        return false;
+    }
+
+    // Names go in the string table in record order
+    std::string names;
+    std::vector<uint32_t> difficultyNames, levelNames;
+    auto badName = [](const std::string& name) {
+        return name.empty() || name.size() > MAX_NAME_LENGTH || name.find_first_of("\"\n") != std::string::npos;
+    };
+    size_t obstacleCount = 0;
+    for (const LevelPackSource::Difficulty& d : source.difficulties) {
+        if (badName(d.name) || d.obstacleCount < 0 || d.padWidth <= 0.0f) {
+            error = "difficulty '" + d.name + "': needs a name (no quotes), a positive pad width and obstacles >= 0";
+            return false;
+        }
+        difficultyNames.push_back((uint32_t)names.size());
+        names += d.name;
+        names += '\0';
+    }
+    for (const LevelPackSource::Level& l : source.levels) {
+        if (badName(l.name) || !CheckTerrain(l.terrain)) {
+            error = "level '" + l.name + "': needs a name (no quotes) and sane terrain (min_x < max_x, spacing >= 1, crater_min <= crater_max)";
+            return false;
+        }
+        for (const LevelPackSource::Obstacle& o : l.obstacles) {
+            if (o.width <= 0.0f || o.height <= 0.0f || (int)o.pattern < 0 || (int)o.pattern > 2) {
+                error = "level '" + l.name + "': obstacles need a positive size and a known pattern";
+                return false;
+            }
+        }
+        levelNames.push_back((uint32_t)names.size());
+        names += l.name;
+        names += '\0';
+        obstacleCount += l.obstacles.size();
+    }
+
+    // -------------------- LAYOUT --------------------
+    Header h = {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.difficultyCount = (uint32_t)source.difficulties.size();
+    h.levelCount = (uint32_t)source.levels.size();
+    h.obstacleCount = (uint32_t)obstacleCount;
+    h.stringBytes = (uint32_t)names.size();
+
+    size_t offset = AlignUp(sizeof(Header));
+    h.difficultyOffset = (uint32_t)offset;
+    offset = AlignUp(offset + h.difficultyCount * sizeof(Difficulty));
+    h.levelOffset = (uint32_t)offset;
+    offset = AlignUp(offset + (size_t)h.levelCount * sizeof(Level));
+    h.obstacleOffset = (uint32_t)offset;
+    offset = AlignUp(offset + obstacleCount * sizeof(Obstacle));
+    h.stringOffset = (uint32_t)offset;
+    offset = AlignUp(offset + names.size());
+    if (offset > 0xffffffffu) {
+        error = "pack larger than 4 GB";
+        return false;
+    }
+    h.fileSize = offset;
+
+    out.assign(offset, 0);
+
+    for (size_t i = 0; i < source.difficulties.size(); ++i) {
+        const LevelPackSource::Difficulty& s = source.difficulties[i];
+        Difficulty d = {};
+        d.name = difficultyNames[i];
+        d.gravity = s.gravity;
+        d.startingFuel = s.startingFuel;
+        d.padWidth = s.padWidth;
+        d.obstacleCount = s.obstacleCount;
+        Put(out, h.difficultyOffset + i * sizeof(Difficulty), d);
+    }
+
+    uint32_t firstObstacle = 0;
+    for (size_t i = 0; i < source.levels.size(); ++i) {
+        const LevelPackSource::Level& s = source.levels[i];
+        Level l = {};
+        l.name = levelNames[i];
+        l.startX = s.startX;
+        l.startY = s.startY;
+        l.padCenterX = s.padCenterX;
+        l.firstObstacle = firstObstacle;
+        l.obstacleCount = (uint32_t)s.obstacles.size();
+        l.terrain = s.terrain;
+        Put(out, h.levelOffset + i * sizeof(Level), l);
+
+        for (const LevelPackSource::Obstacle& so : s.obstacles) {
+            Obstacle o = {};
+            o.x = so.x;
+            o.y = so.y;
+            o.width = so.width;
+            o.height = so.height;
+            o.pattern = (uint32_t)so.pattern;
+            o.amplitude = so.amplitude;
+            o.frequency = so.frequency;
+            o.phase = so.phase;
+            o.angularVelocity = so.angularVelocity;
+            Put(out, h.obstacleOffset + (size_t)firstObstacle * sizeof(Obstacle), o);
+            firstObstacle++;
+        }
+    }
+
+    std::memcpy(out.data() + h.stringOffset, names.data(), names.size());
+
+    h.contentHash = LevelPack::HashContent(out.data(), out.size());
+    Put(out, 0, h);
+    return true;
+}
+
+// -------------------- DECOMPILE --------------------
+std::string LevelPackCompiler::ToText(const LevelPack& pack)
+{
+    // %.9g prints every float so that it parses back to the same bits
+    std::string text = "# Stellar Descent level pack\n\n";
+    char line[512];
+
+    for (int i = 0; i < pack.GetDifficultyCount(); ++i) {
+        const Difficulty& d = pack.GetDifficulty(i);
+        std::snprintf(line, sizeof(line), "difficulty \"%s\" gravity=%.9g fuel=%.9g pad=%.9g obstacles=%d\n",
+            pack.GetName(d.name), d.gravity, d.startingFuel, d.padWidth, d.obstacleCount);
+        text += line;
+    }
+
+    for (int i = 0; i < pack.GetLevelCount(); ++i) {
+        const Level& l = pack.GetLevel(i);
+        const TerrainParams& t = l.terrain;
+        std::snprintf(line, sizeof(line),
+            "\nlevel \"%s\"\nstart %.9g %.9g\npad %.9g\n"
+            "terrain min_x=%.9g max_x=%.9g spacing=%.9g hills=%.9g wavelength=%.9g craters=%d "
+            "crater_min=%.9g crater_max=%.9g crater_depth=%.9g pad_margin=%.9g pad_blend=%.9g\n",
+            pack.GetName(l.name), l.startX, l.startY, l.padCenterX,
+            t.minX, t.maxX, t.spacing, t.hillHeight, t.hillWavelength, t.craterCount,
+            t.craterMinRadius, t.craterMaxRadius, t.craterDepth, t.padMargin, t.padBlend);
+        text += line;
+
+        int count = 0;
+        const Obstacle* obstacles = pack.GetObstacles(l, count);
+        for (int j = 0; j < count; ++j) {
+            const Obstacle& o = obstacles[j];
+            std::snprintf(line, sizeof(line),
+                "obstacle %.9g %.9g %.9g %.9g pattern=%s amplitude=%.9g frequency=%.9g phase=%.9g spin=%.9g\n",
+                o.x, o.y, o.width, o.height, PATTERN_NAMES[o.pattern < 3 ? o.pattern : 0],
+                o.amplitude, o.frequency, o.phase, o.angularVelocity);
+            text += line;
+        }
+    }
+    return text;
+}
+
+// -------------------- FILES --------------------
+bool LevelPackCompiler::Write(const std::vector<uint8_t>& image, const char* path, std::string& error)
+{
+    return MappedFile::Replace(path, image.data(), image.size(), error);
+}
+
+bool LevelPackCompiler::ReadText(const char* path, std::string& out, std::string& error)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        error = std::string(path) + ": cannot open";
+        return false;
+    }
+    out.clear();
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) out.append(buffer, n);
+    std::fclose(file);
+    return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LevelPack.h"
+#include "MovingObstacle.h"
+
+/**
+ * @brief A level pack as authored, before compiling.
+ *
+ * Defaults match the original built-in presets: no authored obstacles and
+ * the Terrain::Settings defaults, so a level that only sets its start and
+ * pad plays exactly like one of those.
+ */
+struct LevelPackSource {
+    struct Difficulty {
+        std::string name;
+        float gravity = 80.0f;
+        float startingFuel = 100.0f;
+        float padWidth = 100.0f;
+        int obstacleCount = 0;          // generated per layout
+    };
+
+    struct Obstacle {
+        float x = 0.0f;                 // top-left
+        float y = 0.0f;
+        float width = 40.0f;
+        float height = 10.0f;
+        ObstaclePattern pattern = ObstaclePattern::STATIC;
+        float amplitude = 0.0f;
+        float frequency = 0.0f;
+        float phase = 0.0f;
+        float angularVelocity = 0.0f;
+    };
+
+    struct Level {
+        std::string name;
+        float startX = 0.0f;
+        float startY = -200.0f;
+        float padCenterX = 0.0f;
+        std::vector<Obstacle> obstacles;
+        LevelPackFormat::TerrainParams terrain = DefaultTerrain();
+    };
+
+    std::vector<Difficulty> difficulties;
+    std::vector<Level> levels;
+
+    static LevelPackFormat::TerrainParams DefaultTerrain();
+};
+
+/**
+ * @brief Turns level pack text into the compiled binary form, and back.
+ *
+ * The text form is line based; '#' starts a comment. A difficulty is one
+ * line; a level starts with its "level" line and the lines after it
+ * belong to it:
+ *
+ *     difficulty "Normal" gravity=80 fuel=100 pad=100 obstacles=4
+ *
+ *     level "Central Valley"
+ *     start 0 -200
+ *     pad 0
+ *     terrain hills=40 wavelength=320 craters=3
+ *     obstacle -60 40 70 12 pattern=horizontal amplitude=40 frequency=1 phase=0 spin=45
+ *
+ * Omitted keys keep their LevelPackSource defaults. Terrain keys: min_x,
+ * max_x, spacing, hills, wavelength, craters, crater_min, crater_max,
+ * crater_depth, pad_margin, pad_blend. Patterns: static, horizontal,
+ * vertical.
+ *
+ * Parsing happens only here (the level_pack tool); the game maps the
+ * compiled file.
+ */
+namespace LevelPackCompiler
+{
+    /// Parse pack text. @p error is "line N: ..." on failure.
+    bool Parse(const std::string& text, LevelPackSource& out, std::string& error);
+
+    /// Check @p source and lay it out as a compiled image (see LevelPackFormat).
+    bool Compile(const LevelPackSource& source, std::vector<uint8_t>& out, std::string& error);
+
+    /// Text that parses and compiles back to exactly @p pack.
+    std::string ToText(const LevelPack& pack);
+
+    /// Write @p image to a temporary file beside @p path and rename it over
+    /// @p path, so a watcher never sees it half written.
+    bool Write(const std::vector<uint8_t>& image, const char* path, std::string& error);
+
+    /// Read a whole text file.
+    bool ReadText(const char* path, std::string& out, std::string& error);
+}
@@ -0,0 +1,54 @@
+#include "LevelSnapshot.h"
+
+void LevelSnapshot::Capture(const Simulation& sim)
+{
+    const Rocket& rocket = sim.rocket;
+    header.rocketStart = rocket.position;
+    header.rotation = rocket.rotation;
+    header.fuel = rocket.fuel;
+    header.maxFuel = rocket.maxFuel;
+    header.gravity = rocket.gravity;
+    header.planet = sim.planet;
+    header.obstacleTime = sim.obstacles.GetTime();
+    header.obstacleCount = sim.obstacles.Size();
+    header.layoutHash = sim.obstacles.GetLayoutHash();
+    header.terrainHash = sim.terrain.GetHash();
+
+    poses.resize(sim.obstacles.GetPoseFloats());
+    sim.obstacles.CopyPosesTo(poses.data());
+    captured = true;
+}
+
+bool LevelSnapshot::Matches(const Simulation& sim) const
+{
+    return captured &&
+        sim.obstacles.Size() == header.obstacleCount &&
+        sim.obstacles.GetLayoutHash() == header.layoutHash &&
+        sim.terrain.GetHash() == header.terrainHash;
+}
+
+void LevelSnapshot::Restore(Simulation& sim) const
+{
+    sim.obstacles.CopyPosesFrom(poses.data(), header.obstacleTime);
+    RestoreStart(sim);
+}
+
+void LevelSnapshot::RestoreStart(Simulation& sim) const
+{
+    // Same fields, in the same state, as Rocket::Reset() left them
+    Rocket& rocket = sim.rocket;
+    rocket.maxFuel = header.maxFuel;
+    rocket.gravity = header.gravity;
+    rocket.position = header.rocketStart;
+    rocket.velocity = { 0, 0 };
+    rocket.rotation = header.rotation;
+    rocket.prevPosition = header.rocketStart;
+    rocket.prevRotation = header.rotation;
+    rocket.fuel = header.fuel;
+    rocket.isAlive = true;
+    rocket.hasLanded = false;
+    rocket.isThrusting = false;
+
+    sim.planet = header.planet;
+    sim.ResetRun();
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Planet.h"
+#include "Simulation.h"
+
+/**
+ * @brief A level exactly as it was built, for restarting it instantly.
+ *
+ * Holds the rocket's start state, the planet (gravity, pad) and every
+ * obstacle pose in one flat block. Restoring is a handful of plain copies
+ * into storage the Simulation already has: no obstacle generation, no
+ * sorting, no allocation, and the same layout every time.
+ *
+ * Only what a run changes is stored. The obstacle descriptors and the
+ * terrain stay in the Simulation; Matches() checks by their hashes that
+ * they are still the ones captured.
+ */
+class LevelSnapshot {
+public:
+    /// Capture @p sim as just built. Allocates only if the level has more obstacles than any before.
+    void Capture(const Simulation& sim);
+
+    /// True if @p sim still holds the obstacles and terrain captured here.
+    bool Matches(const Simulation& sim) const;
+
+    /// Put @p sim back to the captured level and start a new run. Needs Matches().
+    void Restore(Simulation& sim) const;
+
+    /// Restore() for obstacles already posed as captured (a level just
+    /// swapped in): rocket, planet and a new run only.
+    void RestoreStart(Simulation& sim) const;
+
+    bool IsEmpty() const { return !captured; }
+
+    /// Forget the level (its presets changed; the next restart rebuilds it).
+    void Clear() { captured = false; }
+
+private:
+    /// Everything but the poses, copied whole
+    struct Header {
+        Vector2 rocketStart;
+        float rotation;
+        float fuel;
+        float maxFuel;
+        float gravity;
+        Planet planet;
+        double obstacleTime;
+        int obstacleCount;
+        uint64_t layoutHash;
+        uint64_t terrainHash;
+    };
+    static_assert(std::is_trivially_copyable<Header>::value, "snapshot header must be trivially copyable");
+
+    Header header = {};
+    std::vector<float> poses;   // ObstacleField::CopyPosesTo() block
+    bool captured = false;
+};
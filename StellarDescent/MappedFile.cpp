@@ -0,0 +1,147 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace
+{
+    bool Fail(std::string* error, const char* path, const char* what)
+    {
+        if (error) *error = std::string(path) + ": " + what;
+        return false;
+    }
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        data = other.data;
+        size = other.size;
+        other.data = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const char* path, std::string* error)
+{
+    Close();
+
+    // FILE_SHARE_DELETE so a tool can rename a new version over the file
+    // while the game has it mapped (hot reload)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return Fail(error, path, "cannot open");
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return Fail(error, path, "empty or unreadable");
+    }
+
+    // The view keeps the mapping (and the file) alive; both handles can go
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return Fail(error, path, "cannot map");
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return Fail(error, path, "cannot map");
+
+    data = (const uint8_t*)view;
+    size = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data) UnmapViewOfFile(data);
+    data = nullptr;
+    size = 0;
+}
+
+void MappedFile::WillNeed(size_t offset, size_t length) const
+{
+    if (!data || offset >= size || length == 0) return;
+    WIN32_MEMORY_RANGE_ENTRY range = { (void*)(data + offset), length < size - offset ? length : size - offset };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+#else
+bool MappedFile::Open(const char* path, std::string* error)
+{
+    Close();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return Fail(error, path, std::strerror(errno));
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return Fail(error, path, "empty or unreadable");
+    }
+
+    // The mapping holds its own reference to the file
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return Fail(error, path, std::strerror(errno));
+
+    data = (const uint8_t*)view;
+    size = (size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data) munmap((void*)data, size);
+    data = nullptr;
+    size = 0;
+}
+
+void MappedFile::WillNeed(size_t offset, size_t length) const
+{
+    if (!data || offset >= size || length == 0) return;
+    if (length > size - offset) length = size - offset;
+
+    // madvise wants a page-aligned start
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = offset / page * page;
+    madvise((void*)(data + start), length + (offset - start), MADV_WILLNEED);
+}
+#endif
+
+bool MappedFile::Replace(const char* path, const void* bytes, size_t size, std::string& error)
+{
+    std::string temp = std::string(path) + ".tmp";
+    FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) {
+        error = temp + ": cannot write";
+        return false;
+    }
+    bool ok = std::fwrite(bytes, 1, size, file) == size;
+    ok = std::fclose(file) == 0 && ok;
+
+    std::error_code ec;
+    if (ok) std::filesystem::rename(temp, path, ec);
+    if (!ok || ec) {
+        std::filesystem::remove(temp, ec);
+        error = std::string(path) + ": cannot write";
+        return false;
+    }
+    return true;
+}
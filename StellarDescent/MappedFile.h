@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief A whole file mapped read-only into memory.
+ *
+ * The data is used in place: nothing is read until it is touched, so
+ * opening costs the same for any file size. The file may be replaced on
+ * disk (written elsewhere and renamed over) while it is mapped; the
+ * mapping keeps the old contents until Close().
+ *
+ * Deliberately free of raylib and platform headers (windows.h clashes
+ * with raylib), so anything can include it.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = static_cast<MappedFile&&>(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Map @p path, replacing any file mapped before. On failure the
+    /// MappedFile is left closed and @p error (if given) says why.
+    bool Open(const char* path, std::string* error = nullptr);
+
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+    /// Ask the OS to start reading [offset, offset + length) in ahead of
+    /// use. Only advice: the pages still fault in when touched either way.
+    void WillNeed(size_t offset, size_t length) const;
+
+    /// Write @p size bytes to a temporary file beside @p path and rename it
+    /// over @p path, so whoever maps or watches it never sees it half written.
+    static bool Replace(const char* path, const void* bytes, size_t size, std::string& error);
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
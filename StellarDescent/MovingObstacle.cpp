@@ -1,37 +1,10 @@
 #include "MovingObstacle.h"
-#include "raylib.h"
+#include "SimMath.h"
 #include <cmath>
 
 // -------------------- OBB COLLISION HELPERS --------------------
 namespace
 {
-    // Build 4 world-space vertices for a box with given center, half-extents and rotation.
-    // v[0] = top-left, v[1] = top-right, v[2] = bottom-right, v[3] = bottom-left
-    static void BuildBoxVertices(Vector2 center,
-        Vector2 half,
-        float rotDeg,
-        Vector2 out[4])
-    {
-        float rad = rotDeg * DEG2RAD;
-        float c = cosf(rad);
-        float s = sinf(rad);
-
-        Vector2 local[4] = {
-            { -half.x, -half.y },
-            {  half.x, -half.y },
-            {  half.x,  half.y },
-            { -half.x,  half.y }
-        };
-
-        for (int i = 0; i < 4; ++i) {
-            float x = local[i].x;
-            float y = local[i].y;
-
-            out[i].x = center.x + x * c - y * s;
-            out[i].y = center.y + x * s + y * c;
-        }
-    }
-
     inline Vector2 Sub(Vector2 a, Vector2 b) { return { a.x - b.x, a.y - b.y }; }
     inline float   Dot(Vector2 a, Vector2 b) { return a.x * b.x + a.y * b.y; }
 
@@ -97,53 +70,85 @@ MovingObstacle::MovingObstacle(Rectangle r,
     frequency(freq),
     phase(phaseOffset),
     rotation(0.0f),
-    angularVelocity(angVel)
+    angularVelocity(angVel),
+    startRotation(0.0f),
+    time(0.0),
+    prevCenter(basePos),
+    prevRotation(0.0f)
 {
-    // everything initialized in initializer list
+    // Start at the level-time-0 pose so the first step does not jump
+    SetTime(0.0);
+    prevCenter = { rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f };
+    prevRotation = rotation;
 }
 
-void MovingObstacle::Update(float dt)
+ObstaclePose MovingObstacle::PoseAt(float t) const
 {
+    ObstaclePose pose;
+
     // -------------------- ROTATION --------------------
-    rotation += angularVelocity * dt;
+    pose.rotation = startRotation + angularVelocity * t;
 
     // -------------------- POSITION (SINE MOTION) --------------------
-    float t = rotation * DEG2RAD * frequency + phase;
+    float arg = pose.rotation * DEG2RAD * frequency + phase;
 
     // Center starts at base position
-    Vector2 center = basePos;
+    pose.center = basePos;
 
     switch (pattern) {
     case ObstaclePattern::STATIC:
         break;
     case ObstaclePattern::HORIZONTAL:
-        center.x += std::sinf(t) * amplitude;
+        pose.center.x += SimMath::Sin(arg) * amplitude;
         break;
     case ObstaclePattern::VERTICAL:
-        center.y += std::sinf(t) * amplitude;
+        pose.center.y += SimMath::Sin(arg) * amplitude;
         break;
     }
+    return pose;
+}
+
+void MovingObstacle::SetTime(double t)
+{
+    // Remember the pose this step started from for render interpolation
+    prevCenter = { rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f };
+    prevRotation = rotation;
+
+    time = t;
+    ObstaclePose pose = PoseAt((float)t);
+    rotation = pose.rotation;
 
     // Keep rect synced: rect is always TOP-LEFT based on this center
-    rect.x = center.x - rect.width * 0.5f;
-    rect.y = center.y - rect.height * 0.5f;
+    rect.x = pose.center.x - rect.width * 0.5f;
+    rect.y = pose.center.y - rect.height * 0.5f;
 }
 
-void MovingObstacle::Draw() const
+void MovingObstacle::Update(float dt)
 {
-    // Compute center & half-extents directly from rect every frame
-    Vector2 center = { rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f };
-    Vector2 half = { rect.width * 0.5f, rect.height * 0.5f };
+    SetTime(time + dt);
+}
+
+void MovingObstacle::Translate(Vector2 delta)
+{
+    basePos.x += delta.x;
+    basePos.y += delta.y;
+    rect.x += delta.x;
+    rect.y += delta.y;
+    prevCenter.x += delta.x;
+    prevCenter.y += delta.y;
+}
 
-    // Build the 4 vertices used drawing and collision
-    Vector2 v[4];
-    BuildBoxVertices(center, half, rotation, v);
+void MovingObstacle::GetWorldVertices(float alpha, Vector2 out[4]) const
+{
+    // Interpolate center & rotation between the last two simulation ticks
+    Vector2 center = { rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f };
+    center.x = prevCenter.x + (center.x - prevCenter.x) * alpha;
+    center.y = prevCenter.y + (center.y - prevCenter.y) * alpha;
+    float drawRot = prevRotation + (rotation - prevRotation) * alpha;
 
+    Vector2 half = { rect.width * 0.5f, rect.height * 0.5f };
 
-    // -------------------- DEBUG OUTLINE (Currently only visible way) --------------------
-    for (int i = 0; i < 4; ++i) {
-        DrawLineV(v[i], v[(i + 1) % 4], RED);
-    }
+    SimMath::BuildBoxVertices(center, half, drawRot, out);
 }
 
 bool MovingObstacle::CheckCollisionOBB(Vector2 otherCenter,
@@ -155,17 +160,44 @@ bool MovingObstacle::CheckCollisionOBB(Vector2 otherCenter,
     Vector2 halfObs = { rect.width * 0.5f, rect.height * 0.5f };
 
     Vector2 vertsObstacle[4];
-    BuildBoxVertices(centerObs, halfObs, rotation, vertsObstacle);
+    SimMath::BuildBoxVertices(centerObs, halfObs, rotation, vertsObstacle);
 
     // Rocket OBB
     Vector2 vertsRocket[4];
-    BuildBoxVertices(otherCenter, otherHalfExtents, otherRotationDeg, vertsRocket);
+    SimMath::BuildBoxVertices(otherCenter, otherHalfExtents, otherRotationDeg, vertsRocket);
 
     return CheckOBBCollision(vertsObstacle, vertsRocket);
 }
 
-bool MovingObstacle::IsNear(const Rectangle& area) const
+Rectangle MovingObstacle::GetMotionBounds() const
+{
+    // Bounding circle covers every rotation; the sine moves the center at
+    // most |amplitude| along one axis
+    float radius = sqrtf(rect.width * rect.width + rect.height * rect.height) * 0.5f;
+    float reachX = radius;
+    float reachY = radius;
+
+    switch (pattern) {
+    case ObstaclePattern::STATIC:
+        break;
+    case ObstaclePattern::HORIZONTAL:
+        reachX += fabsf(amplitude);
+        break;
+    case ObstaclePattern::VERTICAL:
+        reachY += fabsf(amplitude);
+        break;
+    }
+
+    return { basePos.x - reachX, basePos.y - reachY, reachX * 2.0f, reachY * 2.0f };
+}
+
+BoxSweep MovingObstacle::GetSweep() const
 {
-    // Simple broad-phase AABB against camera/view rect
-    return CheckCollisionRecs(rect, area);
+    BoxSweep sweep;
+    sweep.half = { rect.width * 0.5f, rect.height * 0.5f };
+    sweep.startCenter = prevCenter;
+    sweep.endCenter = { rect.x + rect.width * 0.5f, rect.y + rect.height * 0.5f };
+    sweep.startRotation = prevRotation;
+    sweep.endRotation = rotation;
+    return sweep;
 }
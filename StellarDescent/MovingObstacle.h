@@ -1,5 +1,6 @@
 #pragma once
 #include "raylib.h"
+#include "SweptCollision.h"
 
 /**
  * @brief Types of motion an obstacle can follow.
@@ -10,9 +11,24 @@ enum class ObstaclePattern {
     VERTICAL
 };
 
+/**
+ * @brief Obstacle pose at one instant of level time.
+ */
+struct ObstaclePose {
+    Vector2 center;
+    float rotation;        // degrees
+};
+
 /**
  * @brief Moving/rotating obstacle used as debris or platforms.
  *
+ * Describes one obstacle for level generation and serves as the scalar
+ * reference for ObstacleField, which is what the simulation steps.
+ *
+ * The pose is a closed-form function of level time (PoseAt), not an
+ * integrated state: any instant can be evaluated directly, without
+ * stepping through the ones before it.
+ *
  * rect.x, rect.y are always the TOP-LEFT of the obstacle in world space.
  * basePos is the rest (un-offset) center used by the sine motion.
  */
@@ -29,6 +45,12 @@ public:
 
     float rotation;        // degrees
     float angularVelocity; // deg/sec
+    float startRotation;   // rotation at level time 0
+
+    double time;           // level time of the current pose (seconds)
+
+    Vector2 prevCenter;    // center at the start of the last Update (render interpolation)
+    float prevRotation;    // rotation at the start of the last Update
 
     MovingObstacle(Rectangle r,
         ObstaclePattern p,
@@ -37,14 +59,31 @@ public:
         float phaseOffset,
         float angVel);
 
+    /// Pose at level time @p t; pure, does not touch the current pose.
+    ObstaclePose PoseAt(float t) const;
+
+    /// Move to level time @p t; the old pose becomes the previous one.
+    void SetTime(double t);
+
+    /// SetTime(time + dt).
     void Update(float dt);
-    void Draw() const;
+
+    /// Move the obstacle (rest position and current pose) by @p delta.
+    void Translate(Vector2 delta);
+
+    // World-space corners for drawing, blended between the previous and
+    // current simulation tick by alpha (0..1). Order: TL, TR, BR, BL.
+    void GetWorldVertices(float alpha, Vector2 out[4]) const;
 
     // Pixel-perfect(ish) OBB vs OBB collision against the rocket.
     bool CheckCollisionOBB(Vector2 otherCenter,
         Vector2 otherHalfExtents,
         float otherRotationDeg) const;
 
-    // Broad-phase check against camera / view rectangle
-    bool IsNear(const Rectangle& area) const;
+    // World-space box covering every pose the obstacle can reach along its
+    // pattern (any rotation). Fixed for the obstacle's lifetime.
+    Rectangle GetMotionBounds() const;
+
+    // Motion over the last Update (prev pose -> current pose) for swept tests.
+    BoxSweep GetSweep() const;
 };
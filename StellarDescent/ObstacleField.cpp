@@ -0,0 +1,464 @@
+#include "ObstacleField.h"
+#include "ObstacleKernels.h"
+#include "OverlapKernels.h"
+#include "SimMath.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+    // Grouped obstacles are stored in Morton (Z) order of the cell their
+    // rest position falls in, so a region query touches a few contiguous
+    // runs of every array instead of scattered single entries.
+    constexpr float ORDER_CELL_SIZE = 256.0f;
+
+    uint32_t SpreadBits(uint32_t v)
+    {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        return (v | (v << 1)) & 0x55555555u;
+    }
+
+    uint32_t MortonKey(Vector2 p)
+    {
+        uint32_t cx = (uint32_t)(int32_t)floorf(p.x / ORDER_CELL_SIZE);
+        uint32_t cy = (uint32_t)(int32_t)floorf(p.y / ORDER_CELL_SIZE);
+        return SpreadBits(cx) | (SpreadBits(cy) << 1);
+    }
+}
+
+void ObstacleField::Clear()
+{
+    for (auto* v : { &halfW, &halfH, &baseX, &baseY, &amplitude, &frequency, &phase,
+        &angularVelocity, &startRotation, &centerX, &centerY, &rotation,
+        &prevCenterX, &prevCenterY, &prevRotation, &axisCos, &axisSin, &prevAxisCos, &prevAxisSin }) {
+        v->clear();
+    }
+    sourceIndex.clear();
+    poseStamps.clear();
+    for (int& g : groupBegin) g = 0;
+    time = prevTime = 0.0;
+    allPosed = prevAllPosed = true;
+    poseStamp = 0;
+    layoutHash = 0;
+}
+
+void ObstacleField::Assign(const std::vector<MovingObstacle>& descriptors, double levelTime)
+{
+    Clear();
+
+    // -------------------- GROUP BY PATTERN, THEN BY PLACE --------------------
+    // Stable: obstacles sharing a cell keep their relative order
+    std::vector<std::pair<uint32_t, int>> order;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        groupBegin[p] = (int)halfW.size();
+
+        order.clear();
+        for (int d = 0; d < (int)descriptors.size(); ++d) {
+            if ((int)descriptors[d].pattern == p) order.push_back({ MortonKey(descriptors[d].basePos), d });
+        }
+        std::stable_sort(order.begin(), order.end(),
+            [](const std::pair<uint32_t, int>& a, const std::pair<uint32_t, int>& b) { return a.first < b.first; });
+
+        for (const auto& entry : order) {
+            const MovingObstacle& o = descriptors[entry.second];
+            sourceIndex.push_back(entry.second);
+
+            halfW.push_back(o.rect.width * 0.5f);
+            halfH.push_back(o.rect.height * 0.5f);
+            baseX.push_back(o.basePos.x);
+            baseY.push_back(o.basePos.y);
+            amplitude.push_back(o.amplitude);
+            frequency.push_back(o.frequency);
+            phase.push_back(o.phase);
+            angularVelocity.push_back(o.angularVelocity);
+            startRotation.push_back(o.startRotation);
+        }
+    }
+    groupBegin[PATTERN_COUNT] = (int)halfW.size();
+
+    StateHash hash;
+    for (int g : groupBegin) hash.Add(g);
+    for (const auto* v : { &halfW, &halfH, &baseX, &baseY, &amplitude, &frequency, &phase,
+        &angularVelocity, &startRotation }) {
+        hash.Add(v->data(), v->size());
+    }
+    layoutHash = hash.Get();
+
+    // -------------------- INITIAL POSE --------------------
+    // Posed straight at levelTime; nothing moved yet, so prev == current.
+    // Static centers are never written by the kernels: they stay at base.
+    int n = (int)halfW.size();
+    rotation.resize(n);
+    axisCos.resize(n);
+    axisSin.resize(n);
+    centerX = baseX;
+    centerY = baseY;
+    PoseInto(ObstacleKernels::Pose, ObstacleKernels::Axes, (float)levelTime,
+        rotation.data(), centerX.data(), centerY.data(), axisCos.data(), axisSin.data());
+
+    prevCenterX = centerX;
+    prevCenterY = centerY;
+    prevRotation = rotation;
+    prevAxisCos = axisCos;
+    prevAxisSin = axisSin;
+
+    time = prevTime = levelTime;
+    allPosed = prevAllPosed = true;
+    poseStamps.assign(n, 0u);
+    poseStamp = 0;
+}
+
+template <typename Kernel, typename AxesKernel>
+void ObstacleField::PoseInto(Kernel pose, AxesKernel axes, float t,
+    float* rot, float* cx, float* cy, float* cosOut, float* sinOut) const
+{
+    // -------------------- PER-GROUP KERNELS --------------------
+    // Static obstacles only spin; the others move along one axis each
+    int b = groupBegin[(int)ObstaclePattern::STATIC];
+    int n = GetGroupCount(ObstaclePattern::STATIC);
+    pose(startRotation.data() + b, angularVelocity.data() + b, frequency.data() + b,
+        phase.data() + b, amplitude.data() + b, nullptr, rot + b, nullptr, n, t);
+
+    b = groupBegin[(int)ObstaclePattern::HORIZONTAL];
+    n = GetGroupCount(ObstaclePattern::HORIZONTAL);
+    pose(startRotation.data() + b, angularVelocity.data() + b, frequency.data() + b,
+        phase.data() + b, amplitude.data() + b, baseX.data() + b, rot + b, cx + b, n, t);
+
+    b = groupBegin[(int)ObstaclePattern::VERTICAL];
+    n = GetGroupCount(ObstaclePattern::VERTICAL);
+    pose(startRotation.data() + b, angularVelocity.data() + b, frequency.data() + b,
+        phase.data() + b, amplitude.data() + b, baseY.data() + b, rot + b, cy + b, n, t);
+
+    // -------------------- AXIS CACHE --------------------
+    // The only trig per obstacle per step
+    axes(rot, cosOut, sinOut, Size());
+}
+
+template <typename Kernel, typename AxesKernel>
+void ObstacleField::PoseWith(Kernel pose, AxesKernel axes, double t)
+{
+    // Remember the pose this step started from (render interpolation,
+    // sweeps). After deferred steps some current poses are stale, so the
+    // start pose is evaluated afresh instead of copied.
+    if (allPosed) {
+        prevCenterX = centerX;
+        prevCenterY = centerY;
+        prevRotation = rotation;
+        prevAxisCos.swap(axisCos);
+        prevAxisSin.swap(axisSin);
+    }
+    else {
+        PoseInto(pose, axes, (float)time, prevRotation.data(), prevCenterX.data(), prevCenterY.data(),
+            prevAxisCos.data(), prevAxisSin.data());
+    }
+
+    prevTime = time;
+    time = t;
+    PoseInto(pose, axes, (float)t, rotation.data(), centerX.data(), centerY.data(),
+        axisCos.data(), axisSin.data());
+    allPosed = true;
+}
+
+// -------------------- SNAPSHOTS --------------------
+void ObstacleField::CopyPosesTo(float* out) const
+{
+    size_t n = (size_t)Size();
+    for (const auto* v : { &centerX, &centerY, &rotation, &prevCenterX, &prevCenterY, &prevRotation,
+        &axisCos, &axisSin, &prevAxisCos, &prevAxisSin }) {
+        if (n) memcpy(out, v->data(), n * sizeof(float));
+        out += n;
+    }
+}
+
+void ObstacleField::CopyPosesFrom(const float* in, double t)
+{
+    size_t n = (size_t)Size();
+    for (auto* v : { &centerX, &centerY, &rotation, &prevCenterX, &prevCenterY, &prevRotation,
+        &axisCos, &axisSin, &prevAxisCos, &prevAxisSin }) {
+        if (n) memcpy(v->data(), in, n * sizeof(float));
+        in += n;
+    }
+    time = prevTime = t;
+    allPosed = prevAllPosed = true;
+}
+
+void ObstacleField::SetTime(double t)
+{
+    PoseWith(ObstacleKernels::Pose, ObstacleKernels::Axes, t);
+}
+
+void ObstacleField::Update(float dt)
+{
+    SetTime(time + dt);
+}
+
+void ObstacleField::UpdateScalar(float dt)
+{
+    PoseWith(ObstacleKernels::PoseScalar, ObstacleKernels::AxesScalar, time + dt);
+}
+
+void ObstacleField::SetTimeDeferred(double t)
+{
+    prevTime = time;
+    time = t;
+    prevAllPosed = allPosed;
+    allPosed = false;
+
+    // New stamp per step; on wrap-around clear the old marks (skipping
+    // 1 so nothing looks posed at the step before)
+    if (++poseStamp == 0) {
+        std::fill(poseStamps.begin(), poseStamps.end(), 0u);
+        poseStamp = 2;
+    }
+}
+
+bool ObstacleField::PosedLastStep(int i) const
+{
+    return prevAllPosed || poseStamps[i] + 1 == poseStamp;
+}
+
+void ObstacleField::CarryPose(int i)
+{
+    // Its current pose is the one at prevTime: reuse it as the start pose
+    prevCenterX[i] = centerX[i];
+    prevCenterY[i] = centerY[i];
+    prevRotation[i] = rotation[i];
+    prevAxisCos[i] = axisCos[i];
+    prevAxisSin[i] = axisSin[i];
+}
+
+bool ObstacleField::Sync(int i)
+{
+    if (allPosed || poseStamps[i] == poseStamp) return false;
+
+    // Scalar twins of the kernels: same bits as a full SetTime() would give
+    if (PosedLastStep(i)) {
+        CarryPose(i);
+    }
+    else {
+        ObstaclePose from = PoseAt(i, (float)prevTime);
+        prevCenterX[i] = from.center.x;
+        prevCenterY[i] = from.center.y;
+        prevRotation[i] = from.rotation;
+
+        float rad = from.rotation * DEG2RAD;
+        prevAxisCos[i] = SimMath::Cos(rad);
+        prevAxisSin[i] = SimMath::Sin(rad);
+    }
+    poseStamps[i] = poseStamp;
+
+    ObstaclePose to = PoseAt(i, (float)time);
+    centerX[i] = to.center.x;
+    centerY[i] = to.center.y;
+    rotation[i] = to.rotation;
+
+    float rad = to.rotation * DEG2RAD;
+    axisCos[i] = SimMath::Cos(rad);
+    axisSin[i] = SimMath::Sin(rad);
+    return true;
+}
+
+int ObstacleField::SyncMany(const int* ids, int count)
+{
+    if (allPosed) return 0;
+
+    // -------------------- GATHER STALE IDS BY PATTERN --------------------
+    // Obstacles that need their start pose too go first in each list;
+    // those posed last step carry their pose over and follow
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        scratch.ids[p].clear();
+        scratch.carried[p].clear();
+    }
+    for (int k = 0; k < count; ++k) {
+        int i = ids[k];
+        if (poseStamps[i] == poseStamp) continue;
+
+        int p = (int)GetPattern(i);
+        if (PosedLastStep(i)) {
+            CarryPose(i);
+            scratch.carried[p].push_back(i);
+        }
+        else {
+            scratch.ids[p].push_back(i);
+        }
+        poseStamps[i] = poseStamp;
+    }
+
+    int posed = 0;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        std::vector<int>& list = scratch.ids[p];
+        int waking = (int)list.size();
+        list.insert(list.end(), scratch.carried[p].begin(), scratch.carried[p].end());
+
+        int n = (int)list.size();
+        if (n == 0) continue;
+        posed += n;
+
+        ObstaclePattern pattern = (ObstaclePattern)p;
+        const std::vector<float>& base = pattern == ObstaclePattern::VERTICAL ? baseY : baseX;
+
+        for (auto* v : { &scratch.startRotation, &scratch.angularVelocity, &scratch.frequency,
+            &scratch.phase, &scratch.amplitude, &scratch.base, &scratch.rotation, &scratch.center,
+            &scratch.axisCos, &scratch.axisSin }) {
+            v->resize(n);
+        }
+        for (int k = 0; k < n; ++k) {
+            int i = list[k];
+            scratch.startRotation[k] = startRotation[i];
+            scratch.angularVelocity[k] = angularVelocity[i];
+            scratch.frequency[k] = frequency[i];
+            scratch.phase[k] = phase[i];
+            scratch.amplitude[k] = amplitude[i];
+            scratch.base[k] = base[i];
+        }
+
+        // -------------------- POSE, SCATTER --------------------
+        // End of the step for all, start of the step for the waking prefix
+        bool moves = pattern != ObstaclePattern::STATIC;
+        std::vector<float>& prevCenter = pattern == ObstaclePattern::VERTICAL ? prevCenterY : prevCenterX;
+        std::vector<float>& currCenter = pattern == ObstaclePattern::VERTICAL ? centerY : centerX;
+
+        for (int end = 1; end >= 0; --end) {
+            int m = end == 1 ? n : waking;
+            if (m == 0) continue;
+
+            float t = (float)(end == 1 ? time : prevTime);
+            ObstacleKernels::Pose(scratch.startRotation.data(), scratch.angularVelocity.data(),
+                scratch.frequency.data(), scratch.phase.data(), scratch.amplitude.data(),
+                moves ? scratch.base.data() : nullptr, scratch.rotation.data(),
+                moves ? scratch.center.data() : nullptr, m, t);
+            ObstacleKernels::Axes(scratch.rotation.data(), scratch.axisCos.data(), scratch.axisSin.data(), m);
+
+            std::vector<float>& rot = end == 1 ? rotation : prevRotation;
+            std::vector<float>& center = end == 1 ? currCenter : prevCenter;
+            std::vector<float>& cosOut = end == 1 ? axisCos : prevAxisCos;
+            std::vector<float>& sinOut = end == 1 ? axisSin : prevAxisSin;
+            for (int k = 0; k < m; ++k) {
+                int i = list[k];
+                rot[i] = scratch.rotation[k];
+                cosOut[i] = scratch.axisCos[k];
+                sinOut[i] = scratch.axisSin[k];
+                if (moves) center[i] = scratch.center[k];
+            }
+        }
+    }
+    return posed;
+}
+
+bool ObstacleField::IsPosed(int i) const
+{
+    return allPosed || poseStamps[i] == poseStamp;
+}
+
+ObstaclePattern ObstacleField::GetPattern(int i) const
+{
+    if (i < groupBegin[(int)ObstaclePattern::HORIZONTAL]) return ObstaclePattern::STATIC;
+    if (i < groupBegin[(int)ObstaclePattern::VERTICAL]) return ObstaclePattern::HORIZONTAL;
+    return ObstaclePattern::VERTICAL;
+}
+
+ObstaclePose ObstacleField::PoseAt(int i, float t) const
+{
+    // Same operations as ObstacleKernels::PoseRange, one obstacle
+    ObstaclePose pose;
+    pose.rotation = startRotation[i] + angularVelocity[i] * t;
+    pose.center = { baseX[i], baseY[i] };
+
+    ObstaclePattern pattern = GetPattern(i);
+    if (pattern == ObstaclePattern::STATIC) return pose;
+
+    float arg = pose.rotation * DEG2RAD * frequency[i] + phase[i];
+    float offset = SimMath::Sin(arg) * amplitude[i];
+    if (pattern == ObstaclePattern::HORIZONTAL) pose.center.x = baseX[i] + offset;
+    else pose.center.y = baseY[i] + offset;
+    return pose;
+}
+
+void ObstacleField::GetBoxAt(int i, float t, SimMath::OrientedBox& out) const
+{
+    ObstaclePose pose = PoseAt(i, t);
+    SimMath::BuildOrientedBox(pose.center, { halfW[i], halfH[i] }, pose.rotation, out);
+}
+
+BoxSweep ObstacleField::GetSweepBetween(int i, float t0, float t1) const
+{
+    ObstaclePose from = PoseAt(i, t0);
+    ObstaclePose to = PoseAt(i, t1);
+
+    BoxSweep sweep;
+    sweep.half = { halfW[i], halfH[i] };
+    sweep.startCenter = from.center;
+    sweep.endCenter = to.center;
+    sweep.startRotation = from.rotation;
+    sweep.endRotation = to.rotation;
+    return sweep;
+}
+
+Rectangle ObstacleField::GetMotionBounds(int i) const
+{
+    // Bounding circle covers every rotation; the sine moves the center at
+    // most |amplitude| along the group's axis
+    float radius = sqrtf(halfW[i] * halfW[i] + halfH[i] * halfH[i]);
+    float reachX = radius;
+    float reachY = radius;
+
+    switch (GetPattern(i)) {
+    case ObstaclePattern::STATIC:
+        break;
+    case ObstaclePattern::HORIZONTAL:
+        reachX += fabsf(amplitude[i]);
+        break;
+    case ObstaclePattern::VERTICAL:
+        reachY += fabsf(amplitude[i]);
+        break;
+    }
+
+    return { baseX[i] - reachX, baseY[i] - reachY, reachX * 2.0f, reachY * 2.0f };
+}
+
+BoxSweep ObstacleField::GetSweep(int i) const
+{
+    BoxSweep sweep;
+    sweep.half = { halfW[i], halfH[i] };
+    sweep.startCenter = { prevCenterX[i], prevCenterY[i] };
+    sweep.endCenter = { centerX[i], centerY[i] };
+    sweep.startRotation = prevRotation[i];
+    sweep.endRotation = rotation[i];
+    return sweep;
+}
+
+void ObstacleField::GetBox(int i, SimMath::OrientedBox& out) const
+{
+    SimMath::BuildOrientedBox({ centerX[i], centerY[i] }, { halfW[i], halfH[i] },
+        axisCos[i], axisSin[i], out);
+}
+
+void ObstacleField::GetPrevBox(int i, SimMath::OrientedBox& out) const
+{
+    SimMath::BuildOrientedBox({ prevCenterX[i], prevCenterY[i] }, { halfW[i], halfH[i] },
+        prevAxisCos[i], prevAxisSin[i], out);
+}
+
+int ObstacleField::Overlaps(const SimMath::OrientedBox& box, uint32_t* hitMask) const
+{
+    return OverlapKernels::Overlaps(box, centerX.data(), centerY.data(), halfW.data(), halfH.data(),
+        axisCos.data(), axisSin.data(), Size(), hitMask);
+}
+
+void ObstacleField::GetWorldVertices(int i, float alpha, Vector2 out[4]) const
+{
+    SimMath::OrientedBox prev, curr;
+    GetPrevBox(i, prev);
+    GetBox(i, curr);
+
+    for (int v = 0; v < 4; ++v) {
+        out[v].x = prev.verts[v].x + (curr.verts[v].x - prev.verts[v].x) * alpha;
+        out[v].y = prev.verts[v].y + (curr.verts[v].y - prev.verts[v].y) * alpha;
+    }
+}
@@ -0,0 +1,219 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+#include "MovingObstacle.h"
+#include "SimMath.h"
+#include "SweptCollision.h"
+
+/**
+ * @brief All obstacles of a level in structure-of-arrays form.
+ *
+ * MovingObstacle stays the descriptor (and scalar reference); Assign()
+ * copies a list of them into one array per field, grouped by pattern
+ * (static, horizontal, vertical), so Update() can run each group through
+ * ObstacleKernels in SIMD batches with no per-obstacle branching. Large
+ * counts (asteroid-belt levels) stay cheap to move.
+ *
+ * Poses are a closed-form function of level time (see ObstacleKernels):
+ * SetTime() jumps straight to any instant, and PoseAt()/GetBoxAt()/
+ * GetSweepBetween() evaluate a single obstacle at any other time without
+ * touching the field, for lookahead and lazily evaluated obstacles.
+ *
+ * Each pose update also caches the cosine/sine of every rotation (the box axes) for
+ * the new pose and keeps the previous step's, so collision, drawing and
+ * spatial queries pose boxes without any trig of their own.
+ *
+ * Obstacles are addressed by index 0..Size()-1: grouped by pattern and,
+ * inside a group, in Morton order of their rest position, so obstacles
+ * that are close in the world are close in memory. GetSourceIndex() maps
+ * back to the descriptors passed to Assign().
+ */
+class ObstacleField {
+public:
+    /// Replace the field with these obstacles, posed at @p levelTime.
+    void Assign(const std::vector<MovingObstacle>& descriptors, double levelTime = 0.0);
+
+    void Clear();
+
+    int Size() const { return (int)centerX.size(); }
+    bool Empty() const { return centerX.empty(); }
+
+    /// Pose every obstacle at level time @p t (fastest SIMD path); the
+    /// old poses become the previous ones.
+    void SetTime(double t);
+
+    /// SetTime(GetTime() + dt): one simulation step.
+    void Update(float dt);
+
+    /// Same as Update() through the scalar kernels (reference / benchmarks).
+    void UpdateScalar(float dt);
+
+    /// Level time of the current poses.
+    double GetTime() const { return time; }
+
+    /// Hash of the obstacle descriptors (fixed from Assign() on). With the
+    /// level time it pins down every pose, see Simulation::GetStateHash().
+    uint64_t GetLayoutHash() const { return layoutHash; }
+
+    // -------------------- SNAPSHOTS --------------------
+    /// Pose arrays in a snapshot: center, rotation and axes, current and previous.
+    static constexpr int POSE_ARRAYS = 10;
+
+    /// Floats CopyPosesTo() writes.
+    size_t GetPoseFloats() const { return (size_t)Size() * POSE_ARRAYS; }
+
+    /// Copy every pose (all posed at GetTime()) into one flat block.
+    void CopyPosesTo(float* out) const;
+
+    /**
+     * @brief Put back poses from CopyPosesTo() with the clock at @p t.
+     *
+     * The layout must be the one they were copied from. Plain copies: no
+     * posing, no allocation.
+     */
+    void CopyPosesFrom(const float* in, double t);
+
+    // -------------------- DEFERRED POSING --------------------
+    /**
+     * @brief Move the level clock to @p t without posing anything.
+     *
+     * Poses (current and previous) go stale until Sync() brings an
+     * obstacle up to date. ActivityRegions uses this to pose only the
+     * obstacles near the rocket and the camera.
+     */
+    void SetTimeDeferred(double t);
+
+    /**
+     * @brief Pose obstacle @p i for the current step if it is stale.
+     *
+     * The result is bit-identical to a full SetTime(), so deferred
+     * stepping never changes gameplay. Cheap when already posed.
+     *
+     * @return true if the obstacle had to be posed.
+     */
+    bool Sync(int i);
+
+    /**
+     * @brief Sync() a list of obstacles through the SIMD kernels.
+     *
+     * Stale obstacles are gathered per pattern, posed in batches and
+     * scattered back; same bits as Sync() on each.
+     *
+     * @return Number of obstacles that had to be posed.
+     */
+    int SyncMany(const int* ids, int count);
+
+    /// True when obstacle @p i holds this step's pose.
+    bool IsPosed(int i) const;
+
+    // -------------------- PER-OBSTACLE VIEWS --------------------
+    ObstaclePattern GetPattern(int i) const;
+
+    /// Position of obstacle @p i in the descriptor list given to Assign().
+    int GetSourceIndex(int i) const { return sourceIndex[i]; }
+
+    Vector2 GetCenter(int i) const { return { centerX[i], centerY[i] }; }
+    Vector2 GetHalfExtents(int i) const { return { halfW[i], halfH[i] }; }
+    float GetRotation(int i) const { return rotation[i]; }
+
+    /// Pose of obstacle @p i at level time @p t, bit-identical to what
+    /// SetTime(t) would store. Does not modify the field.
+    ObstaclePose PoseAt(int i, float t) const;
+
+    /// Box of obstacle @p i at level time @p t (evaluates its own trig).
+    void GetBoxAt(int i, float t, SimMath::OrientedBox& out) const;
+
+    /// Motion of obstacle @p i from level time @p t0 to @p t1, for
+    /// predictive swept tests.
+    BoxSweep GetSweepBetween(int i, float t0, float t1) const;
+
+    /// Same as MovingObstacle::GetMotionBounds.
+    Rectangle GetMotionBounds(int i) const;
+
+    /// Same as MovingObstacle::GetSweep.
+    BoxSweep GetSweep(int i) const;
+
+    /// Box at the end of the last Update (cached axes, no trig).
+    void GetBox(int i, SimMath::OrientedBox& out) const;
+
+    /// Box at the start of the last Update.
+    void GetPrevBox(int i, SimMath::OrientedBox& out) const;
+
+    /**
+     * @brief Batched discrete overlap of @p box against every obstacle's
+     * current pose (OverlapKernels, fastest path).
+     *
+     * @param hitMask OverlapKernels::MaskWords(Size()) words; bit i is set
+     *        when obstacle i overlaps.
+     * @return Number of overlapping obstacles.
+     */
+    int Overlaps(const SimMath::OrientedBox& box, uint32_t* hitMask) const;
+
+    /**
+     * @brief Corners for drawing, blended between the previous and current
+     * tick by alpha (0..1). Order: TL, TR, BR, BL.
+     *
+     * Blends the cached corners rather than re-posing at an in-between
+     * angle; per-tick rotation is a degree or two, so the difference is
+     * sub-pixel.
+     */
+    void GetWorldVertices(int i, float alpha, Vector2 out[4]) const;
+
+    /// First index and count of a pattern group.
+    int GetGroupBegin(ObstaclePattern p) const { return groupBegin[(int)p]; }
+    int GetGroupCount(ObstaclePattern p) const { return groupBegin[(int)p + 1] - groupBegin[(int)p]; }
+
+private:
+    static constexpr int PATTERN_COUNT = 3;
+
+    // Shape and motion parameters
+    std::vector<float> halfW, halfH;
+    std::vector<float> baseX, baseY;
+    std::vector<float> amplitude, frequency, phase;
+    std::vector<float> angularVelocity, startRotation;
+    std::vector<int> sourceIndex;
+
+    // Pose: current and at the start of the last Update
+    std::vector<float> centerX, centerY, rotation;
+    std::vector<float> prevCenterX, prevCenterY, prevRotation;
+
+    // Cached cos/sin of rotation (box axes), current and previous pose
+    std::vector<float> axisCos, axisSin;
+    std::vector<float> prevAxisCos, prevAxisSin;
+
+    int groupBegin[PATTERN_COUNT + 1] = {};
+
+    // Level clock: current and previous step
+    double time = 0.0;
+    double prevTime = 0.0;
+
+    // Deferred posing: every pose is current when allPosed, otherwise
+    // only those stamped with this step's poseStamp
+    bool allPosed = true;
+    bool prevAllPosed = true;
+    std::vector<uint32_t> poseStamps;
+    uint32_t poseStamp = 0;
+
+    uint64_t layoutHash = 0;
+
+    // SyncMany() gather buffers, reused between calls
+    struct SyncScratch {
+        std::vector<int> ids[PATTERN_COUNT];
+        std::vector<int> carried[PATTERN_COUNT];
+        std::vector<float> startRotation, angularVelocity, frequency, phase, amplitude, base;
+        std::vector<float> rotation, center, axisCos, axisSin;
+    };
+    SyncScratch scratch;
+
+    bool PosedLastStep(int i) const;
+    void CarryPose(int i);
+
+    template <typename Kernel, typename AxesKernel>
+    void PoseInto(Kernel pose, AxesKernel axes, float t,
+        float* rot, float* cx, float* cy, float* cosOut, float* sinOut) const;
+
+    template <typename Kernel, typename AxesKernel>
+    void PoseWith(Kernel pose, AxesKernel axes, double t);
+};
@@ -0,0 +1,314 @@
+#include "ObstacleKernels.h"
+#include "SimMath.h"
+
+#if SD_X86
+#include <immintrin.h>
+#endif
+
+// -------------------- SHARED HELPERS --------------------
+namespace
+{
+    // Scalar evaluation for [begin, count); also used for the SIMD tails.
+    // Keep the operation order identical to the SIMD lanes.
+    void PoseRange(const float* startRotation, const float* angularVelocity,
+        const float* frequency, const float* phase, const float* amplitude,
+        const float* base, float* rotation, float* center, int begin, int count, float t)
+    {
+        for (int i = begin; i < count; ++i) {
+            rotation[i] = startRotation[i] + angularVelocity[i] * t;
+        }
+        if (!center) return;
+
+        for (int i = begin; i < count; ++i) {
+            float arg = rotation[i] * DEG2RAD * frequency[i] + phase[i];
+            center[i] = base[i] + SimMath::Sin(arg) * amplitude[i];
+        }
+    }
+}
+
+// -------------------- SCALAR REFERENCE --------------------
+void ObstacleKernels::PoseScalar(const float* startRotation, const float* angularVelocity,
+    const float* frequency, const float* phase, const float* amplitude,
+    const float* base, float* rotation, float* center, int count, float t)
+{
+    PoseRange(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, 0, count, t);
+}
+
+// -------------------- SSE2 (4 LANES) --------------------
+#if SD_X86
+namespace
+{
+    // SimMath::SinConst::SinPoly, 4 lanes
+    inline __m128 SinPoly4(__m128 r)
+    {
+        using namespace SimMath::SinConst;
+
+        __m128 r2 = _mm_mul_ps(r, r);
+        __m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(C11), r2), _mm_set1_ps(C9));
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(C7));
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(C5));
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(C3));
+        return _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), p));
+    }
+
+    inline __m128 ReducePi4(__m128 x, __m128 kf)
+    {
+        using namespace SimMath::SinConst;
+
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, _mm_set1_ps(PI_A)));
+        r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(PI_B)));
+        return _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(PI_C)));
+    }
+
+    // SimMath::Sin, 4 lanes
+    inline __m128 Sin4(__m128 x)
+    {
+        __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(SimMath::SinConst::INV_PI)));
+        __m128 s = SinPoly4(ReducePi4(x, _mm_cvtepi32_ps(k)));
+
+        // Odd k flips the sign bit
+        __m128i sign = _mm_slli_epi32(_mm_and_si128(k, _mm_set1_epi32(1)), 31);
+        return _mm_xor_ps(s, _mm_castsi128_ps(sign));
+    }
+
+    // SimMath::Cos, 4 lanes
+    inline __m128 Cos4(__m128 x)
+    {
+        __m128 half = _mm_set1_ps(0.5f);
+        __m128i k = _mm_cvtps_epi32(_mm_sub_ps(_mm_mul_ps(x, _mm_set1_ps(SimMath::SinConst::INV_PI)), half));
+        __m128 s = SinPoly4(ReducePi4(x, _mm_add_ps(_mm_cvtepi32_ps(k), half)));
+
+        // Even k flips the sign bit
+        __m128i sign = _mm_slli_epi32(_mm_andnot_si128(k, _mm_set1_epi32(1)), 31);
+        return _mm_xor_ps(s, _mm_castsi128_ps(sign));
+    }
+}
+#endif
+
+void ObstacleKernels::PoseSSE2(const float* startRotation, const float* angularVelocity,
+    const float* frequency, const float* phase, const float* amplitude,
+    const float* base, float* rotation, float* center, int count, float t)
+{
+#if SD_X86
+    const __m128 vt = _mm_set1_ps(t);
+    const __m128 deg2rad = _mm_set1_ps(DEG2RAD);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 rot = _mm_add_ps(_mm_loadu_ps(startRotation + i),
+            _mm_mul_ps(_mm_loadu_ps(angularVelocity + i), vt));
+        _mm_storeu_ps(rotation + i, rot);
+
+        if (!center) continue;
+
+        __m128 arg = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(rot, deg2rad), _mm_loadu_ps(frequency + i)),
+            _mm_loadu_ps(phase + i));
+        __m128 c = _mm_add_ps(_mm_loadu_ps(base + i),
+            _mm_mul_ps(Sin4(arg), _mm_loadu_ps(amplitude + i)));
+        _mm_storeu_ps(center + i, c);
+    }
+
+    PoseRange(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, i, count, t);
+#else
+    PoseScalar(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, count, t);
+#endif
+}
+
+// -------------------- AVX2 (8 LANES) --------------------
+#if SD_X86
+SD_TARGET_AVX2
+static inline __m256 SinPoly8(__m256 r)
+{
+    using namespace SimMath::SinConst;
+
+    __m256 r2 = _mm256_mul_ps(r, r);
+    __m256 p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C11), r2), _mm256_set1_ps(C9));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r2), _mm256_set1_ps(C7));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r2), _mm256_set1_ps(C5));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r2), _mm256_set1_ps(C3));
+    return _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), p));
+}
+
+SD_TARGET_AVX2
+static inline __m256 ReducePi8(__m256 x, __m256 kf)
+{
+    using namespace SimMath::SinConst;
+
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(kf, _mm256_set1_ps(PI_A)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(kf, _mm256_set1_ps(PI_B)));
+    return _mm256_sub_ps(r, _mm256_mul_ps(kf, _mm256_set1_ps(PI_C)));
+}
+
+SD_TARGET_AVX2
+static inline __m256 Sin8(__m256 x)
+{
+    __m256i k = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(SimMath::SinConst::INV_PI)));
+    __m256 s = SinPoly8(ReducePi8(x, _mm256_cvtepi32_ps(k)));
+
+    __m256i sign = _mm256_slli_epi32(_mm256_and_si256(k, _mm256_set1_epi32(1)), 31);
+    return _mm256_xor_ps(s, _mm256_castsi256_ps(sign));
+}
+
+SD_TARGET_AVX2
+static inline __m256 Cos8(__m256 x)
+{
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256i k = _mm256_cvtps_epi32(_mm256_sub_ps(_mm256_mul_ps(x, _mm256_set1_ps(SimMath::SinConst::INV_PI)), half));
+    __m256 s = SinPoly8(ReducePi8(x, _mm256_add_ps(_mm256_cvtepi32_ps(k), half)));
+
+    __m256i sign = _mm256_slli_epi32(_mm256_andnot_si256(k, _mm256_set1_epi32(1)), 31);
+    return _mm256_xor_ps(s, _mm256_castsi256_ps(sign));
+}
+
+SD_TARGET_AVX2
+static void PoseAVX2Body(const float* startRotation, const float* angularVelocity,
+    const float* frequency, const float* phase, const float* amplitude,
+    const float* base, float* rotation, float* center, int count, float t)
+{
+    const __m256 vt = _mm256_set1_ps(t);
+    const __m256 deg2rad = _mm256_set1_ps(DEG2RAD);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 rot = _mm256_add_ps(_mm256_loadu_ps(startRotation + i),
+            _mm256_mul_ps(_mm256_loadu_ps(angularVelocity + i), vt));
+        _mm256_storeu_ps(rotation + i, rot);
+
+        if (!center) continue;
+
+        __m256 arg = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(rot, deg2rad), _mm256_loadu_ps(frequency + i)),
+            _mm256_loadu_ps(phase + i));
+        __m256 c = _mm256_add_ps(_mm256_loadu_ps(base + i),
+            _mm256_mul_ps(Sin8(arg), _mm256_loadu_ps(amplitude + i)));
+        _mm256_storeu_ps(center + i, c);
+    }
+    _mm256_zeroupper();
+
+    PoseRange(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, i, count, t);
+}
+#endif
+
+void ObstacleKernels::PoseAVX2(const float* startRotation, const float* angularVelocity,
+    const float* frequency, const float* phase, const float* amplitude,
+    const float* base, float* rotation, float* center, int count, float t)
+{
+#if SD_X86
+    PoseAVX2Body(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, count, t);
+#else
+    PoseScalar(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, count, t);
+#endif
+}
+
+// -------------------- AXES (COS / SIN) --------------------
+void ObstacleKernels::AxesScalar(const float* rotation, float* cosOut, float* sinOut, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        float rad = rotation[i] * DEG2RAD;
+        cosOut[i] = SimMath::Cos(rad);
+        sinOut[i] = SimMath::Sin(rad);
+    }
+}
+
+void ObstacleKernels::AxesSSE2(const float* rotation, float* cosOut, float* sinOut, int count)
+{
+#if SD_X86
+    const __m128 deg2rad = _mm_set1_ps(DEG2RAD);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 rad = _mm_mul_ps(_mm_loadu_ps(rotation + i), deg2rad);
+        _mm_storeu_ps(cosOut + i, Cos4(rad));
+        _mm_storeu_ps(sinOut + i, Sin4(rad));
+    }
+
+    // Tail through one padded block: levels often hold fewer obstacles
+    // than a register has lanes, and scalar trig would dominate
+    int rest = count - i;
+    if (rest > 0) {
+        alignas(16) float r[4] = {}, c[4], sn[4];
+        for (int k = 0; k < rest; ++k) r[k] = rotation[i + k];
+
+        __m128 rad = _mm_mul_ps(_mm_load_ps(r), deg2rad);
+        _mm_store_ps(c, Cos4(rad));
+        _mm_store_ps(sn, Sin4(rad));
+        for (int k = 0; k < rest; ++k) {
+            cosOut[i + k] = c[k];
+            sinOut[i + k] = sn[k];
+        }
+    }
+#else
+    AxesScalar(rotation, cosOut, sinOut, count);
+#endif
+}
+
+#if SD_X86
+SD_TARGET_AVX2
+static void AxesAVX2Body(const float* rotation, float* cosOut, float* sinOut, int count)
+{
+    const __m256 deg2rad = _mm256_set1_ps(DEG2RAD);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 rad = _mm256_mul_ps(_mm256_loadu_ps(rotation + i), deg2rad);
+        _mm256_storeu_ps(cosOut + i, Cos8(rad));
+        _mm256_storeu_ps(sinOut + i, Sin8(rad));
+    }
+
+    int rest = count - i;
+    if (rest > 0) {
+        alignas(32) float r[8] = {}, c[8], sn[8];
+        for (int k = 0; k < rest; ++k) r[k] = rotation[i + k];
+
+        __m256 rad = _mm256_mul_ps(_mm256_load_ps(r), deg2rad);
+        _mm256_store_ps(c, Cos8(rad));
+        _mm256_store_ps(sn, Sin8(rad));
+        for (int k = 0; k < rest; ++k) {
+            cosOut[i + k] = c[k];
+            sinOut[i + k] = sn[k];
+        }
+    }
+    _mm256_zeroupper();
+}
+#endif
+
+void ObstacleKernels::AxesAVX2(const float* rotation, float* cosOut, float* sinOut, int count)
+{
+#if SD_X86
+    AxesAVX2Body(rotation, cosOut, sinOut, count);
+#else
+    AxesScalar(rotation, cosOut, sinOut, count);
+#endif
+}
+
+// -------------------- DISPATCH --------------------
+ObstacleKernels::Path ObstacleKernels::ActivePath()
+{
+    static const Path path = CpuFeatures::BestSimdPath();
+    return path;
+}
+
+void ObstacleKernels::Pose(const float* startRotation, const float* angularVelocity,
+    const float* frequency, const float* phase, const float* amplitude,
+    const float* base, float* rotation, float* center, int count, float t)
+{
+    switch (ActivePath()) {
+    case Path::AVX2:
+        PoseAVX2(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, count, t);
+        break;
+    case Path::SSE2:
+        PoseSSE2(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, count, t);
+        break;
+    default:
+        PoseScalar(startRotation, angularVelocity, frequency, phase, amplitude, base, rotation, center, count, t);
+        break;
+    }
+}
+
+void ObstacleKernels::Axes(const float* rotation, float* cosOut, float* sinOut, int count)
+{
+    switch (ActivePath()) {
+    case Path::AVX2: AxesAVX2(rotation, cosOut, sinOut, count); break;
+    case Path::SSE2: AxesSSE2(rotation, cosOut, sinOut, count); break;
+    default:         AxesScalar(rotation, cosOut, sinOut, count); break;
+    }
+}
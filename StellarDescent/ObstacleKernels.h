@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CpuFeatures.h"
+
+/**
+ * @brief Batched obstacle motion kernels with runtime CPU dispatch.
+ *
+ * One call poses a run of obstacles that share a motion pattern at level
+ * time t, in closed form:
+ *
+ *   rotation = startRotation + angularVelocity * t
+ *   arg      = rotation * DEG2RAD * frequency + phase
+ *   center   = base + SimMath::Sin(arg) * amplitude
+ *
+ * base/center are the coordinate the pattern moves along (x for
+ * horizontal, y for vertical). Pass null for both to only spin (static
+ * obstacles). All paths perform the same IEEE operations in the same
+ * order, so results are bit-identical to the scalar reference and to
+ * MovingObstacle::PoseAt.
+ */
+namespace ObstacleKernels {
+
+    using Path = CpuFeatures::SimdPath;
+
+    /// Reference implementation, one obstacle at a time.
+    void PoseScalar(const float* startRotation, const float* angularVelocity,
+        const float* frequency, const float* phase, const float* amplitude,
+        const float* base, float* rotation, float* center, int count, float t);
+
+    /// 4 obstacles per instruction. Falls back to scalar off x86.
+    void PoseSSE2(const float* startRotation, const float* angularVelocity,
+        const float* frequency, const float* phase, const float* amplitude,
+        const float* base, float* rotation, float* center, int count, float t);
+
+    /// 8 obstacles per instruction. Only call when IsSupported(Path::AVX2).
+    void PoseAVX2(const float* startRotation, const float* angularVelocity,
+        const float* frequency, const float* phase, const float* amplitude,
+        const float* base, float* rotation, float* center, int count, float t);
+
+    /// Run the fastest path the current CPU supports.
+    void Pose(const float* startRotation, const float* angularVelocity,
+        const float* frequency, const float* phase, const float* amplitude,
+        const float* base, float* rotation, float* center, int count, float t);
+
+    /**
+     * @brief Unit axes of each rotation: cosOut/sinOut = cos/sin(rotation * DEG2RAD).
+     *
+     * Same as SimMath::Cos/Sin per element, bit for bit, on every path.
+     */
+    void AxesScalar(const float* rotation, float* cosOut, float* sinOut, int count);
+    void AxesSSE2(const float* rotation, float* cosOut, float* sinOut, int count);
+    void AxesAVX2(const float* rotation, float* cosOut, float* sinOut, int count);
+    void Axes(const float* rotation, float* cosOut, float* sinOut, int count);
+
+    /// Path chosen by Pose() and Axes(), detected once via cpuid.
+    Path ActivePath();
+}
@@ -0,0 +1,270 @@
+#include "OverlapKernels.h"
+#include "CpuFeatures.h"
+#include <cmath>
+#include <cstring>
+
+#if SD_X86
+#include <immintrin.h>
+#endif
+
+// -------------------- SHARED HELPERS --------------------
+namespace
+{
+    inline int PopCount(uint32_t v)
+    {
+        v = v - ((v >> 1) & 0x55555555u);
+        v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+        v = (v + (v >> 4)) & 0x0F0F0F0Fu;
+        return (int)((v * 0x01010101u) >> 24);
+    }
+
+    int CountHits(const uint32_t* hitMask, int count)
+    {
+        int hits = 0;
+        for (int w = 0; w < OverlapKernels::MaskWords(count); ++w) {
+            hits += PopCount(hitMask[w]);
+        }
+        return hits;
+    }
+
+    // Scalar test for [begin, count); also the operation order the SIMD
+    // lanes follow. Box A is the query box, B the batched one:
+    //   B axes  u = (c, s), v = (-s, c)
+    //   rIJ     = A axis I . B axis J (the rotation between them)
+    void OverlapRange(const SimMath::OrientedBox& box,
+        const float* centerX, const float* centerY,
+        const float* halfW, const float* halfH,
+        const float* axisCos, const float* axisSin,
+        int begin, int count, uint32_t* hitMask)
+    {
+        const Vector2 a0 = box.axes[0];
+        const Vector2 a1 = box.axes[1];
+
+        for (int i = begin; i < count; ++i) {
+            float dx = centerX[i] - box.center.x;
+            float dy = centerY[i] - box.center.y;
+            float c = axisCos[i];
+            float s = axisSin[i];
+
+            float r00 = fabsf(a0.x * c + a0.y * s);
+            float r01 = fabsf(a0.y * c - a0.x * s);
+            float r10 = fabsf(a1.x * c + a1.y * s);
+            float r11 = fabsf(a1.y * c - a1.x * s);
+
+            // All four axes, no early out, exactly as the lanes do it
+            bool apart =
+                (fabsf(dx * a0.x + dy * a0.y) > box.half.x + (halfW[i] * r00 + halfH[i] * r01)) |
+                (fabsf(dx * a1.x + dy * a1.y) > box.half.y + (halfW[i] * r10 + halfH[i] * r11)) |
+                (fabsf(dx * c + dy * s) > halfW[i] + (box.half.x * r00 + box.half.y * r10)) |
+                (fabsf(dy * c - dx * s) > halfH[i] + (box.half.x * r01 + box.half.y * r11));
+
+            if (!apart) {
+                hitMask[i >> 5] |= 1u << (i & 31);
+            }
+        }
+    }
+}
+
+// -------------------- SCALAR REFERENCE --------------------
+int OverlapKernels::OverlapsScalar(const SimMath::OrientedBox& box,
+    const float* centerX, const float* centerY,
+    const float* halfW, const float* halfH,
+    const float* axisCos, const float* axisSin,
+    int count, uint32_t* hitMask)
+{
+    std::memset(hitMask, 0, sizeof(uint32_t) * MaskWords(count));
+    OverlapRange(box, centerX, centerY, halfW, halfH, axisCos, axisSin, 0, count, hitMask);
+    return CountHits(hitMask, count);
+}
+
+// -------------------- SSE2 (4 LANES) --------------------
+#if SD_X86
+namespace
+{
+    struct QueryBox4 {
+        __m128 cx, cy, hx, hy;
+        __m128 a0x, a0y, a1x, a1y;
+        __m128 absMask;
+
+        explicit QueryBox4(const SimMath::OrientedBox& box)
+            : cx(_mm_set1_ps(box.center.x)), cy(_mm_set1_ps(box.center.y)),
+            hx(_mm_set1_ps(box.half.x)), hy(_mm_set1_ps(box.half.y)),
+            a0x(_mm_set1_ps(box.axes[0].x)), a0y(_mm_set1_ps(box.axes[0].y)),
+            a1x(_mm_set1_ps(box.axes[1].x)), a1y(_mm_set1_ps(box.axes[1].y)),
+            absMask(_mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)))
+        {
+        }
+    };
+
+    // OverlapRange for 4 boxes; returns their hit bits
+    inline uint32_t Overlap4(const QueryBox4& q, const float* centerX, const float* centerY,
+        const float* halfW, const float* halfH, const float* axisCos, const float* axisSin)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(centerX), q.cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(centerY), q.cy);
+        __m128 c = _mm_loadu_ps(axisCos);
+        __m128 s = _mm_loadu_ps(axisSin);
+        __m128 hw = _mm_loadu_ps(halfW);
+        __m128 hh = _mm_loadu_ps(halfH);
+
+        __m128 r00 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(q.a0x, c), _mm_mul_ps(q.a0y, s)), q.absMask);
+        __m128 r01 = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(q.a0y, c), _mm_mul_ps(q.a0x, s)), q.absMask);
+        __m128 r10 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(q.a1x, c), _mm_mul_ps(q.a1y, s)), q.absMask);
+        __m128 r11 = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(q.a1y, c), _mm_mul_ps(q.a1x, s)), q.absMask);
+
+        __m128 d0 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(dx, q.a0x), _mm_mul_ps(dy, q.a0y)), q.absMask);
+        __m128 d1 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(dx, q.a1x), _mm_mul_ps(dy, q.a1y)), q.absMask);
+        __m128 d2 = _mm_and_ps(_mm_add_ps(_mm_mul_ps(dx, c), _mm_mul_ps(dy, s)), q.absMask);
+        __m128 d3 = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(dy, c), _mm_mul_ps(dx, s)), q.absMask);
+
+        __m128 e0 = _mm_add_ps(q.hx, _mm_add_ps(_mm_mul_ps(hw, r00), _mm_mul_ps(hh, r01)));
+        __m128 e1 = _mm_add_ps(q.hy, _mm_add_ps(_mm_mul_ps(hw, r10), _mm_mul_ps(hh, r11)));
+        __m128 e2 = _mm_add_ps(hw, _mm_add_ps(_mm_mul_ps(q.hx, r00), _mm_mul_ps(q.hy, r10)));
+        __m128 e3 = _mm_add_ps(hh, _mm_add_ps(_mm_mul_ps(q.hx, r01), _mm_mul_ps(q.hy, r11)));
+
+        __m128 apart = _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(d0, e0), _mm_cmpgt_ps(d1, e1)),
+            _mm_or_ps(_mm_cmpgt_ps(d2, e2), _mm_cmpgt_ps(d3, e3)));
+
+        return (uint32_t)_mm_movemask_ps(apart) ^ 0xFu;
+    }
+}
+#endif
+
+int OverlapKernels::OverlapsSSE2(const SimMath::OrientedBox& box,
+    const float* centerX, const float* centerY,
+    const float* halfW, const float* halfH,
+    const float* axisCos, const float* axisSin,
+    int count, uint32_t* hitMask)
+{
+#if SD_X86
+    std::memset(hitMask, 0, sizeof(uint32_t) * MaskWords(count));
+
+    const QueryBox4 q(box);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32_t bits = Overlap4(q, centerX + i, centerY + i, halfW + i, halfH + i,
+            axisCos + i, axisSin + i);
+        hitMask[i >> 5] |= bits << (i & 31);
+    }
+
+    OverlapRange(box, centerX, centerY, halfW, halfH, axisCos, axisSin, i, count, hitMask);
+    return CountHits(hitMask, count);
+#else
+    return OverlapsScalar(box, centerX, centerY, halfW, halfH, axisCos, axisSin, count, hitMask);
+#endif
+}
+
+// -------------------- AVX2 (8 LANES) --------------------
+#if SD_X86
+SD_TARGET_AVX2
+static void OverlapsAVX2Body(const SimMath::OrientedBox& box,
+    const float* centerX, const float* centerY,
+    const float* halfW, const float* halfH,
+    const float* axisCos, const float* axisSin,
+    int count, uint32_t* hitMask)
+{
+    const __m256 cx = _mm256_set1_ps(box.center.x);
+    const __m256 cy = _mm256_set1_ps(box.center.y);
+    const __m256 hx = _mm256_set1_ps(box.half.x);
+    const __m256 hy = _mm256_set1_ps(box.half.y);
+    const __m256 a0x = _mm256_set1_ps(box.axes[0].x);
+    const __m256 a0y = _mm256_set1_ps(box.axes[0].y);
+    const __m256 a1x = _mm256_set1_ps(box.axes[1].x);
+    const __m256 a1y = _mm256_set1_ps(box.axes[1].y);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(centerX + i), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(centerY + i), cy);
+        __m256 c = _mm256_loadu_ps(axisCos + i);
+        __m256 s = _mm256_loadu_ps(axisSin + i);
+        __m256 hw = _mm256_loadu_ps(halfW + i);
+        __m256 hh = _mm256_loadu_ps(halfH + i);
+
+        __m256 r00 = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(a0x, c), _mm256_mul_ps(a0y, s)), absMask);
+        __m256 r01 = _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(a0y, c), _mm256_mul_ps(a0x, s)), absMask);
+        __m256 r10 = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(a1x, c), _mm256_mul_ps(a1y, s)), absMask);
+        __m256 r11 = _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(a1y, c), _mm256_mul_ps(a1x, s)), absMask);
+
+        __m256 d0 = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(dx, a0x), _mm256_mul_ps(dy, a0y)), absMask);
+        __m256 d1 = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(dx, a1x), _mm256_mul_ps(dy, a1y)), absMask);
+        __m256 d2 = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(dx, c), _mm256_mul_ps(dy, s)), absMask);
+        __m256 d3 = _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(dy, c), _mm256_mul_ps(dx, s)), absMask);
+
+        __m256 e0 = _mm256_add_ps(hx, _mm256_add_ps(_mm256_mul_ps(hw, r00), _mm256_mul_ps(hh, r01)));
+        __m256 e1 = _mm256_add_ps(hy, _mm256_add_ps(_mm256_mul_ps(hw, r10), _mm256_mul_ps(hh, r11)));
+        __m256 e2 = _mm256_add_ps(hw, _mm256_add_ps(_mm256_mul_ps(hx, r00), _mm256_mul_ps(hy, r10)));
+        __m256 e3 = _mm256_add_ps(hh, _mm256_add_ps(_mm256_mul_ps(hx, r01), _mm256_mul_ps(hy, r11)));
+
+        __m256 apart = _mm256_or_ps(
+            _mm256_or_ps(_mm256_cmp_ps(d0, e0, _CMP_GT_OQ), _mm256_cmp_ps(d1, e1, _CMP_GT_OQ)),
+            _mm256_or_ps(_mm256_cmp_ps(d2, e2, _CMP_GT_OQ), _mm256_cmp_ps(d3, e3, _CMP_GT_OQ)));
+
+        uint32_t bits = (uint32_t)_mm256_movemask_ps(apart) ^ 0xFFu;
+        hitMask[i >> 5] |= bits << (i & 31);
+    }
+    _mm256_zeroupper();
+
+    // One 4-wide block before the scalar tail (a level rarely has a
+    // multiple of 8 candidates)
+    if (i + 4 <= count) {
+        const QueryBox4 q(box);
+        uint32_t bits = Overlap4(q, centerX + i, centerY + i, halfW + i, halfH + i,
+            axisCos + i, axisSin + i);
+        hitMask[i >> 5] |= bits << (i & 31);
+        i += 4;
+    }
+
+    OverlapRange(box, centerX, centerY, halfW, halfH, axisCos, axisSin, i, count, hitMask);
+}
+#endif
+
+int OverlapKernels::OverlapsAVX2(const SimMath::OrientedBox& box,
+    const float* centerX, const float* centerY,
+    const float* halfW, const float* halfH,
+    const float* axisCos, const float* axisSin,
+    int count, uint32_t* hitMask)
+{
+#if SD_X86
+    std::memset(hitMask, 0, sizeof(uint32_t) * MaskWords(count));
+    OverlapsAVX2Body(box, centerX, centerY, halfW, halfH, axisCos, axisSin, count, hitMask);
+    return CountHits(hitMask, count);
+#else
+    return OverlapsScalar(box, centerX, centerY, halfW, halfH, axisCos, axisSin, count, hitMask);
+#endif
+}
+
+// -------------------- DISPATCH --------------------
+OverlapKernels::Path OverlapKernels::ActivePath()
+{
+    static const Path path = CpuFeatures::BestSimdPath();
+    return path;
+}
+
+bool OverlapKernels::IsSupported(Path path)
+{
+    return CpuFeatures::IsSupported(path);
+}
+
+const char* OverlapKernels::PathName(Path path)
+{
+    return CpuFeatures::SimdPathName(path);
+}
+
+int OverlapKernels::Overlaps(const SimMath::OrientedBox& box,
+    const float* centerX, const float* centerY,
+    const float* halfW, const float* halfH,
+    const float* axisCos, const float* axisSin,
+    int count, uint32_t* hitMask)
+{
+    switch (ActivePath()) {
+    case Path::AVX2:
+        return OverlapsAVX2(box, centerX, centerY, halfW, halfH, axisCos, axisSin, count, hitMask);
+    case Path::SSE2:
+        return OverlapsSSE2(box, centerX, centerY, halfW, halfH, axisCos, axisSin, count, hitMask);
+    default:
+        return OverlapsScalar(box, centerX, centerY, halfW, halfH, axisCos, axisSin, count, hitMask);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+
+#include "CpuFeatures.h"
+#include "SimMath.h"
+
+/**
+ * @brief One oriented box tested against many (SoA) boxes at once.
+ *
+ * Separating-axis test in half-extent form: on each of the four face
+ * axes the boxes are apart when |d . L| exceeds the sum of their
+ * projected half-extents (d = center difference). It works straight from
+ * the cached cos/sin of each rotation, with no corner projection and no
+ * axis normalization. Touching boxes count as overlapping, as in
+ * MovingObstacle::CheckCollisionOBB.
+ *
+ * Bit i of word i / 32 of @p hitMask is set when box i overlaps @p box.
+ * All paths perform the same IEEE operations in the same order, so their
+ * masks are identical to the scalar reference.
+ */
+namespace OverlapKernels {
+
+    using Path = CpuFeatures::SimdPath;
+
+    /// Number of 32-bit mask words needed for @p count boxes.
+    inline int MaskWords(int count) { return (count + 31) / 32; }
+
+    /**
+     * @brief Reference implementation, one box at a time.
+     *
+     * @return Number of overlapping boxes flagged in @p hitMask.
+     */
+    int OverlapsScalar(const SimMath::OrientedBox& box,
+        const float* centerX, const float* centerY,
+        const float* halfW, const float* halfH,
+        const float* axisCos, const float* axisSin,
+        int count, uint32_t* hitMask);
+
+    /// 4 boxes per instruction. Falls back to scalar off x86.
+    int OverlapsSSE2(const SimMath::OrientedBox& box,
+        const float* centerX, const float* centerY,
+        const float* halfW, const float* halfH,
+        const float* axisCos, const float* axisSin,
+        int count, uint32_t* hitMask);
+
+    /// 8 boxes per instruction. Only call when IsSupported(Path::AVX2).
+    int OverlapsAVX2(const SimMath::OrientedBox& box,
+        const float* centerX, const float* centerY,
+        const float* halfW, const float* halfH,
+        const float* axisCos, const float* axisSin,
+        int count, uint32_t* hitMask);
+
+    /// Run the fastest path the current CPU supports.
+    int Overlaps(const SimMath::OrientedBox& box,
+        const float* centerX, const float* centerY,
+        const float* halfW, const float* halfH,
+        const float* axisCos, const float* axisSin,
+        int count, uint32_t* hitMask);
+
+    /// Path chosen by Overlaps(), detected once via cpuid.
+    Path ActivePath();
+
+    bool IsSupported(Path path);
+
+    const char* PathName(Path path);
+}
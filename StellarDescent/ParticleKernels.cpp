@@ -0,0 +1,164 @@
+#include "ParticleKernels.h"
+#include "CpuFeatures.h"
+#include <cstring>
+
+#if SD_X86
+#include <immintrin.h>
+#endif
+
+// -------------------- SHARED HELPERS --------------------
+namespace
+{
+    inline int PopCount(uint32_t v)
+    {
+        v = v - ((v >> 1) & 0x55555555u);
+        v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+        v = (v + (v >> 4)) & 0x0F0F0F0Fu;
+        return (int)((v * 0x01010101u) >> 24);
+    }
+
+    int CountDead(const uint32_t* deadMask, int count)
+    {
+        int dead = 0;
+        for (int w = 0; w < ParticleKernels::MaskWords(count); ++w) {
+            dead += PopCount(deadMask[w]);
+        }
+        return dead;
+    }
+
+    // Scalar step for [begin, count); also used for the SIMD tails.
+    // Keep the operation order (mul, then add) identical to the SIMD lanes.
+    void IntegrateRange(float* posX, float* posY,
+        const float* velX, const float* velY,
+        float* life, int begin, int count, float dt, uint32_t* deadMask)
+    {
+        for (int i = begin; i < count; ++i) {
+            posX[i] = posX[i] + velX[i] * dt;
+            posY[i] = posY[i] + velY[i] * dt;
+            life[i] = life[i] - dt;
+
+            if (life[i] <= 0.0f) {
+                deadMask[i >> 5] |= 1u << (i & 31);
+            }
+        }
+    }
+}
+
+// -------------------- SCALAR REFERENCE --------------------
+int ParticleKernels::IntegrateScalar(float* posX, float* posY,
+    const float* velX, const float* velY,
+    float* life, int count, float dt, uint32_t* deadMask)
+{
+    std::memset(deadMask, 0, sizeof(uint32_t) * MaskWords(count));
+    IntegrateRange(posX, posY, velX, velY, life, 0, count, dt, deadMask);
+    return CountDead(deadMask, count);
+}
+
+// -------------------- SSE2 (4 LANES) --------------------
+int ParticleKernels::IntegrateSSE2(float* posX, float* posY,
+    const float* velX, const float* velY,
+    float* life, int count, float dt, uint32_t* deadMask)
+{
+#if SD_X86
+    std::memset(deadMask, 0, sizeof(uint32_t) * MaskWords(count));
+
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(posX + i);
+        __m128 py = _mm_loadu_ps(posY + i);
+        px = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(velX + i), vdt));
+        py = _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(velY + i), vdt));
+        _mm_storeu_ps(posX + i, px);
+        _mm_storeu_ps(posY + i, py);
+
+        __m128 l = _mm_sub_ps(_mm_loadu_ps(life + i), vdt);
+        _mm_storeu_ps(life + i, l);
+
+        uint32_t bits = (uint32_t)_mm_movemask_ps(_mm_cmple_ps(l, zero));
+        deadMask[i >> 5] |= bits << (i & 31);
+    }
+
+    IntegrateRange(posX, posY, velX, velY, life, i, count, dt, deadMask);
+    return CountDead(deadMask, count);
+#else
+    return IntegrateScalar(posX, posY, velX, velY, life, count, dt, deadMask);
+#endif
+}
+
+// -------------------- AVX2 (8 LANES) --------------------
+#if SD_X86
+SD_TARGET_AVX2
+static void IntegrateAVX2Body(float* posX, float* posY,
+    const float* velX, const float* velY,
+    float* life, int count, float dt, uint32_t* deadMask)
+{
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 zero = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(posX + i);
+        __m256 py = _mm256_loadu_ps(posY + i);
+        px = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(velX + i), vdt));
+        py = _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(velY + i), vdt));
+        _mm256_storeu_ps(posX + i, px);
+        _mm256_storeu_ps(posY + i, py);
+
+        __m256 l = _mm256_sub_ps(_mm256_loadu_ps(life + i), vdt);
+        _mm256_storeu_ps(life + i, l);
+
+        uint32_t bits = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(l, zero, _CMP_LE_OQ));
+        deadMask[i >> 5] |= bits << (i & 31);
+    }
+    _mm256_zeroupper();
+
+    IntegrateRange(posX, posY, velX, velY, life, i, count, dt, deadMask);
+}
+#endif
+
+int ParticleKernels::IntegrateAVX2(float* posX, float* posY,
+    const float* velX, const float* velY,
+    float* life, int count, float dt, uint32_t* deadMask)
+{
+#if SD_X86
+    std::memset(deadMask, 0, sizeof(uint32_t) * MaskWords(count));
+    IntegrateAVX2Body(posX, posY, velX, velY, life, count, dt, deadMask);
+    return CountDead(deadMask, count);
+#else
+    return IntegrateScalar(posX, posY, velX, velY, life, count, dt, deadMask);
+#endif
+}
+
+// -------------------- DISPATCH --------------------
+ParticleKernels::Path ParticleKernels::ActivePath()
+{
+    static const Path path = CpuFeatures::BestSimdPath();
+    return path;
+}
+
+bool ParticleKernels::IsSupported(Path path)
+{
+    return CpuFeatures::IsSupported(path);
+}
+
+const char* ParticleKernels::PathName(Path path)
+{
+    return CpuFeatures::SimdPathName(path);
+}
+
+int ParticleKernels::Integrate(float* posX, float* posY,
+    const float* velX, const float* velY,
+    float* life, int count, float dt, uint32_t* deadMask)
+{
+    switch (ActivePath()) {
+    case Path::AVX2:
+        return IntegrateAVX2(posX, posY, velX, velY, life, count, dt, deadMask);
+    case Path::SSE2:
+        return IntegrateSSE2(posX, posY, velX, velY, life, count, dt, deadMask);
+    default:
+        return IntegrateScalar(posX, posY, velX, velY, life, count, dt, deadMask);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+
+#include "CpuFeatures.h"
+
+/**
+ * @brief Batched particle integration kernels with runtime CPU dispatch.
+ *
+ * Every kernel advances position by velocity * dt, decrements life by dt
+ * and writes a dead-particle bitmask (bit i of word i / 32 is set when
+ * life[i] <= 0 after the step). All paths perform the same IEEE operations
+ * in the same order, so their results are bit-identical to the scalar
+ * reference.
+ */
+namespace ParticleKernels {
+
+    using Path = CpuFeatures::SimdPath;
+
+    /// Number of 32-bit mask words needed for @p count particles.
+    inline int MaskWords(int count) { return (count + 31) / 32; }
+
+    /**
+     * @brief Reference implementation, one particle at a time.
+     *
+     * @return Number of dead particles flagged in @p deadMask.
+     */
+    int IntegrateScalar(float* posX, float* posY,
+        const float* velX, const float* velY,
+        float* life, int count, float dt, uint32_t* deadMask);
+
+    /// 4 particles per instruction. Falls back to scalar off x86.
+    int IntegrateSSE2(float* posX, float* posY,
+        const float* velX, const float* velY,
+        float* life, int count, float dt, uint32_t* deadMask);
+
+    /// 8 particles per instruction. Only call when IsSupported(Path::AVX2).
+    int IntegrateAVX2(float* posX, float* posY,
+        const float* velX, const float* velY,
+        float* life, int count, float dt, uint32_t* deadMask);
+
+    /// Run the fastest path the current CPU supports.
+    int Integrate(float* posX, float* posY,
+        const float* velX, const float* velY,
+        float* life, int count, float dt, uint32_t* deadMask);
+
+    /// Path chosen by Integrate(), detected once via cpuid.
+    Path ActivePath();
+
+    bool IsSupported(Path path);
+
+    const char* PathName(Path path);
+}
@@ -0,0 +1,157 @@
+#include "ParticlePool.h"
+#include "ParticleKernels.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    int LowestBit(uint64_t bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return (int)index;
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+}
+
+ParticlePool::ParticlePool(int capacity)
+    : capacity(capacity > 0 ? capacity : 1)
+{
+    // -------------------- ONE-TIME ALLOCATION --------------------
+    // Every stream is sized to full capacity up front; nothing below
+    // this constructor is allowed to allocate.
+    posX.resize(this->capacity);
+    posY.resize(this->capacity);
+    velX.resize(this->capacity);
+    velY.resize(this->capacity);
+    life.resize(this->capacity);
+    colors.resize(this->capacity);
+    priority.resize(this->capacity);
+    older.resize(this->capacity);
+    newer.resize(this->capacity);
+    deadMask.resize(ParticleKernels::MaskWords(this->capacity));
+    Clear();
+}
+
+void ParticlePool::Clear()
+{
+    count = 0;
+    for (int p = 0; p < PRIORITY_LEVELS; ++p) oldest[p] = newest[p] = -1;
+    for (uint64_t& word : occupied) word = 0;
+}
+
+int ParticlePool::Spawn(Vector2 position, Vector2 velocity, float lifetime, Color color,
+    uint8_t particlePriority)
+{
+    int slot;
+    if (count < capacity) {
+        slot = count++;
+    }
+    else {
+        // Full: overwrite the oldest lowest-priority particle in place,
+        // unless everything live is more important than the newcomer
+        slot = FindVictim();
+        if (priority[slot] > particlePriority) {
+            rejectCount++;
+            return -1;
+        }
+        Unlink(slot);
+        evictionCount++;
+    }
+
+    posX[slot] = position.x;
+    posY[slot] = position.y;
+    velX[slot] = velocity.x;
+    velY[slot] = velocity.y;
+    life[slot] = lifetime;
+    colors[slot] = color;
+    priority[slot] = particlePriority;
+    Link(slot);
+    return slot;
+}
+
+void ParticlePool::Kill(int index)
+{
+    if (index < 0 || index >= count) return;
+
+    Unlink(index);
+    int last = --count;
+    if (index != last) {
+        MoveSlot(last, index);
+    }
+}
+
+void ParticlePool::Integrate(float dt)
+{
+    int dead = ParticleKernels::Integrate(posX.data(), posY.data(),
+        velX.data(), velY.data(), life.data(), count, dt, deadMask.data());
+    if (dead == 0) return;
+
+    // Kill from the highest index down: every slot above the one being
+    // killed is already alive, so swap-with-last never moves a dead particle.
+    for (int w = ParticleKernels::MaskWords(count) - 1; w >= 0; --w) {
+        uint32_t bits = deadMask[w];
+        for (int b = 31; bits != 0 && b >= 0; --b) {
+            if (bits & (1u << b)) {
+                Kill(w * 32 + b);
+                bits &= ~(1u << b);
+            }
+        }
+    }
+}
+
+// -------------------- AGE ORDER --------------------
+int ParticlePool::FindVictim() const
+{
+    // Oldest particle of the lowest priority that has any
+    for (int w = 0; w < PRIORITY_LEVELS / 64; ++w) {
+        if (occupied[w] != 0) return oldest[w * 64 + LowestBit(occupied[w])];
+    }
+    return 0;   // only reached with an empty pool, which never evicts
+}
+
+void ParticlePool::Link(int slot)
+{
+    int p = priority[slot];
+    older[slot] = newest[p];
+    newer[slot] = -1;
+    if (newest[p] >= 0) newer[newest[p]] = slot;
+    else oldest[p] = slot;
+    newest[p] = slot;
+    occupied[p / 64] |= 1ull << (p % 64);
+}
+
+void ParticlePool::Unlink(int slot)
+{
+    int p = priority[slot];
+    if (older[slot] >= 0) newer[older[slot]] = newer[slot];
+    else oldest[p] = newer[slot];
+    if (newer[slot] >= 0) older[newer[slot]] = older[slot];
+    else newest[p] = older[slot];
+    if (oldest[p] < 0) occupied[p / 64] &= ~(1ull << (p % 64));
+}
+
+void ParticlePool::MoveSlot(int from, int to)
+{
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    life[to] = life[from];
+    colors[to] = colors[from];
+    priority[to] = priority[from];
+
+    // Same place in its priority's list, under the new index
+    int p = priority[to];
+    older[to] = older[from];
+    newer[to] = newer[from];
+    if (older[to] >= 0) newer[older[to]] = to;
+    else oldest[p] = to;
+    if (newer[to] >= 0) older[newer[to]] = to;
+    else newest[p] = to;
+}
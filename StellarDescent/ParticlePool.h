@@ -0,0 +1,116 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Fixed-capacity structure-of-arrays particle storage.
+ *
+ * All storage is allocated once in the constructor. Spawning and killing
+ * particles never touches the heap: live particles are always packed in
+ * [0, Count()), dead ones are removed by swapping the last live particle
+ * into their slot. When the pool is full, Spawn() evicts the oldest
+ * particle of the lowest priority so emitters never stall, and important
+ * effects are never pushed out by cosmetic ones. Live particles are kept
+ * in age order per priority, so finding that victim is O(1).
+ */
+class ParticlePool {
+public:
+    /**
+     * @brief Allocate storage for a fixed number of particles.
+     *
+     * @param capacity Hard upper bound of live particles.
+     */
+    explicit ParticlePool(int capacity);
+
+    /**
+     * @brief Add a particle, evicting an older one if the pool is full.
+     *
+     * When full, the victim is the oldest particle among those with the
+     * lowest priority. If every live particle outranks @p priority the new
+     * particle is dropped instead.
+     *
+     * @return Slot index the new particle was written to, or -1 if dropped.
+     */
+    int Spawn(Vector2 position, Vector2 velocity, float life, Color color,
+        uint8_t priority = 0);
+
+    /**
+     * @brief Remove the particle at @p index in O(1).
+     *
+     * The last live particle is moved into @p index, so callers iterating
+     * forward must re-visit the same index after a Kill().
+     */
+    void Kill(int index);
+
+    /**
+     * @brief Advance every particle by @p dt and remove the dead ones.
+     *
+     * Uses the widest SIMD kernel the CPU supports (see ParticleKernels).
+     */
+    void Integrate(float dt);
+
+    /// Remove every particle (keeps the storage).
+    void Clear();
+
+    int Count() const { return count; }
+    int Capacity() const { return capacity; }
+
+    /// Number of particles dropped early because the pool was full.
+    uint32_t GetEvictionCount() const { return evictionCount; }
+
+    /// Number of spawns refused because only higher priorities were live.
+    uint32_t GetRejectCount() const { return rejectCount; }
+
+    // -------------------- SoA STREAMS --------------------
+    // Valid entries are [0, Count()).
+    float* PositionX() { return posX.data(); }
+    float* PositionY() { return posY.data(); }
+    float* VelocityX() { return velX.data(); }
+    float* VelocityY() { return velY.data(); }
+    float* Life() { return life.data(); }
+    Color* Colors() { return colors.data(); }
+
+    const float* PositionX() const { return posX.data(); }
+    const float* PositionY() const { return posY.data(); }
+    const float* VelocityX() const { return velX.data(); }
+    const float* VelocityY() const { return velY.data(); }
+    const float* Life() const { return life.data(); }
+    const Color* Colors() const { return colors.data(); }
+
+private:
+    int capacity;
+    int count = 0;
+
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> life;
+    std::vector<Color> colors;
+
+    // Scratch dead-particle bitmask filled by the integration kernel
+    std::vector<uint32_t> deadMask;
+
+    // Culling priority per slot (higher survives longer under pressure)
+    std::vector<uint8_t> priority;
+
+    // -------------------- AGE ORDER --------------------
+    // One doubly linked list of slots per priority, oldest first, threaded
+    // through these per-slot links (-1 = none). Spawning appends, killing
+    // unlinks and moving a slot relinks its neighbours, all in O(1).
+    static constexpr int PRIORITY_LEVELS = 256;
+    std::vector<int> older;
+    std::vector<int> newer;
+    int oldest[PRIORITY_LEVELS];
+    int newest[PRIORITY_LEVELS];
+    uint64_t occupied[PRIORITY_LEVELS / 64] = {};  // bit set = list not empty
+
+    uint32_t evictionCount = 0;
+    uint32_t rejectCount = 0;
+
+    int FindVictim() const;
+    void Link(int slot);
+    void Unlink(int slot);
+    void MoveSlot(int from, int to);
+};
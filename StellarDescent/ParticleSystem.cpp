@@ -0,0 +1,212 @@
+#include "ParticleSystem.h"
+#include <cmath>
+
+// -------------------- EMITTER PROFILES --------------------
+namespace
+{
+    // Culling priority: higher survives longer when the budget is full
+    constexpr uint8_t PRIORITY_LOW = 0;
+    constexpr uint8_t PRIORITY_NORMAL = 1;
+    constexpr uint8_t PRIORITY_HIGH = 2;
+
+    struct EmitterProfile {
+        float rate;        // particles per second
+        float duration;    // seconds a burst lasts (0 = continuous)
+        float offset;      // spawn offset along the emitter's local +Y (px)
+        bool  radial;      // true = random direction, false = local exhaust cone
+        float minSpeed;    // radial speed, or local +Y speed for cones
+        float maxSpeed;
+        float spread;      // local sideways jitter range for cones (px/s)
+        float minLife;
+        float maxLife;
+        Color color;
+        uint8_t priority;
+    };
+
+    const EmitterProfile& ProfileFor(EmitterType type)
+    {
+        static const EmitterProfile profiles[] = {
+            // THRUST: steady exhaust cone behind the nozzle
+            { 60.0f,   0.0f,  15.0f, false,  80.0f, 120.0f,  30.0f, 0.4f, 0.7f, YELLOW,    PRIORITY_NORMAL },
+            // CRASH_BURST: dense radial explosion
+            { 2000.0f, 0.15f,  0.0f, true,   60.0f, 220.0f,   0.0f, 0.6f, 1.2f, ORANGE,    PRIORITY_HIGH },
+            // LANDING_DUST: low, wide puff drifting upward
+            { 600.0f,  0.3f,   0.0f, false, -40.0f, -10.0f, 280.0f, 0.5f, 1.0f, LIGHTGRAY, PRIORITY_LOW },
+            // OBSTACLE_SPARKS: short, fast radial flash
+            { 800.0f,  0.1f,   0.0f, true,  100.0f, 300.0f,   0.0f, 0.15f, 0.4f, GOLD,     PRIORITY_NORMAL },
+        };
+        return profiles[(int)type];
+    }
+
+    // Uniform [0, 1) draws per spawned particle: speed, direction/jitter, life
+    constexpr int RANDOMS_PER_SPAWN = 3;
+}
+
+// ---------------------------------------------------------------
+
+ParticleSystem::ParticleSystem(int budget, uint64_t seed)
+    : pool(budget),
+    rng(seed, RngStream::EFFECTS),
+    randoms((size_t)pool.Capacity() * RANDOMS_PER_SPAWN)
+{
+}
+
+int ParticleSystem::AllocateEmitter()
+{
+    for (int i = 0; i < MAX_EMITTERS; ++i) {
+        if (!emitters[i].inUse) {
+            emitters[i] = Emitter{};
+            emitters[i].inUse = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+int ParticleSystem::AddEmitter(EmitterType type)
+{
+    int handle = AllocateEmitter();
+    if (handle < 0) return -1;
+
+    emitters[handle].type = type;
+    return handle;
+}
+
+void ParticleSystem::SetEmitter(int handle, Vector2 position, float rotationDeg, bool active)
+{
+    if (handle < 0 || handle >= MAX_EMITTERS || !emitters[handle].inUse) return;
+
+    Emitter& e = emitters[handle];
+    e.position = position;
+    e.rotation = rotationDeg;
+
+    // Restart the fractional count so a fresh ignition starts cleanly
+    if (active && !e.active) e.accumulator = 0.0f;
+    e.active = active;
+}
+
+void ParticleSystem::Burst(EmitterType type, Vector2 position, float rotationDeg)
+{
+    int handle = AllocateEmitter();
+    if (handle < 0) return;
+
+    Emitter& e = emitters[handle];
+    e.type = type;
+    e.oneShot = true;
+    e.active = true;
+    e.position = position;
+    e.rotation = rotationDeg;
+    e.remaining = ProfileFor(type).duration;
+}
+
+void ParticleSystem::Update(float dt)
+{
+    // -------------------- EMISSION --------------------
+    for (Emitter& e : emitters) {
+        if (!e.inUse || !e.active) continue;
+
+        Emit(e, dt);
+
+        if (e.oneShot) {
+            e.remaining -= dt;
+            if (e.remaining <= 0.0f) e.inUse = false;
+        }
+    }
+
+    // -------------------- INTEGRATION --------------------
+    pool.Integrate(dt);
+}
+
+void ParticleSystem::Emit(Emitter& e, float dt)
+{
+    const EmitterProfile& profile = ProfileFor(e.type);
+
+    // Bursts never emit past their duration, even on a long frame
+    float emitTime = (e.oneShot && dt > e.remaining) ? e.remaining : dt;
+    e.accumulator += profile.rate * emitTime;
+
+    // A long hitch must not dump more than the whole budget in one frame
+    float cap = (float)pool.Capacity();
+    if (e.accumulator > cap) e.accumulator = cap;
+
+    int spawns = (int)e.accumulator;
+    if (spawns <= 0) return;
+
+    size_t draws = (size_t)spawns * RANDOMS_PER_SPAWN;
+    rng.Fill(drawn, randoms.data(), draws);
+    drawn += draws;
+
+    for (int i = 0; i < spawns; ++i) SpawnOne(e, &randoms[(size_t)i * RANDOMS_PER_SPAWN]);
+    e.accumulator -= (float)spawns;
+}
+
+void ParticleSystem::SpawnOne(const Emitter& e, const float* r)
+{
+    const EmitterProfile& profile = ProfileFor(e.type);
+
+    float rad = e.rotation * DEG2RAD;
+    float c = cosf(rad);
+    float s = sinf(rad);
+
+    // -------------------- SPAWN POSITION --------------------
+    // Offset is in the emitter's local space (e.g. 15px below the rocket)
+    Vector2 position = {
+        e.position.x - profile.offset * s,
+        e.position.y + profile.offset * c
+    };
+
+    // -------------------- VELOCITY --------------------
+    float speed = profile.minSpeed + r[0] * (profile.maxSpeed - profile.minSpeed);
+    Vector2 velocity;
+
+    if (profile.radial) {
+        float angle = r[1] * 2.0f * PI;
+        velocity = { cosf(angle) * speed, sinf(angle) * speed };
+    }
+    else {
+        // Local cone: sideways jitter plus speed along local +Y, rotated to world
+        float vx = (r[1] - 0.5f) * profile.spread;
+        float vy = speed;
+        velocity = { vx * c - vy * s, vx * s + vy * c };
+    }
+
+    float life = profile.minLife + r[2] * (profile.maxLife - profile.minLife);
+
+    pool.Spawn(position, velocity, life, profile.color, profile.priority);
+}
+
+void ParticleSystem::Draw() const
+{
+    const float* px = pool.PositionX();
+    const float* py = pool.PositionY();
+    const Color* colors = pool.Colors();
+
+    for (int i = 0; i < pool.Count(); i++) {
+        DrawCircle((int)px[i], (int)py[i], 2, colors[i]);
+    }
+}
+
+void ParticleSystem::Clear()
+{
+    pool.Clear();
+
+    for (Emitter& e : emitters) {
+        if (e.oneShot) e.inUse = false;
+        e.accumulator = 0.0f;
+    }
+}
+
+void ParticleSystem::Shift(Vector2 delta)
+{
+    float* x = pool.PositionX();
+    float* y = pool.PositionY();
+    for (int i = 0; i < pool.Count(); ++i) {
+        x[i] += delta.x;
+        y[i] += delta.y;
+    }
+
+    for (Emitter& e : emitters) {
+        e.position.x += delta.x;
+        e.position.y += delta.y;
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "raylib.h"
+#include "ParticlePool.h"
+#include "Random.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Kinds of particle effects the game can emit.
+ */
+enum class EmitterType {
+    THRUST,          // continuous exhaust while the engine fires
+    CRASH_BURST,     // explosion when the rocket is destroyed
+    LANDING_DUST,    // dust kicked up by a successful landing
+    OBSTACLE_SPARKS  // sparks where the rocket strikes debris
+};
+
+/**
+ * @brief Owns every particle in the game and the emitters that feed them.
+ *
+ * All emitters share one ParticlePool whose capacity is the global particle
+ * budget, so the per-frame cost is bounded no matter how many effects fire
+ * at once. Emission is time based (particles per second). When the budget
+ * is exhausted, low-priority particles (dust) are culled before exhaust,
+ * and exhaust before crash debris.
+ */
+class ParticleSystem {
+public:
+    /// Default global particle budget shared by every emitter
+    static constexpr int DEFAULT_BUDGET = 2048;
+
+    /// Fixed number of emitter slots (continuous + in-flight bursts)
+    static constexpr int MAX_EMITTERS = 16;
+
+    /// Seed of the effects random stream (effects look the same every session)
+    static constexpr uint64_t DEFAULT_SEED = 0x5eed;
+
+    explicit ParticleSystem(int budget = DEFAULT_BUDGET, uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * @brief Register a continuous emitter (e.g. rocket exhaust).
+     *
+     * @return Handle for SetEmitter(), or -1 if every slot is taken.
+     */
+    int AddEmitter(EmitterType type);
+
+    /**
+     * @brief Move/aim a continuous emitter and switch it on or off.
+     *
+     * @param rotationDeg Orientation of the emitter (0 = pointing up, like the rocket).
+     */
+    void SetEmitter(int handle, Vector2 position, float rotationDeg, bool active);
+
+    /**
+     * @brief Fire a one-shot effect (crash, landing dust, sparks) at a position.
+     *
+     * The burst emits at its type's rate for a short duration and then frees
+     * its slot. Bursts are dropped if every emitter slot is busy.
+     */
+    void Burst(EmitterType type, Vector2 position, float rotationDeg = 0.0f);
+
+    /// Emit for this frame and integrate every particle.
+    void Update(float dt);
+
+    void Draw() const;
+
+    /// Kill all particles and stop bursts (continuous emitters stay registered).
+    void Clear();
+
+    /// Move every particle and emitter by @p delta (floating-origin rebase).
+    void Shift(Vector2 delta);
+
+    const ParticlePool& GetPool() const { return pool; }
+
+private:
+    struct Emitter {
+        EmitterType type = EmitterType::THRUST;
+        bool inUse = false;
+        bool active = false;
+        bool oneShot = false;
+        Vector2 position = { 0, 0 };
+        float rotation = 0.0f;
+        float accumulator = 0.0f; // fractional particles owed
+        float remaining = 0.0f;   // seconds left for one-shot bursts
+    };
+
+    ParticlePool pool;
+    Emitter emitters[MAX_EMITTERS];
+
+    // Spawn randomness: each frame's spawns take their draws in one batch
+    CounterRng rng;
+    uint64_t drawn = 0;            // counter of the next draw
+    std::vector<float> randoms;    // RANDOMS_PER_SPAWN per particle, whole budget
+
+    int AllocateEmitter();
+    void Emit(Emitter& e, float dt);
+    void SpawnOne(const Emitter& e, const float* r);
+};
@@ -0,0 +1,85 @@
+#include "Pilots.h"
+#include <cmath>
+
+namespace
+{
+    inline float Clamp(float v, float lo, float hi)
+    {
+        return v < lo ? lo : (v > hi ? hi : v);
+    }
+}
+
+// -------------------- RANDOM PILOT --------------------
+RandomPilot::RandomPilot(uint64_t seed, int tickRate)
+    : rng(seed, RngStream::PILOTS), seed(seed), tickRate(tickRate > 0 ? tickRate : 1)
+{
+}
+
+void RandomPilot::Reseed(uint64_t newSeed)
+{
+    seed = newSeed;
+    Restart();
+}
+
+void RandomPilot::Restart()
+{
+    rng.Seed(seed, RngStream::PILOTS);
+    current = ControlInput{};
+    ticksLeft = 0;
+}
+
+ControlInput RandomPilot::Poll()
+{
+    if (ticksLeft <= 0) {
+        // New command held for 0.1..0.6 s
+        current.throttle = (rng.NextFloat() < 0.45f) ? 1.0f : 0.0f;
+        current.rotate = (float)rng.NextInt(-1, 1);
+        ticksLeft = (int)(rng.Range(0.1f, 0.6f) * tickRate) + 1;
+    }
+
+    ticksLeft--;
+    return current;
+}
+
+// -------------------- HEURISTIC PILOT --------------------
+HeuristicPilot::HeuristicPilot(const Simulation& sim, uint64_t seed, float noise)
+    : sim(sim), rng(seed, RngStream::PILOTS), seed(seed), noise(noise)
+{
+}
+
+void HeuristicPilot::Reseed(uint64_t newSeed)
+{
+    seed = newSeed;
+    rng.Seed(seed, RngStream::PILOTS);
+}
+
+ControlInput HeuristicPilot::Poll()
+{
+    const Rocket& rocket = sim.rocket;
+    const Rectangle& pad = sim.planet.landingPad;
+
+    float padCenterX = pad.x + pad.width * 0.5f;
+    float altitude = sim.GetAltitude();
+
+    // -------------------- HORIZONTAL --------------------
+    // Aim for a horizontal speed proportional to the distance to the pad,
+    // and tilt (positive rotation pushes +x) to reach it. Level out low down.
+    float dx = padCenterX - rocket.position.x;
+    float desiredVx = Clamp(dx * 0.6f, -70.0f, 70.0f);
+    float maxTilt = (altitude < 50.0f) ? 3.0f : 25.0f;
+    float desiredTilt = Clamp((desiredVx - rocket.velocity.x) * 0.5f, -maxTilt, maxTilt);
+
+    // Reaction noise: misjudge the target attitude a little
+    desiredTilt += (rng.NextFloat() - 0.5f) * noise * 20.0f;
+
+    ControlInput input;
+    input.rotate = Clamp((desiredTilt - rocket.rotation) / 8.0f, -1.0f, 1.0f);
+
+    // -------------------- VERTICAL --------------------
+    // Descend quickly when high, slowly close to the ground (down is +y)
+    float desiredVy = Clamp(altitude * 0.35f, 12.0f, 110.0f);
+    desiredVy *= 1.0f + (rng.NextFloat() - 0.5f) * noise;
+
+    input.throttle = (rocket.velocity.y > desiredVy) ? 1.0f : 0.0f;
+    return input;
+}
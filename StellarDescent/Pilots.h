@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+#include "InputSource.h"
+#include "Random.h"
+#include "Simulation.h"
+
+/**
+ * @brief Pilot that mashes random controls.
+ *
+ * Holds a random throttle/rotation combination for a random number of
+ * ticks, then picks a new one. Gives a baseline for how forgiving a preset
+ * is to an unskilled player.
+ */
+class RandomPilot : public InputSource {
+public:
+    /**
+     * @param seed     Seed for the pilot's own generator
+     * @param tickRate Simulation ticks per second (hold times are in seconds)
+     */
+    RandomPilot(uint64_t seed, int tickRate);
+
+    ControlInput Poll() override;
+    void Restart() override;
+
+    /// Reseed and restart (one pilot object can fly many runs).
+    void Reseed(uint64_t seed);
+
+private:
+    Pcg32 rng;
+    uint64_t seed;
+    int tickRate;
+
+    ControlInput current;
+    int ticksLeft = 0;
+};
+
+/**
+ * @brief Simple feedback pilot that tries to land on the pad.
+ *
+ * Tilts toward the pad to build horizontal speed, levels out near the
+ * ground, and burns whenever it descends faster than an altitude-based
+ * target. It ignores obstacles. Reaction noise (seeded) makes repeated
+ * runs differ the way human attempts do.
+ */
+class HeuristicPilot : public InputSource {
+public:
+    /**
+     * @param sim   Simulation being flown (read-only, sampled every Poll)
+     * @param seed  Seed for the reaction noise
+     * @param noise 0 = perfect reactions, 1 = very sloppy
+     */
+    HeuristicPilot(const Simulation& sim, uint64_t seed, float noise = 0.3f);
+
+    ControlInput Poll() override;
+    void Restart() override { rng.Seed(seed, RngStream::PILOTS); }
+
+    void Reseed(uint64_t newSeed);
+
+private:
+    const Simulation& sim;
+    Pcg32 rng;
+    uint64_t seed;
+    float noise;
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Small, fast, seedable PCG32 random number generator.
+ *
+ * Replaces the global rand()/GetRandomValue state for gameplay code so
+ * runs can be reproduced from a seed and generators can live on any thread.
+ */
+class Pcg32 {
+public:
+    explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0xda3e39cb94b95bdbULL)
+    {
+        Seed(seed, stream);
+    }
+
+    /// Restart the sequence. Different @p stream values give independent sequences.
+    void Seed(uint64_t seed, uint64_t stream = 0xda3e39cb94b95bdbULL)
+    {
+        state = 0u;
+        increment = (stream << 1u) | 1u;
+        NextU32();
+        state += seed;
+        NextU32();
+    }
+
+    uint32_t NextU32()
+    {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    /// Uniform float in [0, 1).
+    float NextFloat() { return (float)(NextU32() >> 8) * (1.0f / 16777216.0f); }
+
+    /// Uniform float in [lo, hi).
+    float Range(float lo, float hi) { return lo + NextFloat() * (hi - lo); }
+
+    /// @p count uniform floats in [lo, hi), the same values as that many Range() calls.
+    void Fill(float* out, size_t count, float lo = 0.0f, float hi = 1.0f)
+    {
+        for (size_t i = 0; i < count; ++i) out[i] = Range(lo, hi);
+    }
+
+    /// Uniform integer in [min, max] (inclusive, like raylib's GetRandomValue).
+    int NextInt(int min, int max)
+    {
+        if (max < min) { int t = min; min = max; max = t; }
+        uint32_t range = (uint32_t)((int64_t)max - (int64_t)min) + 1u;
+        if (range == 0u) return (int)NextU32(); // full 32-bit span
+
+        // Rejection sampling keeps the result unbiased
+        uint32_t threshold = (0u - range) % range;
+        for (;;) {
+            uint32_t r = NextU32();
+            if (r >= threshold) return (int)((int64_t)min + (r % range));
+        }
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
+
+/**
+ * @brief Pcg32 stream ids: one independent sequence per consumer of a seed.
+ *
+ * Generators seeded from the same value but different streams never share
+ * draws, so adding an obstacle does not reshape the terrain built from the
+ * same layout seed, for example.
+ */
+namespace RngStream {
+    constexpr uint64_t OBSTACLES = 1;   // LevelManager obstacle layout
+    constexpr uint64_t TERRAIN = 2;     // heightfield hills and craters
+    constexpr uint64_t CHUNKS = 3;      // Endless Descent chunk contents
+    constexpr uint64_t EFFECTS = 4;     // particles and other presentation
+    constexpr uint64_t PILOTS = 5;      // Monte-Carlo pilot inputs
+}
+
+/**
+ * @brief Derive an independent seed from a base seed and an index (SplitMix64).
+ *
+ * Lets parallel jobs seed run N the same way no matter which thread runs it.
+ */
+inline uint64_t MixSeed(uint64_t base, uint64_t index)
+{
+    uint64_t z = base + 0x9e3779b97f4a7c15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Counter-based generator: draw i is a pure function of (key, i).
+ *
+ * Nothing advances, so any thread can take any range of draws in any order
+ * and get exactly what a serial pass would: a batch fill split across
+ * threads matches one done in a single call. Draws are SplitMix64 outputs
+ * (MixSeed) at consecutive counters, which is a counter-based generator
+ * already; the key just gives each (seed, stream) its own sequence.
+ */
+class CounterRng {
+public:
+    explicit CounterRng(uint64_t seed = 0, uint64_t stream = 0)
+        : key(MixSeed(seed, stream))
+    {
+    }
+
+    uint32_t At(uint64_t counter) const { return (uint32_t)(MixSeed(key, counter) >> 32); }
+
+    /// Uniform float in [0, 1) for draw @p counter.
+    float FloatAt(uint64_t counter) const { return (float)(At(counter) >> 8) * (1.0f / 16777216.0f); }
+
+    /// Draws first .. first + count - 1 as uniform floats in [lo, hi).
+    void Fill(uint64_t first, float* out, size_t count, float lo = 0.0f, float hi = 1.0f) const
+    {
+        for (size_t i = 0; i < count; ++i) out[i] = lo + FloatAt(first + i) * (hi - lo);
+    }
+
+private:
+    uint64_t key;
+};
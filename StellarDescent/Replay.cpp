@@ -0,0 +1,480 @@
+#include "Replay.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    // -------------------- INPUT CODES --------------------
+    // Per axis, 3 bits of the run's code byte (throttle low, rotate high)
+    enum AxisCode : uint8_t { SAME, ZERO, PLUS_ONE, MINUS_ONE, RAW };
+
+    uint8_t EncodeAxis(float value, float previous)
+    {
+        if (memcmp(&value, &previous, sizeof(float)) == 0) return SAME;
+        if (value == 0.0f && !std::signbit(value)) return ZERO;
+        if (value == 1.0f) return PLUS_ONE;
+        if (value == -1.0f) return MINUS_ONE;
+        return RAW;
+    }
+
+    // -------------------- BYTE STREAMS --------------------
+    // Fixed little-endian layout, whatever the host
+    class Writer {
+    public:
+        explicit Writer(std::vector<uint8_t>& out) : out(out) {}
+
+        void U8(uint8_t v) { out.push_back(v); }
+        void U16(uint16_t v) { for (int i = 0; i < 2; ++i) out.push_back((uint8_t)(v >> (8 * i))); }
+        void U32(uint32_t v) { for (int i = 0; i < 4; ++i) out.push_back((uint8_t)(v >> (8 * i))); }
+        void U64(uint64_t v) { for (int i = 0; i < 8; ++i) out.push_back((uint8_t)(v >> (8 * i))); }
+        void F32(float v) { uint32_t bits; memcpy(&bits, &v, 4); U32(bits); }
+        void F64(double v) { uint64_t bits; memcpy(&bits, &v, 8); U64(bits); }
+        void Vec(Vector2 v) { F32(v.x); F32(v.y); }
+
+        void VarU32(uint32_t v)
+        {
+            while (v >= 0x80) {
+                out.push_back((uint8_t)(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back((uint8_t)v);
+        }
+
+        void Bytes(const std::vector<uint8_t>& bytes) { out.insert(out.end(), bytes.begin(), bytes.end()); }
+
+    private:
+        std::vector<uint8_t>& out;
+    };
+
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+        bool Ok() const { return ok; }
+        size_t Remaining() const { return ok ? size - pos : 0; }
+
+        uint64_t Int(int bytes)
+        {
+            if (!Need((size_t)bytes)) return 0;
+            uint64_t v = 0;
+            for (int i = 0; i < bytes; ++i) v |= (uint64_t)data[pos + i] << (8 * i);
+            pos += bytes;
+            return v;
+        }
+        uint8_t U8() { return (uint8_t)Int(1); }
+        uint16_t U16() { return (uint16_t)Int(2); }
+        uint32_t U32() { return (uint32_t)Int(4); }
+        uint64_t U64() { return Int(8); }
+        float F32() { uint32_t bits = U32(); float v; memcpy(&v, &bits, 4); return v; }
+        double F64() { uint64_t bits = U64(); double v; memcpy(&v, &bits, 8); return v; }
+        Vector2 Vec() { float x = F32(); return { x, F32() }; }
+
+        uint32_t VarU32()
+        {
+            uint32_t v = 0;
+            for (int shift = 0; shift < 35 && ok; shift += 7) {
+                uint8_t b = U8();
+                v |= (uint32_t)(b & 0x7f) << shift;
+                if (!(b & 0x80)) break;
+            }
+            return v;
+        }
+
+        bool Bytes(std::vector<uint8_t>& out, size_t count)
+        {
+            if (!Need(count)) return false;
+            out.assign(data + pos, data + pos + count);
+            pos += count;
+            return true;
+        }
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+        bool ok = true;
+
+        bool Need(size_t count)
+        {
+            if (!ok || size - pos < count) ok = false;
+            return ok;
+        }
+    };
+
+    // Smallest encoded keyframe (one-byte run skip), and what ENDLESS adds:
+    // bounds a claimed keyframe count by the bytes actually left
+    constexpr size_t KEYFRAME_MIN_BYTES = 70;
+    constexpr size_t KEYFRAME_ENDLESS_BYTES = 24;
+
+    /// Length of the input run starting at @p offset; false if the run is
+    /// cut off (no length or no code byte).
+    bool RunLengthAt(const std::vector<uint8_t>& in, size_t offset, uint32_t& length)
+    {
+        length = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (offset >= in.size()) return false;
+            uint8_t b = in[offset++];
+            length |= (uint32_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) return offset < in.size();
+        }
+        return false;
+    }
+
+    // Everything before the input stream
+    bool ReadHeader(Reader& r, Replay& replay)
+    {
+        if (r.U32() != Replay::MAGIC || r.U16() != Replay::VERSION) return false;
+        ReplayHeader& header = replay.header;
+        header.mode = (ReplayMode)r.U8();
+        header.difficulty = r.U8();
+        header.level = r.U16();
+        header.tickRate = r.U16();
+        header.seed = r.U64();
+        header.pack = r.U64();
+
+        replay.keyframeInterval = (int)r.U32();
+        replay.tickCount = (int)r.U32();
+        replay.outcome = (SimOutcome)r.U8();
+        replay.score = r.F32();
+        replay.finalHash = r.U64();
+        return r.Ok() && header.mode <= ReplayMode::ENDLESS && header.tickRate >= 1 &&
+            replay.keyframeInterval >= 1 && replay.tickCount >= 0 && replay.outcome <= SimOutcome::CRASHED;
+    }
+}
+
+// -------------------- FILE FORMAT --------------------
+void Replay::Serialize(std::vector<uint8_t>& out) const
+{
+    out.clear();
+    Writer w(out);
+
+    w.U32(MAGIC);
+    w.U16(VERSION);
+    w.U8((uint8_t)header.mode);
+    w.U8((uint8_t)header.difficulty);
+    w.U16((uint16_t)header.level);
+    w.U16((uint16_t)header.tickRate);
+    w.U64(header.seed);
+    w.U64(header.pack);
+
+    w.U32((uint32_t)keyframeInterval);
+    w.U32((uint32_t)tickCount);
+    w.U8((uint8_t)outcome);
+    w.F32(score);
+    w.U64(finalHash);
+
+    w.U32((uint32_t)inputs.size());
+    w.Bytes(inputs);
+
+    // Keyframe k is at tick k * keyframeInterval, so the tick is not stored
+    w.U32((uint32_t)keyframes.size());
+    for (const Keyframe& k : keyframes) {
+        w.U32(k.inputOffset);
+        w.VarU32((uint32_t)k.runSkip);
+        w.F32(k.previous.throttle);
+        w.F32(k.previous.rotate);
+
+        const SimState& s = k.state;
+        w.Vec(s.position);
+        w.Vec(s.velocity);
+        w.F32(s.rotation);
+        w.F32(s.fuel);
+        w.Vec(s.prevPosition);
+        w.F32(s.prevRotation);
+        w.U8((uint8_t)((s.isThrusting ? 1 : 0) | (s.startGame ? 2 : 0)));
+        w.F64(s.obstacleTime);
+        w.F32(s.timer);
+        w.U64(k.hash);
+
+        if (header.mode == ReplayMode::ENDLESS) {
+            w.U64((uint64_t)k.endless.origin.x);
+            w.U64((uint64_t)k.endless.origin.y);
+            w.U64((uint64_t)k.endless.deepestRow);
+        }
+    }
+}
+
+bool Replay::Deserialize(const uint8_t* data, size_t size)
+{
+    Reader r(data, size);
+    if (!ReadHeader(r, *this)) return false;
+
+    if (!r.Bytes(inputs, r.U32())) return false;
+
+    // One keyframe per interval started (one for an empty run); the count
+    // must also fit in what is left of the file before anything is allocated
+    uint32_t count = r.U32();
+    uint64_t expected = ((uint64_t)tickCount + (uint64_t)keyframeInterval - 1) / (uint64_t)keyframeInterval +
+        (tickCount == 0 ? 1 : 0);
+    size_t keyframeBytes = KEYFRAME_MIN_BYTES + (header.mode == ReplayMode::ENDLESS ? KEYFRAME_ENDLESS_BYTES : 0);
+    if (!r.Ok() || count != expected || count > r.Remaining() / keyframeBytes) return false;
+
+    keyframes.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Keyframe& k = keyframes[i];
+        k.tick = (int)i * keyframeInterval;
+        k.inputOffset = r.U32();
+        k.runSkip = (int)r.VarU32();
+        k.previous.throttle = r.F32();
+        k.previous.rotate = r.F32();
+
+        SimState& s = k.state;
+        s.position = r.Vec();
+        s.velocity = r.Vec();
+        s.rotation = r.F32();
+        s.fuel = r.F32();
+        s.prevPosition = r.Vec();
+        s.prevRotation = r.F32();
+        uint8_t flags = r.U8();
+        s.isThrusting = (flags & 1) != 0;
+        s.startGame = (flags & 2) != 0;
+        s.obstacleTime = r.F64();
+        s.timer = r.F32();
+        s.tickCount = k.tick;
+        k.hash = r.U64();
+
+        if (header.mode == ReplayMode::ENDLESS) {
+            k.endless.origin.x = (int64_t)r.U64();
+            k.endless.origin.y = (int64_t)r.U64();
+            k.endless.deepestRow = (int64_t)r.U64();
+        }
+        if (!r.Ok() || k.inputOffset > inputs.size()) return false;
+
+        // The keyframe's tick must fall inside the run it points at, or
+        // seeking to it would skip past the run
+        uint32_t runLength;
+        if (k.tick < tickCount &&
+            (!RunLengthAt(inputs, k.inputOffset, runLength) || k.runSkip < 0 || (uint32_t)k.runSkip >= runLength)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Replay::DeserializeHeader(const uint8_t* data, size_t size)
+{
+    Reader r(data, size);
+    return ReadHeader(r, *this);
+}
+
+bool Replay::Save(const char* path) const
+{
+    std::vector<uint8_t> bytes;
+    Serialize(bytes);
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+bool Replay::Load(const char* path)
+{
+    std::vector<uint8_t> bytes;
+    return ReadFile(path, bytes) && Deserialize(bytes.data(), bytes.size());
+}
+
+bool Replay::ReadFile(const char* path, std::vector<uint8_t>& bytes)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    bytes.clear();
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + n);
+    std::fclose(file);
+    return true;
+}
+
+// -------------------- RECORDING --------------------
+void ReplayRecorder::Begin(const ReplayHeader& header, int keyframeInterval)
+{
+    replay = Replay();
+    replay.header = header;
+    replay.keyframeInterval = keyframeInterval > 0 ? keyframeInterval : Replay::DEFAULT_KEYFRAME_INTERVAL;
+
+    runInput = ControlInput{};
+    previousRun = ControlInput{};
+    runLength = 0;
+    recording = true;
+}
+
+void ReplayRecorder::Record(const ControlInput& input, const Simulation& sim, const EndlessWorld* endless)
+{
+    if (!recording) return;
+
+    // Close the open run if this tick's input differs
+    bool same = memcmp(&input.throttle, &runInput.throttle, sizeof(float)) == 0 &&
+        memcmp(&input.rotate, &runInput.rotate, sizeof(float)) == 0;
+    if (runLength > 0 && !same) FlushRun();
+    if (runLength == 0) runInput = input;
+
+    int tick = replay.tickCount;
+    if (tick % replay.keyframeInterval == 0) {
+        Replay::Keyframe k;
+        k.tick = tick;
+        k.inputOffset = (uint32_t)replay.inputs.size();
+        k.runSkip = runLength;
+        k.previous = previousRun;
+        sim.CaptureState(k.state);
+        if (endless) k.endless = endless->GetState();
+        k.hash = sim.GetStateHash();
+        replay.keyframes.push_back(k);
+    }
+
+    runLength++;
+    replay.tickCount++;
+}
+
+void ReplayRecorder::FlushRun()
+{
+    Writer w(replay.inputs);
+    w.VarU32((uint32_t)runLength);
+
+    uint8_t throttle = EncodeAxis(runInput.throttle, previousRun.throttle);
+    uint8_t rotate = EncodeAxis(runInput.rotate, previousRun.rotate);
+    w.U8((uint8_t)(throttle | (rotate << 3)));
+    if (throttle == RAW) w.F32(runInput.throttle);
+    if (rotate == RAW) w.F32(runInput.rotate);
+
+    previousRun = runInput;
+    runLength = 0;
+}
+
+const Replay& ReplayRecorder::Finish(const Simulation& sim)
+{
+    if (recording) {
+        if (runLength > 0) FlushRun();
+        if (replay.keyframes.empty()) {
+            // A run of zero ticks still gets its starting keyframe
+            Replay::Keyframe k;
+            sim.CaptureState(k.state);
+            k.hash = sim.GetStateHash();
+            replay.keyframes.push_back(k);
+        }
+        replay.outcome = sim.GetOutcome();
+        replay.score = sim.score;
+        replay.finalHash = sim.GetStateHash();
+        recording = false;
+    }
+    return replay;
+}
+
+// -------------------- PLAYBACK --------------------
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay)
+{
+}
+
+bool ReplayPlayer::LoadWorld(Simulation& sim, LevelManager& levels, EndlessWorld* endless) const
+{
+    const ReplayHeader& h = replay.header;
+    if (h.mode == ReplayMode::ENDLESS) {
+        if (!endless) return false;
+        endless->Begin(sim, h.seed);
+        sim.ResetRun();
+    }
+    else {
+        if (h.pack != levels.GetPackHash() ||
+            h.difficulty >= levels.GetDifficultyCount() || h.level >= levels.GetLevelCount()) return false;
+        levels.LoadLayout(h.difficulty, h.level, h.seed, sim);
+    }
+    return true;
+}
+
+void ReplayPlayer::Restart()
+{
+    tick = 0;
+    offset = 0;
+    runLeft = 0;
+    current = ControlInput{};
+    previous = ControlInput{};
+}
+
+void ReplayPlayer::DecodeRun()
+{
+    const std::vector<uint8_t>& in = replay.inputs;
+
+    uint32_t length = 0;
+    for (int shift = 0; shift < 35 && offset < in.size(); shift += 7) {
+        uint8_t b = in[offset++];
+        length |= (uint32_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) break;
+    }
+    if (offset >= in.size()) {
+        runLeft = 0;
+        return;
+    }
+
+    uint8_t code = in[offset++];
+    auto decode = [&](uint8_t axis, float before) {
+        switch (axis) {
+        case ZERO:      return 0.0f;
+        case PLUS_ONE:  return 1.0f;
+        case MINUS_ONE: return -1.0f;
+        case RAW: {
+            float v = before;
+            if (offset + 4 <= in.size()) {
+                uint32_t bits = (uint32_t)in[offset] | (uint32_t)in[offset + 1] << 8 |
+                    (uint32_t)in[offset + 2] << 16 | (uint32_t)in[offset + 3] << 24;
+                memcpy(&v, &bits, 4);
+            }
+            offset += 4;
+            return v;
+        }
+        default:        return before;
+        }
+    };
+
+    previous = current;
+    current.throttle = decode(code & 7, previous.throttle);
+    current.rotate = decode((code >> 3) & 7, previous.rotate);
+    runLeft = (int)length;
+}
+
+ControlInput ReplayPlayer::Poll()
+{
+    if (tick >= replay.tickCount) return ControlInput{};
+
+    if (runLeft == 0) DecodeRun();
+    if (runLeft == 0) return ControlInput{};   // truncated stream
+
+    runLeft--;
+    tick++;
+    return current;
+}
+
+void ReplayPlayer::Seek(int target, Simulation& sim, EndlessWorld* endless)
+{
+    if (replay.keyframes.empty()) return;
+    target = target < 0 ? 0 : (target > replay.tickCount ? replay.tickCount : target);
+
+    // -------------------- NEAREST KEYFRAME --------------------
+    int index = target / replay.keyframeInterval;
+    if (index >= (int)replay.keyframes.size()) index = (int)replay.keyframes.size() - 1;
+    const Replay::Keyframe& k = replay.keyframes[index];
+
+    sim.RestoreState(k.state);
+    if (endless && replay.header.mode == ReplayMode::ENDLESS) endless->Restore(sim, k.endless);
+
+    // Decoder positioned inside the run the keyframe's tick falls in
+    tick = k.tick;
+    offset = k.inputOffset;
+    current = k.previous;
+    runLeft = 0;
+    if (tick < replay.tickCount) {
+        DecodeRun();
+        // Deserialize() rejects skips past the run; a replay built in
+        // memory could still carry one, so never go negative
+        runLeft = k.runSkip < runLeft ? runLeft - k.runSkip : 0;
+    }
+
+    // -------------------- STEP THE REST --------------------
+    const float dt = 1.0f / (float)replay.header.tickRate;
+    while (tick < target) {
+        sim.Step(Poll(), dt);
+        if (endless && replay.header.mode == ReplayMode::ENDLESS) endless->Update(sim);
+    }
+}
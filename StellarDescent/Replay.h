@@ -0,0 +1,174 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ControlInput.h"
+#include "EndlessWorld.h"
+#include "InputSource.h"
+#include "LevelManager.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+/// Which world a replay was recorded in.
+enum class ReplayMode : uint8_t {
+    LEVEL,     // a LevelManager preset
+    ENDLESS    // Endless Descent
+};
+
+/**
+ * @brief What a replay needs to rebuild its world.
+ */
+struct ReplayHeader {
+    ReplayMode mode = ReplayMode::LEVEL;
+    int difficulty = 0;
+    int level = 0;
+    uint64_t seed = 0;     // LevelManager layout seed, or the EndlessWorld seed
+    uint64_t pack = 0;     // LevelManager::GetPackHash() of the presets (LEVEL replays)
+    int tickRate = SimulationClock::DEFAULT_TICK_RATE;
+};
+
+/**
+ * @brief One recorded run: world, inputs, result and seek keyframes.
+ *
+ * Inputs are stored as runs of identical ticks. Each run is a varint tick
+ * count and one code byte: per axis the value is unchanged from the run
+ * before, one of -1/0/1, or a raw float that follows. Keyboard input is
+ * all -1/0/1, so most runs take two bytes.
+ *
+ * Every keyframeInterval ticks a keyframe holds the world state before
+ * that tick plus where its input sits in the stream. Seeking restores the
+ * nearest keyframe and steps forward from there, so the cost is bounded
+ * by the interval, not by the length of the run.
+ *
+ * Keyframes and the end of the run also carry the world's state hash, so
+ * playback can tell exactly where it stopped matching the recording.
+ */
+class Replay {
+public:
+    static constexpr uint32_t MAGIC = 0x50524453;   // "SDRP"
+    static constexpr uint16_t VERSION = 3;
+
+    /// Ticks between keyframes (2 s at the default tick rate)
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 240;
+
+    struct Keyframe {
+        int tick = 0;                  // state is from before this tick's step
+        uint32_t inputOffset = 0;      // byte offset of the input run holding the tick
+        int runSkip = 0;               // ticks of that run already played
+        ControlInput previous;         // input of the run before it (delta base)
+        SimState state;
+        EndlessWorld::State endless;   // ENDLESS replays only
+        uint64_t hash = 0;             // Simulation::GetStateHash() at this tick
+    };
+
+    ReplayHeader header;
+    int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+
+    // Claimed result, stamped by ReplayRecorder::Finish()
+    int tickCount = 0;
+    SimOutcome outcome = SimOutcome::RUNNING;
+    float score = 0.0f;
+    uint64_t finalHash = 0;   // Simulation::GetStateHash() after the last tick
+
+    std::vector<uint8_t> inputs;
+    std::vector<Keyframe> keyframes;
+
+    void Serialize(std::vector<uint8_t>& out) const;
+
+    /// False (and the replay left partly filled) if the data is not a valid replay.
+    bool Deserialize(const uint8_t* data, size_t size);
+
+    /// Only the header and claimed result (everything before the inputs),
+    /// so untrusted files can be turned away before their body is decoded.
+    bool DeserializeHeader(const uint8_t* data, size_t size);
+
+    bool Save(const char* path) const;
+    bool Load(const char* path);
+
+    /// The whole file in @p bytes.
+    static bool ReadFile(const char* path, std::vector<uint8_t>& bytes);
+};
+
+/**
+ * @brief Records a run into a Replay as it is played.
+ */
+class ReplayRecorder {
+public:
+    /// Start recording a run on the world described by @p header.
+    void Begin(const ReplayHeader& header, int keyframeInterval = Replay::DEFAULT_KEYFRAME_INTERVAL);
+
+    /**
+     * @brief Record one tick; call right before Simulation::Step with its input.
+     *
+     * @param endless The Endless Descent world for ENDLESS replays, else null.
+     */
+    void Record(const ControlInput& input, const Simulation& sim, const EndlessWorld* endless = nullptr);
+
+    /// Stamp the run's result and stop recording.
+    const Replay& Finish(const Simulation& sim);
+
+    /// Stop recording and drop the run (it no longer follows from its inputs).
+    void Cancel() { recording = false; }
+
+    bool IsRecording() const { return recording; }
+    const Replay& GetReplay() const { return replay; }
+
+private:
+    Replay replay;
+    bool recording = false;
+
+    ControlInput runInput;      // input of the open run
+    ControlInput previousRun;   // input of the run before it
+    int runLength = 0;
+
+    void FlushRun();
+};
+
+/**
+ * @brief Plays a Replay back as an InputSource, with seeking.
+ *
+ * The replay must outlive the player.
+ */
+class ReplayPlayer : public InputSource {
+public:
+    explicit ReplayPlayer(const Replay& replay);
+
+    /**
+     * @brief Build the replay's world and start a run on it.
+     *
+     * @param endless Needed for ENDLESS replays (ignored otherwise).
+     * @return false for an ENDLESS replay without @p endless, or a LEVEL
+     *         replay recorded on presets @p levels does not have (another
+     *         level pack).
+     */
+    bool LoadWorld(Simulation& sim, LevelManager& levels, EndlessWorld* endless) const;
+
+    /// Input for the next tick; neutral once the recording runs out.
+    ControlInput Poll() override;
+    void Restart() override;
+
+    /// Ticks played (or sought to) so far.
+    int GetTick() const { return tick; }
+    bool IsFinished() const { return tick >= replay.tickCount; }
+
+    /**
+     * @brief Put @p sim in its state from before tick @p target.
+     *
+     * Restores the last keyframe at or before it and steps the rest of the
+     * way, at most one keyframe interval. The world must be the replay's
+     * (LoadWorld()); @p endless as for LoadWorld().
+     */
+    void Seek(int target, Simulation& sim, EndlessWorld* endless = nullptr);
+
+private:
+    const Replay& replay;
+
+    int tick = 0;
+    size_t offset = 0;          // next run to decode
+    int runLeft = 0;            // ticks left in the current run
+    ControlInput current;
+    ControlInput previous;
+
+    void DecodeRun();
+};
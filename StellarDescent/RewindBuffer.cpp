@@ -0,0 +1,206 @@
+#include "RewindBuffer.h"
+#include <cstring>
+
+namespace
+{
+    // -------------------- SNAPSHOT LAYOUT --------------------
+    // SimState packed without padding, so unchanged fields XOR to zero bytes
+    constexpr size_t RAW_SIZE = 8 + 8 + 4 + 4 + 8 + 4 + 8 + 4 + 1 + 8;
+
+    // A delta: one bit per raw byte saying whether it changed, then the
+    // changed bytes XORed against the keyframe
+    constexpr size_t MASK_BYTES = 8;
+    constexpr size_t MAX_DELTA = MASK_BYTES + RAW_SIZE;
+    static_assert(RAW_SIZE <= MASK_BYTES * 8, "delta mask too small");
+
+    void Pack(const SimState& s, uint8_t* raw)
+    {
+        uint8_t flags = (uint8_t)((s.isThrusting ? 1 : 0) | (s.startGame ? 2 : 0));
+        uint8_t* p = raw;
+        memcpy(p, &s.position, 8);      p += 8;
+        memcpy(p, &s.velocity, 8);      p += 8;
+        memcpy(p, &s.rotation, 4);      p += 4;
+        memcpy(p, &s.fuel, 4);          p += 4;
+        memcpy(p, &s.prevPosition, 8);  p += 8;
+        memcpy(p, &s.prevRotation, 4);  p += 4;
+        memcpy(p, &s.obstacleTime, 8);  p += 8;
+        memcpy(p, &s.timer, 4);         p += 4;
+        *p++ = flags;
+        memcpy(p, &s.tickCount, 8);
+    }
+
+    void Unpack(const uint8_t* raw, SimState& s)
+    {
+        const uint8_t* p = raw;
+        memcpy(&s.position, p, 8);      p += 8;
+        memcpy(&s.velocity, p, 8);      p += 8;
+        memcpy(&s.rotation, p, 4);      p += 4;
+        memcpy(&s.fuel, p, 4);          p += 4;
+        memcpy(&s.prevPosition, p, 8);  p += 8;
+        memcpy(&s.prevRotation, p, 4);  p += 4;
+        memcpy(&s.obstacleTime, p, 8);  p += 8;
+        memcpy(&s.timer, p, 4);         p += 4;
+        uint8_t flags = *p++;
+        s.isThrusting = (flags & 1) != 0;
+        s.startGame = (flags & 2) != 0;
+        memcpy(&s.tickCount, p, 8);
+    }
+
+    size_t EncodeDelta(const uint8_t* raw, const uint8_t* key, uint8_t* out)
+    {
+        uint64_t mask = 0;
+        size_t size = MASK_BYTES;
+        for (size_t i = 0; i < RAW_SIZE; ++i) {
+            uint8_t x = raw[i] ^ key[i];
+            if (x) {
+                mask |= 1ULL << i;
+                out[size++] = x;
+            }
+        }
+        for (size_t i = 0; i < MASK_BYTES; ++i) out[i] = (uint8_t)(mask >> (8 * i));
+        return size;
+    }
+}
+
+RewindBuffer::RewindBuffer()
+    : RewindBuffer(Settings{})
+{
+}
+
+RewindBuffer::RewindBuffer(const Settings& s)
+    : settings(s)
+{
+    if (settings.tickRate < 1) settings.tickRate = SimulationClock::DEFAULT_TICK_RATE;
+    if (settings.keyframeInterval < 1) settings.keyframeInterval = 1;
+
+    int frameCount = (int)(settings.seconds * settings.tickRate + 0.5f);
+    frameCount = frameCount > settings.keyframeInterval ? frameCount : settings.keyframeInterval;
+    frames.resize((size_t)frameCount);
+
+    // Room for two full groups at least, so dropping the oldest always
+    // leaves space for the next frame
+    size_t group = RAW_SIZE + (size_t)(settings.keyframeInterval - 1) * MAX_DELTA;
+    size_t indexBytes = frames.size() * sizeof(Frame);
+    size_t arenaBytes = settings.budgetBytes > indexBytes ? settings.budgetBytes - indexBytes : 0;
+    arena.resize(arenaBytes > 2 * group ? arenaBytes : 2 * group);
+}
+
+void RewindBuffer::Clear()
+{
+    oldest = 0;
+    count = 0;
+    write = 0;
+    usedBytes = 0;
+}
+
+// -------------------- RECORDING --------------------
+void RewindBuffer::Push(const Simulation& sim)
+{
+    SimState state;
+    sim.CaptureState(state);
+    uint8_t raw[RAW_SIZE];
+    Pack(state, raw);
+
+    if (count == (int)frames.size()) DropOldestGroup();
+
+    bool key = count == 0 || Newest().sinceKey + 1 >= settings.keyframeInterval;
+    uint8_t delta[MAX_DELTA];
+    size_t size = RAW_SIZE;
+    if (!key) size = EncodeDelta(raw, &arena[Newest().keyOffset], delta);
+
+    size_t at = Reserve(size);
+
+    // Making room dropped the keyframe the delta was against
+    if (!key && count == 0) {
+        key = true;
+        size = RAW_SIZE;
+    }
+
+    Frame frame;
+    frame.offset = (uint32_t)at;
+    frame.size = (uint16_t)size;
+    if (key) {
+        memcpy(&arena[at], raw, RAW_SIZE);
+        frame.keyOffset = frame.offset;
+        frame.sinceKey = 0;
+    }
+    else {
+        memcpy(&arena[at], delta, size);
+        frame.keyOffset = Newest().keyOffset;
+        frame.sinceKey = (uint16_t)(Newest().sinceKey + 1);
+    }
+
+    frames[(oldest + count) % frames.size()] = frame;
+    count++;
+    write = at + size;
+    usedBytes += size;
+}
+
+size_t RewindBuffer::Reserve(size_t size)
+{
+    for (;;) {
+        if (count == 0) {
+            write = 0;
+            return 0;
+        }
+
+        // Live bytes run from the oldest frame to write, wrapping at most once
+        size_t tail = frames[oldest].offset;
+        if (tail < write) {
+            if (arena.size() - write >= size) return write;
+            if (tail >= size) return 0;
+        }
+        else if (tail - write >= size) {
+            return write;
+        }
+        DropOldestGroup();
+    }
+}
+
+void RewindBuffer::DropOldestGroup()
+{
+    do {
+        usedBytes -= frames[oldest].size;
+        oldest = (oldest + 1) % (int)frames.size();
+        count--;
+    } while (count > 0 && frames[oldest].sinceKey != 0);
+}
+
+// -------------------- REWINDING --------------------
+int RewindBuffer::StepBack(Simulation& sim, int ticks)
+{
+    int rewound = 0;
+    while (rewound < ticks && count > 0) {
+        Frame frame = Newest();
+        count--;
+        usedBytes -= frame.size;
+        write = frame.offset;
+        rewound++;
+
+        // Its bytes stay intact until the next Push
+        if (rewound == ticks || count == 0) {
+            SimState state;
+            Decode(frame, state);
+            sim.RestoreState(state);
+        }
+    }
+    return rewound;
+}
+
+void RewindBuffer::Decode(const Frame& frame, SimState& state) const
+{
+    uint8_t raw[RAW_SIZE];
+    memcpy(raw, &arena[frame.keyOffset], RAW_SIZE);
+
+    if (frame.sinceKey != 0) {
+        const uint8_t* delta = &arena[frame.offset];
+        uint64_t mask = 0;
+        for (size_t i = 0; i < MASK_BYTES; ++i) mask |= (uint64_t)delta[i] << (8 * i);
+
+        size_t n = MASK_BYTES;
+        for (size_t i = 0; i < RAW_SIZE; ++i) {
+            if (mask & (1ULL << i)) raw[i] ^= delta[n++];
+        }
+    }
+    Unpack(raw, state);
+}
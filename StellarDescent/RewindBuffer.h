@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+/**
+ * @brief Fixed-memory history of world states for playing a run backwards.
+ *
+ * Push() snapshots the Simulation every tick (rocket, obstacle time, timer;
+ * no particles or other presentation). Every keyframeInterval ticks the
+ * snapshot is stored whole; the ticks in between are stored as their
+ * byte-wise XOR against that keyframe with the zero bytes left out, which
+ * is small because most fields change only in their low mantissa bytes.
+ * Any frame decodes from its own keyframe, so stepping back costs the same
+ * at every depth.
+ *
+ * All storage is allocated by the constructor. When it is full the oldest
+ * keyframe and its deltas are dropped, so the history is whichever is
+ * shorter: Settings::seconds, or what fits in Settings::budgetBytes. A
+ * budget too small for the frame index plus two keyframe groups is raised
+ * to that. The defaults keep 30 s at 120 Hz (about 36 bytes a tick) well
+ * inside 256 KB.
+ */
+class RewindBuffer {
+public:
+    struct Settings {
+        float seconds = 30.0f;            // longest history kept
+        int tickRate = SimulationClock::DEFAULT_TICK_RATE;
+        int keyframeInterval = 60;        // ticks per whole snapshot
+        size_t budgetBytes = 256 * 1024;  // all storage, frame index included
+    };
+
+    RewindBuffer();
+    explicit RewindBuffer(const Settings& settings);
+
+    /// Forget every snapshot (a new run).
+    void Clear();
+
+    /// Snapshot @p sim; call once per tick, right before Simulation::Step.
+    void Push(const Simulation& sim);
+
+    /**
+     * @brief Go back @p ticks ticks.
+     *
+     * Restores the state from before the step @p ticks ticks ago (fewer if
+     * the history is shorter) and forgets every snapshot after it, so the
+     * run carries on from there.
+     *
+     * @return Ticks actually rewound.
+     */
+    int StepBack(Simulation& sim, int ticks = 1);
+
+    int GetFrameCount() const { return count; }
+
+    /// Length of the history in seconds of game time.
+    float GetSeconds() const { return (float)count / (float)settings.tickRate; }
+
+    /// Snapshot bytes in use (frame index excluded).
+    size_t GetUsedBytes() const { return usedBytes; }
+
+    /// Everything allocated: snapshot storage plus the frame index.
+    size_t GetReservedBytes() const { return arena.size() + frames.size() * sizeof(Frame); }
+
+    const Settings& GetSettings() const { return settings; }
+
+private:
+    struct Frame {
+        uint32_t offset;     // first byte in the arena
+        uint32_t keyOffset;  // the keyframe it is a delta of (its own offset if a keyframe)
+        uint16_t size;
+        uint16_t sinceKey;   // 0 for a keyframe
+    };
+
+    Settings settings;
+    std::vector<uint8_t> arena;   // snapshot bytes, used as a ring
+    std::vector<Frame> frames;    // ring of frame records
+    int oldest = 0;
+    int count = 0;
+    size_t write = 0;             // arena offset after the newest frame
+    size_t usedBytes = 0;
+
+    const Frame& Newest() const { return frames[(oldest + count - 1) % frames.size()]; }
+
+    void DropOldestGroup();
+    size_t Reserve(size_t size);
+    void Decode(const Frame& frame, SimState& state) const;
+};
@@ -1,12 +1,15 @@
 #include "Rocket.h"
 #include <cmath>
 #include "raylib.h"
+#include "SimMath.h"
 
 Rocket::Rocket(Vector2 startPos) {
     // Initialize rocket state
     position = startPos;       // Starting position in world coordinates
     velocity = { 0, 0 };       // No initial movement
     rotation = 0;              // Upright orientation
+    prevPosition = position;   // Nothing to interpolate from yet
+    prevRotation = rotation;
 
     // Base difficulty defaults (can be overridden by difficulty presets)
     maxFuel = 100.0f;          // Default max fuel
@@ -18,114 +21,53 @@ Rocket::Rocket(Vector2 startPos) {
 }
 
 
-void Rocket::Update(float dt) {
+void Rocket::Update(const ControlInput& input, float dt) {
+    // Remember where this step started so rendering can interpolate
+    prevPosition = position;
+    prevRotation = rotation;
+
     // -------------------- GRAVITY --------------------
     // Simple downward acceleration (pixels/sec^2)
     velocity.y += gravity * dt;
 
     // -------------------- ROTATION --------------------
-    // Rotate left/right based on key input (degrees/sec)
-    if (IsKeyDown(KEY_LEFT)) rotation -= 120 * dt;
-    if (IsKeyDown(KEY_RIGHT)) rotation += 120 * dt;
+    // Rotate left/right based on the rotate command (degrees/sec)
+    rotation += input.rotate * rotationSpeed * dt;
 
     // -------------------- THRUST --------------------
-    // Apply thrust if up key is pressed and fuel is available
-    if (IsKeyDown(KEY_UP) && fuel > 0) {
+    // Apply thrust if the throttle is open and fuel is available
+    isThrusting = input.throttle > 0.0f && fuel > 0;
+    if (isThrusting) {
         // Convert rotation to radians and adjust so 0 = pointing up
         float rad = (rotation - 90) * DEG2RAD;
 
         // Apply thrust vector to velocity using basic trigonometry
-        velocity.x += cosf(rad) * thrustPower * dt; // horizontal acceleration
-        velocity.y += sinf(rad) * thrustPower * dt; // vertical acceleration
+        // (owned sine/cosine: libm results differ between platforms)
+        velocity.x += SimMath::Cos(rad) * thrustPower * input.throttle * dt; // horizontal acceleration
+        velocity.y += SimMath::Sin(rad) * thrustPower * input.throttle * dt; // vertical acceleration
 
-        // Consume fuel proportional to time
-        fuel -= dt * 10;
+        // Consume fuel proportional to time and throttle
+        fuel -= dt * 10 * input.throttle;
         if (fuel < 0) fuel = 0; // clamp to zero
     }
 
-    UpdateParticles(dt);
-
     // -------------------- MOVEMENT --------------------
     // Update position based on velocity
     position.x += velocity.x * dt;
     position.y += velocity.y * dt;
 }
 
-void Rocket::Draw() {
-    // -------------------- ROCKET BODY --------------------
-    // Draw a rectangle centered on the rocket's position
-    Rectangle body = { position.x, position.y, 10, 30 };
-    Vector2 origin = { 5, 15 }; // origin at center of rectangle
-    DrawRectanglePro(body, origin, rotation, ORANGE);
-
-    // -------------------- THRUST FLAME --------------------
-    // Draw flame triangle if thrusting (CURRENTLY NOT WORKING)
-    if (IsKeyDown(KEY_UP) && fuel > 0) {
-        DrawTriangle(
-            { position.x - 5, position.y + 15 }, // bottom-left
-            { position.x + 5, position.y + 15 }, // bottom-right
-            { position.x, position.y + 30 },     // tip of flame
-            ORANGE
-        );
-    }
-
-    DrawParticles(); // draw particles under rocket
-}
-
 void Rocket::Reset(Vector2 startPos) {
     // Reset rocket state to initial conditions
     position = startPos;
     velocity = { 0, 0 };
     rotation = 0;
+    prevPosition = position;
+    prevRotation = rotation;
     fuel = maxFuel;       // refill according to current difficulty
     isAlive = true;
     hasLanded = false;
-}
-
-void Rocket::UpdateParticles(float dt) {
-    // Spawn new particles ONLY when thrusting
-    if (IsKeyDown(KEY_UP) && fuel > 0)
-    {
-        Particle p;
-
-        // -------------------- PARTICLE SPAWN POSITION --------------------
-        // Thruster is 15px "below" the rocket in *local* space
-        Vector2 localOffset = { 0.0f, 15.0f };
-
-        float rad = rotation * DEG2RAD;
-        float c = cosf(rad);
-        float s = sinf(rad);
-
-        // Rotate local offset by rocket orientation
-        p.position.x = position.x + (localOffset.x * c - localOffset.y * s);
-        p.position.y = position.y + (localOffset.x * s + localOffset.y * c);
-
-        // -------------------- PARTICLE VELOCITY --------------------
-        // Raw randomized exhaust direction (local rocket space)
-        float vx = ((float)rand() / RAND_MAX - 0.5f) * 30;   // small sideways jitter
-        float vy = 80 + (float)rand() / RAND_MAX * 40;        // strong backward thrust
-
-        // Rotate velocity into world space (same rotation as rocket)
-        p.velocity.x = vx * c - vy * s;
-        p.velocity.y = vx * s + vy * c;
-
-        // -------------------- PARTICLE SETTINGS --------------------
-        p.life = 0.4f + (float)rand() / RAND_MAX * 0.3f;
-        p.color = YELLOW;
-
-        particles.push_back(p);
-    }
-
-    // Update all particles
-    for (size_t i = 0; i < particles.size(); i++) {
-        particles[i].position.x += particles[i].velocity.x * dt;
-        particles[i].position.y += particles[i].velocity.y * dt;
-        particles[i].life -= dt;
-    }
-
-    // Remove dead particles
-    particles.erase(std::remove_if(particles.begin(), particles.end(),
-        [](Particle& p) { return p.life <= 0; }), particles.end());
+    isThrusting = false;
 }
 
 void Rocket::SetDifficultyParams(float gravityStrength, float startingFuel) {
@@ -141,9 +83,3 @@ void Rocket::SetDifficultyParams(float gravityStrength, float startingFuel) {
     }
 }
 
-
-void Rocket::DrawParticles() {
-    for (auto& p : particles) {
-        DrawCircle((int)p.position.x, (int)p.position.y, 2, p.color);
-    }
-}
@@ -1,19 +1,13 @@
 #pragma once
 #include "raylib.h"
-#include <vector>
-
-struct Particle {
-    Vector2 position;
-    Vector2 velocity;
-    float life;       // remaining life in seconds
-    Color color;
-};
+#include "ControlInput.h"
 
 /**
- * @brief Represents the player's rocket and handles its physics and rendering.
+ * @brief Represents the player's rocket and handles its physics.
  *
  * The Rocket class stores position, velocity, rotation, fuel, and status flags.
- * It provides methods for updating movement, drawing the rocket, and resetting its state.
+ * It provides methods for updating movement and resetting its state.
+ * Drawing lives in SceneRenderer so the rocket can be simulated headless.
  */
 class Rocket {
 public:
@@ -41,10 +35,12 @@ public:
     /// Flag indicating whether the rocket has successfully landed
     bool hasLanded;
 
-    std::vector<Particle> particles;
+    /// Pose at the start of the last Update (for render interpolation)
+    Vector2 prevPosition;
+    float prevRotation;
 
-    void UpdateParticles(float dt);
-    void DrawParticles();
+    /// True while the engine fired during the last Update (drives exhaust effects)
+    bool isThrusting = false;
 
     /**
      * @brief Constructor to initialize the rocket at a starting position.
@@ -54,26 +50,21 @@ public:
     Rocket(Vector2 startPos);
 
     /**
-     * @brief Update the rocket's physics and input per frame.
+     * @brief Advance the rocket's physics by one simulation step.
      *
-     * @param dt Delta time since the last frame (seconds)
+     * @param input Pilot commands for this step (throttle + rotation)
+     * @param dt    Length of the step (seconds)
      *
      * Handles:
      * - Gravity affecting vertical velocity
-     * - Rotation input via left/right keys
-     * - Thrust input via up key
+     * - Rotation from input.rotate
+     * - Thrust from input.throttle
      * - Fuel consumption
      * - Movement based on velocity
-     */
-    void Update(float dt);
-
-    /**
-     * @brief Draws the rocket to the screen.
      *
-     * Uses Raylib's DrawRectanglePro for the body and DrawTriangle for the flame.
-     * Only shows flame if the rocket is actively thrusting and has fuel.
+     * Never polls the keyboard, so it runs fine without a window.
      */
-    void Draw();
+    void Update(const ControlInput& input, float dt);
 
     /**
      * @brief Resets the rocket's state to a new starting position.
@@ -105,6 +96,9 @@ public:
 
 
 private:
-    /// Constant thrust power applied when the up key is pressed
+    /// Thrust power applied at full throttle
     const float thrustPower = 200.0f;
+
+    /// Rotation speed at full rotate input (degrees/sec)
+    const float rotationSpeed = 120.0f;
 };
@@ -0,0 +1,77 @@
+#include "SceneRenderer.h"
+
+namespace
+{
+    // The terrain is drawn down to this far below the base ground level
+    constexpr float GROUND_DEPTH = 400.0f;
+}
+
+void SceneRenderer::BuildGroundStrip(const Terrain& terrain)
+{
+    // Surface then bottom vertex for each column; left to right this gives
+    // the counter-clockwise winding DrawTriangleStrip expects
+    float bottom = Simulation::GROUND_Y + GROUND_DEPTH;
+    int count = terrain.GetSampleCount();
+
+    groundStrip.resize((size_t)count * 2);
+    for (int i = 0; i < count; ++i) {
+        float x = terrain.GetSampleX(i);
+        groundStrip[2 * i] = { x, terrain.GetSample(i) };
+        groundStrip[2 * i + 1] = { x, bottom };
+    }
+
+    groundSource = &terrain;
+    groundRevision = terrain.GetRevision();
+}
+
+void SceneRenderer::DrawGround(const Simulation& sim)
+{
+    if (groundSource != &sim.terrain || groundRevision != sim.terrain.GetRevision()) {
+        BuildGroundStrip(sim.terrain);
+    }
+
+    DrawTriangleStrip(groundStrip.data(), (int)groundStrip.size(), DARKGRAY);
+    DrawRectangleRec(sim.planet.landingPad, GREEN);
+}
+
+void SceneRenderer::DrawObstacles(Simulation& sim, Rectangle view, float alpha)
+{
+    sim.QueryObstacles(view, visibleObstacles);
+    for (int o : visibleObstacles) {
+        Vector2 v[4];
+        sim.obstacles.GetWorldVertices(o, alpha, v);
+
+        // -------------------- DEBUG OUTLINE (Currently only visible way) --------------------
+        for (int i = 0; i < 4; ++i) {
+            DrawLineV(v[i], v[(i + 1) % 4], RED);
+        }
+    }
+}
+
+void SceneRenderer::DrawRocket(const Rocket& rocket, float alpha) const
+{
+    // -------------------- INTERPOLATED POSE --------------------
+    // Blend between the last two simulation ticks
+    Vector2 drawPos = {
+        rocket.prevPosition.x + (rocket.position.x - rocket.prevPosition.x) * alpha,
+        rocket.prevPosition.y + (rocket.position.y - rocket.prevPosition.y) * alpha
+    };
+    float drawRot = rocket.prevRotation + (rocket.rotation - rocket.prevRotation) * alpha;
+
+    // -------------------- ROCKET BODY --------------------
+    // Draw a rectangle centered on the rocket's position
+    Rectangle body = { drawPos.x, drawPos.y, 10, 30 };
+    Vector2 origin = { 5, 15 }; // origin at center of rectangle
+    DrawRectanglePro(body, origin, drawRot, ORANGE);
+
+    // -------------------- THRUST FLAME --------------------
+    // Draw flame triangle if the engine fired on the last step
+    if (rocket.isThrusting) {
+        DrawTriangle(
+            { drawPos.x - 5, drawPos.y + 15 }, // bottom-left
+            { drawPos.x + 5, drawPos.y + 15 }, // bottom-right
+            { drawPos.x, drawPos.y + 30 },     // tip of flame
+            ORANGE
+        );
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+#include "Simulation.h"
+
+/**
+ * @brief Draws the simulation world with raylib.
+ *
+ * Rendering is kept out of Rocket/MovingObstacle so the simulation can be
+ * built and run without a window. Every draw call takes the interpolation
+ * factor from the SimulationClock (0 = previous tick, 1 = latest tick).
+ * Call inside BeginMode2D/EndMode2D.
+ */
+class SceneRenderer {
+public:
+    /**
+     * @brief Terrain and landing pad.
+     *
+     * The terrain is one triangle strip (a single batched draw), rebuilt
+     * only when Terrain::GetRevision() changes.
+     */
+    void DrawGround(const Simulation& sim);
+
+    /**
+     * @brief Outlines of the obstacles in @p view (world space) at their
+     * interpolated poses.
+     *
+     * Only broad-phase candidates for the view are visited, so the cost
+     * follows what is on screen, not the size of the level. Pass the camera
+     * view given to activity.SetView(): obstacles outside it may be dormant.
+     */
+    void DrawObstacles(Simulation& sim, Rectangle view, float alpha);
+
+    /**
+     * @brief Draw the rocket body and, while thrusting, its flame.
+     *
+     * Uses Raylib's DrawRectanglePro for the body and DrawTriangle for the flame.
+     */
+    void DrawRocket(const Rocket& rocket, float alpha) const;
+
+private:
+    // Terrain mesh: surface/bottom vertex pairs, left to right
+    std::vector<Vector2> groundStrip;
+    const Terrain* groundSource = nullptr;
+    uint32_t groundRevision = 0;
+
+    std::vector<int> visibleObstacles;   // DrawObstacles() query scratch
+
+    void BuildGroundStrip(const Terrain& terrain);
+};
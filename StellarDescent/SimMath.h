@@ -0,0 +1,184 @@
+#pragma once
+#include "raylib.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Window-free math helpers shared by the simulation.
+ *
+ * raylib.h is only used for its plain data types (Vector2, Rectangle);
+ * nothing here calls into the raylib library, so the simulation links
+ * without a window, GL context or audio device.
+ */
+namespace SimMath {
+
+    /// Axis-aligned rectangle overlap (same rule as raylib's CheckCollisionRecs).
+    inline bool RectsOverlap(const Rectangle& a, const Rectangle& b)
+    {
+        return (a.x < b.x + b.width && a.x + a.width > b.x) &&
+            (a.y < b.y + b.height && a.y + a.height > b.y);
+    }
+
+    // -------------------- OWNED SINE / COSINE --------------------
+    // Cody-Waite reduction by pi, then an odd polynomial on [-pi/2, pi/2].
+    // ObstacleKernels evaluates the very same operations in SIMD lanes, so
+    // scalar and vector results are bit-identical (libm sinf is not).
+    namespace SinConst {
+        constexpr float INV_PI = 0.318309886183790671538f;
+        constexpr float PI_A = 3.140625f;                 // 8 mantissa bits: k * PI_A exact for k < 2^16
+        constexpr float PI_B = 9.670257568359375e-4f;
+        constexpr float PI_C = 6.2783295730096e-7f;
+        constexpr float C3 = -1.6666667163e-1f;
+        constexpr float C5 = 8.3333337680e-3f;
+        constexpr float C7 = -1.9841270114e-4f;
+        constexpr float C9 = 2.7557314297e-6f;
+        constexpr float C11 = -2.5050759689e-8f;
+
+        /// Round to nearest, ties to even (as cvtps2dq does), for |x| < 2^22.
+        /// Adding and removing 1.5 * 2^23 leaves no fraction bits; unlike
+        /// nearbyintf this stays inline.
+        inline float RoundEven(float x)
+        {
+            const float magic = 12582912.0f;
+            return (x + magic) - magic;
+        }
+
+        /// Odd polynomial for sin(r), |r| <= pi/2
+        inline float SinPoly(float r)
+        {
+            float r2 = r * r;
+            float p = (((C11 * r2 + C9) * r2 + C7) * r2 + C5) * r2 + C3;
+            return r + (r * r2) * p;
+        }
+    }
+
+    /// sin(x) to ~2e-7 absolute for |x| <= 1e5 radians, ~2e-6 up to 2e5.
+    /// Past that k * PI_A stops being exact and the error grows quickly
+    /// (~3e-2 near 1e6), so keep arguments wrapped well inside that range.
+    inline float Sin(float x)
+    {
+        using namespace SinConst;
+
+        int k = (int)RoundEven(x * INV_PI);
+        float kf = (float)k;
+        float r = ((x - kf * PI_A) - kf * PI_B) - kf * PI_C;
+
+        float s = SinPoly(r);
+        return (k & 1) ? -s : s;
+    }
+
+    /// cos(x), same determinism as Sin(). The half-integer multiple costs
+    /// one bit of the PI_A split, so ~2e-7 holds only for |x| <= 3e4 and
+    /// the error is ~1e-6 up to 1e5, ~1e-2 beyond.
+    inline float Cos(float x)
+    {
+        using namespace SinConst;
+
+        // x = (k + 1/2) * pi + r  =>  cos(x) = -(-1)^k * sin(r)
+        int k = (int)RoundEven(x * INV_PI - 0.5f);
+        float kh = (float)k + 0.5f;
+        float r = ((x - kh * PI_A) - kh * PI_B) - kh * PI_C;
+
+        float s = SinPoly(r);
+        return (k & 1) ? s : -s;
+    }
+
+    // -------------------- OWNED EXPONENTIAL --------------------
+    // x = k * ln2 + r with the same split-constant reduction, then the
+    // Cephes polynomial for e^r and 2^k put straight into the exponent bits.
+    namespace ExpConst {
+        constexpr float LOG2E = 1.44269504088896341f;
+        constexpr float LN2_A = 0.693359375f;          // few mantissa bits: k * LN2_A is exact
+        constexpr float LN2_B = -2.12194440e-4f;
+        constexpr float P0 = 1.9875691500e-4f;
+        constexpr float P1 = 1.3981999507e-3f;
+        constexpr float P2 = 8.3333337680e-3f;
+        constexpr float P3 = 4.1665795894e-2f;
+        constexpr float P4 = 1.6666665459e-1f;
+        constexpr float P5 = 5.0000001201e-1f;
+    }
+
+    /// e^x to ~2 ulp, deterministic like Sin(); x is clamped to [-87, 88].
+    inline float Exp(float x)
+    {
+        using namespace ExpConst;
+
+        x = x > 88.0f ? 88.0f : (x < -87.0f ? -87.0f : x);
+        float kf = SinConst::RoundEven(x * LOG2E);
+        float r = (x - kf * LN2_A) - kf * LN2_B;
+
+        float p = ((((P0 * r + P1) * r + P2) * r + P3) * r + P4) * r + P5;
+        float e = p * (r * r) + r + 1.0f;
+
+        int32_t bits = ((int32_t)kf + 127) << 23;
+        float scale;
+        memcpy(&scale, &bits, sizeof(scale));
+        return e * scale;
+    }
+
+    // -------------------- BOXES --------------------
+    /**
+     * @brief World-space corners of a box with a center, half-extents and rotation.
+     *
+     * Order: TL, TR, BR, BL (before rotation).
+     */
+    inline void BuildBoxVertices(Vector2 center, Vector2 half, float rotDeg, Vector2 out[4])
+    {
+        float rad = rotDeg * DEG2RAD;
+        float c = Cos(rad);
+        float s = Sin(rad);
+
+        const Vector2 local[4] = {
+            { -half.x, -half.y },
+            {  half.x, -half.y },
+            {  half.x,  half.y },
+            { -half.x,  half.y }
+        };
+
+        for (int i = 0; i < 4; ++i) {
+            out[i].x = center.x + local[i].x * c - local[i].y * s;
+            out[i].y = center.y + local[i].x * s + local[i].y * c;
+        }
+    }
+
+    /**
+     * @brief A box posed in world space, ready for SAT tests.
+     *
+     * Built once per simulation step and shared by collision and drawing,
+     * so no test has to redo the trig or normalize its axes.
+     */
+    struct OrientedBox {
+        Vector2 center;
+        Vector2 half;
+        Vector2 verts[4];   // TL, TR, BR, BL (before rotation)
+        Vector2 axes[2];    // unit local x (TL->TR) and local y (TL->BL)
+    };
+
+    /// Pose a box from the cosine/sine of its rotation (no trig).
+    inline void BuildOrientedBox(Vector2 center, Vector2 half, float c, float s, OrientedBox& out)
+    {
+        out.center = center;
+        out.half = half;
+        out.axes[0] = { c, s };
+        out.axes[1] = { -s, c };
+
+        const Vector2 local[4] = {
+            { -half.x, -half.y },
+            {  half.x, -half.y },
+            {  half.x,  half.y },
+            { -half.x,  half.y }
+        };
+
+        for (int i = 0; i < 4; ++i) {
+            out.verts[i].x = center.x + local[i].x * c - local[i].y * s;
+            out.verts[i].y = center.y + local[i].x * s + local[i].y * c;
+        }
+    }
+
+    inline void BuildOrientedBox(Vector2 center, Vector2 half, float rotDeg, OrientedBox& out)
+    {
+        float rad = rotDeg * DEG2RAD;
+        BuildOrientedBox(center, half, Cos(rad), Sin(rad), out);
+    }
+}
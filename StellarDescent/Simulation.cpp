@@ -0,0 +1,292 @@
+#include "Simulation.h"
+#include "StateHash.h"
+#include "SweptCollision.h"
+#include <algorithm>
+#include <cmath>
+
+Simulation::Simulation()
+    : rocket({ 0, -200 }),
+    planet{ 0.0f, Rectangle{ 0, GROUND_Y, 100, 10 } }
+{
+    // planet/rocket/terrain are overridden by LevelManager when a level is applied
+    terrain.SetFlat(-1000.0f, 1000.0f, GROUND_Y);
+}
+
+void Simulation::ResetRun()
+{
+    timer = 0.0f;
+    startGame = false;
+    score = 0.0f;
+    outcome = SimOutcome::RUNNING;
+    crashCause = CrashCause::NONE;
+    tickCount = 0;
+    hasContact = false;
+}
+
+SimEvent Simulation::Step(const ControlInput& input, float dt)
+{
+    if (outcome != SimOutcome::RUNNING) return SimEvent::NONE;
+
+    // The flight clock starts with the first burn
+    if (input.throttle > 0.0f) startGame = true;
+    if (startGame) {
+        timer += dt;
+    }
+
+    rocket.Update(input, dt);
+
+    // Safety net for callers that resized obstacles without telling us
+    if (collisionWorld.GetObjectCount() != (size_t)obstacles.Size()) {
+        collisionWorld.Rebuild(obstacles);
+    }
+
+    // Only obstacles near the rocket (or on screen) are posed up front;
+    // collision candidates are synced on demand below
+    activity.Step(obstacles, collisionWorld, obstacles.GetTime() + dt, rocket.position);
+
+    tickCount++;
+    return ResolveCollisions();
+}
+
+void Simulation::QueryObstacles(Rectangle area, std::vector<int>& out)
+{
+    if (collisionWorld.GetObjectCount() != (size_t)obstacles.Size()) {
+        collisionWorld.Rebuild(obstacles);
+    }
+    collisionWorld.Query(area, out);
+}
+
+SimEvent Simulation::ResolveCollisions()
+{
+    // Both the rocket and the obstacles are swept from their pose at the
+    // start of the step to the end pose, so nothing is skipped over no
+    // matter how far they moved in one step.
+    hasContact = false;
+
+    BoxSweep rocketSweep;
+    rocketSweep.half = { ROCKET_HALF_WIDTH, ROCKET_HALF_HEIGHT };
+    rocketSweep.startCenter = rocket.prevPosition;
+    rocketSweep.endCenter = rocket.position;
+    rocketSweep.startRotation = rocket.prevRotation;
+    rocketSweep.endRotation = rocket.rotation;
+
+    // Rocket pose at the start of the step: built once, shared by every pair
+    SimMath::OrientedBox rocketStart;
+    SimMath::BuildOrientedBox(rocketSweep.startCenter, rocketSweep.half, rocketSweep.startRotation, rocketStart);
+
+    // -------------------- OBSTACLE COLLISION --------------------
+    bool hitsObstacle = false;
+    SweptContact obstacleContact;
+
+    // Candidates from everything near the rocket's path, on screen or not
+    float radius = sqrtf(ROCKET_HALF_WIDTH * ROCKET_HALF_WIDTH + ROCKET_HALF_HEIGHT * ROCKET_HALF_HEIGHT) +
+        SweptCollision::CONTACT_TOLERANCE;
+    float minX = fminf(rocket.prevPosition.x, rocket.position.x) - radius;
+    float minY = fminf(rocket.prevPosition.y, rocket.position.y) - radius;
+    float maxX = fmaxf(rocket.prevPosition.x, rocket.position.x) + radius;
+    float maxY = fmaxf(rocket.prevPosition.y, rocket.position.y) + radius;
+
+    collisionWorld.Query({ minX, minY, maxX - minX, maxY - minY }, candidates);
+
+    // Ascending index order so ties resolve the same as a full scan
+    std::sort(candidates.begin(), candidates.end());
+
+    SimMath::OrientedBox obstacleStart;
+    for (int id : candidates) {
+        activity.Sync(obstacles, id);
+        obstacles.GetPrevBox(id, obstacleStart);
+
+        SweptContact c;
+        if (SweptCollision::SweepBoxes(rocketSweep, rocketStart, obstacles.GetSweep(id), obstacleStart, c) &&
+            (!hitsObstacle || c.toi < obstacleContact.toi)) {
+            hitsObstacle = true;
+            obstacleContact = c;
+        }
+    }
+
+    // -------------------- TERRAIN CONTACT TIME --------------------
+    // The posed rocket box against the heightfield; only the columns under
+    // the rocket's path are read
+    SweptContact groundContact;
+    bool hitsGround = terrain.SweepBox(rocketSweep, rocketStart, groundContact);
+    float groundToi = hitsGround ? groundContact.toi : 1.0f;
+
+    if (hitsObstacle && (!hitsGround || obstacleContact.toi <= groundToi)) {
+        MoveRocketToContact(obstacleContact.toi);
+        lastContact = obstacleContact;
+        hasContact = true;
+
+        outcome = SimOutcome::CRASHED;
+        crashCause = CrashCause::OBSTACLE;
+        rocket.isAlive = false;
+        rocket.velocity = { 0, 0 };
+        return SimEvent::CRASHED_OBSTACLE;
+    }
+
+    if (!hitsGround) return SimEvent::NONE;
+
+    // -------------------- GROUND / PAD --------------------
+    MoveRocketToContact(groundToi);
+    lastContact = groundContact;
+    hasContact = true;
+
+    // The pad sits on a flat plateau wider than the rocket, so touching
+    // down over it means on the pad
+    float rocketLeft = rocket.position.x - ROCKET_HALF_WIDTH;
+    float rocketRight = rocket.position.x + ROCKET_HALF_WIDTH;
+    bool onPad = rocketLeft < planet.landingPad.x + planet.landingPad.width &&
+        rocketRight > planet.landingPad.x;
+
+    SimEvent event = SimEvent::CRASHED_GROUND;
+    CrashCause cause = CrashCause::OFF_PAD;
+
+    if (onPad) {
+        float padCenterX = planet.landingPad.x + planet.landingPad.width / 2.0f;
+        float rocketCenterX = rocket.position.x;
+        float horizontalTolerance = planet.landingPad.width / 2.0f - 5;
+
+        bool  withinPadHoriz = std::fabs(rocketCenterX - padCenterX) <= horizontalTolerance;
+        float maxVerticalSpeed = 50.0f;
+        float maxRotationDeg = 30.0f;
+
+        if (withinPadHoriz &&
+            physics.CheckLanding(rocket, planet.landingPad, maxVerticalSpeed, maxRotationDeg)) {
+
+            rocket.hasLanded = true;
+            event = SimEvent::LANDED;
+
+            float accuracy = 1.0f - (std::fabs(rocketCenterX - padCenterX) /
+                (planet.landingPad.width / 2.0f));
+            float timeFactor = 1.0f / (1.0f + timer);
+            float fuelFactor = rocket.fuel / 100.0f;
+
+            score = (accuracy * 0.5f + timeFactor * 0.3f + fuelFactor * 0.2f) * 1000.0f;
+        }
+        else if (withinPadHoriz) {
+            // On the pad but failed the landing check: find out which limit
+            cause = (rocket.velocity.y > maxVerticalSpeed) ? CrashCause::HARD_LANDING
+                                                           : CrashCause::TILTED;
+        }
+    }
+
+    outcome = (event == SimEvent::LANDED) ? SimOutcome::LANDED : SimOutcome::CRASHED;
+    if (outcome == SimOutcome::CRASHED) {
+        crashCause = cause;
+        rocket.isAlive = false;
+    }
+
+    rocket.velocity = { 0, 0 };
+    return event;
+}
+
+void Simulation::CaptureState(SimState& out) const
+{
+    out.position = rocket.position;
+    out.velocity = rocket.velocity;
+    out.rotation = rocket.rotation;
+    out.fuel = rocket.fuel;
+    out.prevPosition = rocket.prevPosition;
+    out.prevRotation = rocket.prevRotation;
+    out.isThrusting = rocket.isThrusting;
+
+    out.obstacleTime = obstacles.GetTime();
+
+    out.timer = timer;
+    out.startGame = startGame;
+    out.tickCount = tickCount;
+}
+
+void Simulation::RestoreState(const SimState& state)
+{
+    rocket.position = state.position;
+    rocket.velocity = state.velocity;
+    rocket.rotation = state.rotation;
+    rocket.fuel = state.fuel;
+    rocket.prevPosition = state.prevPosition;
+    rocket.prevRotation = state.prevRotation;
+    rocket.isThrusting = state.isThrusting;
+    rocket.isAlive = true;
+    rocket.hasLanded = false;
+
+    obstacles.SetTime(state.obstacleTime);
+
+    timer = state.timer;
+    startGame = state.startGame;
+    score = 0.0f;
+    tickCount = state.tickCount;
+    outcome = SimOutcome::RUNNING;
+    crashCause = CrashCause::NONE;
+    hasContact = false;
+}
+
+uint64_t Simulation::GetStateHash() const
+{
+    StateHash h;
+    h.Add(rocket.position.x);
+    h.Add(rocket.position.y);
+    h.Add(rocket.velocity.x);
+    h.Add(rocket.velocity.y);
+    h.Add(rocket.rotation);
+    h.Add(rocket.fuel);
+    h.Add(rocket.isAlive);
+    h.Add(rocket.hasLanded);
+    h.Add(rocket.isThrusting);
+
+    h.Add(timer);
+    h.Add(startGame);
+    h.Add(score);
+    h.Add((int64_t)tickCount);
+    h.Add((int)outcome);
+    h.Add((int)crashCause);
+
+    h.Add(planet.gravity);
+    h.Add(planet.landingPad.x);
+    h.Add(planet.landingPad.y);
+    h.Add(planet.landingPad.width);
+    h.Add(terrain.GetHash());
+
+    h.Add(obstacles.GetTime());
+    h.Add(obstacles.GetLayoutHash());
+    return h.Get();
+}
+
+void Simulation::ShiftOrigin(Vector2 delta)
+{
+    rocket.position.x += delta.x;
+    rocket.position.y += delta.y;
+    rocket.prevPosition.x += delta.x;
+    rocket.prevPosition.y += delta.y;
+
+    planet.landingPad.x += delta.x;
+    planet.landingPad.y += delta.y;
+
+    terrain.Shift(delta);
+
+    lastContact.point.x += delta.x;
+    lastContact.point.y += delta.y;
+}
+
+void Simulation::SwapLevel(Simulation& other)
+{
+    std::swap(planet, other.planet);
+    std::swap(obstacles, other.obstacles);
+    std::swap(terrain, other.terrain);
+    std::swap(collisionWorld, other.collisionWorld);
+}
+
+float Simulation::GetAltitude() const
+{
+    SimMath::OrientedBox box;
+    SimMath::BuildOrientedBox(rocket.position, { ROCKET_HALF_WIDTH, ROCKET_HALF_HEIGHT }, rocket.rotation, box);
+
+    Vector2 lowest;
+    return terrain.Clearance(box, lowest);
+}
+
+void Simulation::MoveRocketToContact(float toi)
+{
+    // Rewind the rocket along this step's motion to the moment of impact
+    rocket.position.x = rocket.prevPosition.x + (rocket.position.x - rocket.prevPosition.x) * toi;
+    rocket.position.y = rocket.prevPosition.y + (rocket.position.y - rocket.prevPosition.y) * toi;
+    rocket.rotation = rocket.prevRotation + (rocket.rotation - rocket.prevRotation) * toi;
+}
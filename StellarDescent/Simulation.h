@@ -0,0 +1,225 @@
+#pragma once
+#include "raylib.h"
+#include <vector>
+
+#include "ActivityRegions.h"
+#include "CollisionWorld.h"
+#include "ControlInput.h"
+#include "ObstacleField.h"
+#include "PhysicsSystem.h"
+#include "Planet.h"
+#include "Rocket.h"
+#include "SweptCollision.h"
+#include "Terrain.h"
+
+/**
+ * @brief What happened during one simulation step.
+ */
+enum class SimEvent {
+    NONE,
+    LANDED,            // touched down on the pad slowly and upright
+    CRASHED_GROUND,    // hit the ground off the pad, too fast or too tilted
+    CRASHED_OBSTACLE   // struck a moving obstacle
+};
+
+/**
+ * @brief Why a run ended in a crash.
+ */
+enum class CrashCause {
+    NONE,
+    OBSTACLE,      // struck a moving obstacle
+    OFF_PAD,       // touched the ground away from the landing pad
+    HARD_LANDING,  // on the pad, but descending too fast
+    TILTED         // on the pad, but not upright enough
+};
+
+/**
+ * @brief Overall state of the current run.
+ */
+enum class SimOutcome {
+    RUNNING,
+    LANDED,
+    CRASHED
+};
+
+/**
+ * @brief Everything that decides how a running world continues.
+ *
+ * Together with the level layout this reproduces the world exactly:
+ * obstacle motion is a closed-form function of level time, so their time
+ * is all that needs keeping. Only taken while the run is still going
+ * (replay keyframes).
+ */
+struct SimState {
+    Vector2 position = { 0, 0 };
+    Vector2 velocity = { 0, 0 };
+    float rotation = 0.0f;
+    float fuel = 0.0f;
+    Vector2 prevPosition = { 0, 0 };
+    float prevRotation = 0.0f;
+    bool isThrusting = false;
+
+    double obstacleTime = 0.0;
+
+    float timer = 0.0f;
+    bool startGame = false;
+    long long tickCount = 0;
+};
+
+/**
+ * @brief The gameplay world without any window, audio or rendering.
+ *
+ * Owns the rocket, the planet (landing pad) and the obstacles, and advances
+ * them one fixed step at a time from a ControlInput. The game wraps this
+ * with input polling, audio and drawing; headless tools drive it directly
+ * and can step it as fast as the CPU allows.
+ */
+class Simulation {
+public:
+    /// Base ground level in world space (the pad and its plateau sit on it)
+    static constexpr float GROUND_Y = 310.0f;
+
+    /// Rocket collision box half-extents (10x30 body)
+    static constexpr float ROCKET_HALF_WIDTH = 5.0f;
+    static constexpr float ROCKET_HALF_HEIGHT = 15.0f;
+
+    Rocket rocket;
+    Planet planet;
+    ObstacleField obstacles;
+
+    /// Heightfield ground (flat at GROUND_Y until LevelManager generates one)
+    Terrain terrain;
+
+    /// Which obstacles are posed each step (and how many were)
+    ActivityRegions activity;
+
+    /// Flight time, starts counting on the first throttle input
+    float timer = 0.0f;
+    bool startGame = false;
+
+    /// Score of the last successful landing
+    float score = 0.0f;
+
+    Simulation();
+
+    /**
+     * @brief Start a new run on the current layout (timer, score, outcome).
+     *
+     * Does not touch the rocket or obstacles; LevelManager places those.
+     */
+    void ResetRun();
+
+    /**
+     * @brief Advance the world by one step.
+     *
+     * Updates the rocket and obstacles, then resolves obstacle (via the
+     * CollisionWorld broad phase), terrain and pad collisions continuously
+     * over the step (see SweptCollision), so coarse steps cannot tunnel
+     * through thin obstacles. Does nothing once the run has landed or
+     * crashed.
+     */
+    SimEvent Step(const ControlInput& input, float dt);
+
+    /**
+     * @brief Rebuild the collision broad phase after obstacles were replaced.
+     *
+     * LevelManager calls this whenever it regenerates the obstacle list.
+     */
+    void OnObstaclesChanged() { collisionWorld.Rebuild(obstacles); }
+
+    /**
+     * @brief Obstacles that may overlap @p area, from the broad phase.
+     *
+     * Only a superset: candidates still need a narrow test. Inside the view
+     * given to activity.SetView() they are all posed for the current step,
+     * so querying the camera view gives what to draw.
+     */
+    void QueryObstacles(Rectangle area, std::vector<int>& out);
+
+    /**
+     * @brief Exchange the level with @p other: pad, obstacles, terrain and
+     * the obstacle broad phase.
+     *
+     * Swaps the storage, so it costs the same for any level size and
+     * allocates nothing. LevelManager builds levels on a worker thread into
+     * a spare Simulation and swaps them in with this. The rocket and run
+     * state are left alone.
+     */
+    void SwapLevel(Simulation& other);
+
+    /**
+     * @brief Move the rocket, pad, terrain and last contact by @p delta.
+     *
+     * Floating-origin rebase (see EndlessWorld). Obstacles are not moved:
+     * the caller re-assigns them in the new frame and calls
+     * OnObstaclesChanged().
+     */
+    void ShiftOrigin(Vector2 delta);
+
+    /// Copy the state of a running world (see SimState).
+    void CaptureState(SimState& out) const;
+
+    /**
+     * @brief Put the world back in a captured state, still running.
+     *
+     * The layout (pad, terrain, obstacle list) must be the one it was
+     * captured on; obstacles are re-posed at the captured time.
+     */
+    void RestoreState(const SimState& state);
+
+    SimOutcome GetOutcome() const { return outcome; }
+
+    /// Reason for the crash; NONE while running or after a landing
+    CrashCause GetCrashCause() const { return crashCause; }
+
+    /**
+     * @brief Contact that ended the run, if any.
+     *
+     * toi is the fraction of the final step at which the rocket touched
+     * (the rocket is left at that pose), normal points away from the
+     * surface that was hit. Returns false while nothing has been hit.
+     */
+    bool GetLastContact(SweptContact& out) const
+    {
+        if (hasContact) out = lastContact;
+        return hasContact;
+    }
+
+    /**
+     * @brief Vertical gap between the rocket box and the terrain below it.
+     *
+     * Terrain::NO_GROUND when the rocket is beyond the edge of the terrain.
+     */
+    float GetAltitude() const;
+
+    /**
+     * @brief 64-bit hash of the whole world state, for determinism checks.
+     *
+     * Covers the rocket, timer, outcome, pad, terrain and obstacles. The
+     * obstacles enter as their layout plus the level time, which fixes every
+     * pose exactly (motion is closed-form); hashing the posed arrays would
+     * depend on which obstacles ActivityRegions happened to pose. Cheap
+     * enough to take every tick.
+     */
+    uint64_t GetStateHash() const;
+
+    /// Steps taken since the last ResetRun()
+    long long GetTickCount() const { return tickCount; }
+
+private:
+    PhysicsSystem physics;
+
+    SimOutcome outcome = SimOutcome::RUNNING;
+    CrashCause crashCause = CrashCause::NONE;
+    long long tickCount = 0;
+
+    SweptContact lastContact;
+    bool hasContact = false;
+
+    // Broad phase over all obstacles (built per level from motion envelopes)
+    CollisionWorld collisionWorld;
+    std::vector<int> candidates;
+
+    SimEvent ResolveCollisions();
+    void MoveRocketToContact(float toi);
+};
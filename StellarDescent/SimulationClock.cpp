@@ -0,0 +1,56 @@
+#include "SimulationClock.h"
+#include <cmath>
+
+SimulationClock::SimulationClock(int tickRate, float maxFrameTime)
+    : tickRate(0),
+    tickDt(0.0f),
+    maxFrameTime(maxFrameTime),
+    maxTicksPerFrame(1)
+{
+    SetTickRate(tickRate);
+}
+
+void SimulationClock::SetTickRate(int rate)
+{
+    if (rate < 1) rate = 1;
+
+    tickRate = rate;
+    tickDt = 1.0f / (float)rate;
+
+    // Enough ticks to cover one clamped frame, never fewer than one
+    maxTicksPerFrame = (int)std::ceil(maxFrameTime / tickDt);
+    if (maxTicksPerFrame < 1) maxTicksPerFrame = 1;
+
+    Reset();
+}
+
+void SimulationClock::Advance(float frameTime)
+{
+    // -------------------- SPIRAL-OF-DEATH CLAMP --------------------
+    if (frameTime < 0.0f) frameTime = 0.0f;
+    if (frameTime > maxFrameTime) frameTime = maxFrameTime;
+
+    accumulator += frameTime;
+    ticksThisFrame = 0;
+}
+
+bool SimulationClock::ConsumeTick()
+{
+    if (accumulator < tickDt) return false;
+
+    // Hard cap in case the caller advanced several times without consuming
+    if (ticksThisFrame >= maxTicksPerFrame) {
+        accumulator = std::fmod(accumulator, tickDt);
+        return false;
+    }
+
+    accumulator -= tickDt;
+    ticksThisFrame++;
+    return true;
+}
+
+void SimulationClock::Reset()
+{
+    accumulator = 0.0f;
+    ticksThisFrame = 0;
+}
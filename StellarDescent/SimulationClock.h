@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @brief Fixed-timestep clock for the gameplay simulation.
+ *
+ * Real frame time is accumulated and consumed in fixed ticks, so physics
+ * results do not depend on the render frame rate. The remainder left in
+ * the accumulator is exposed as an interpolation factor for rendering.
+ *
+ * Typical use per frame:
+ *   clock.Advance(GetFrameTime());
+ *   while (clock.ConsumeTick()) { Step(clock.GetTickDt()); }
+ *   Render(clock.GetAlpha());
+ */
+class SimulationClock {
+public:
+    /// Default simulation rate in ticks per second
+    static constexpr int DEFAULT_TICK_RATE = 120;
+
+    /**
+     * @param tickRate   Simulation ticks per second (e.g. 120 or 240).
+     * @param maxFrameTime Longest real frame the clock will try to catch up on (seconds).
+     */
+    explicit SimulationClock(int tickRate = DEFAULT_TICK_RATE, float maxFrameTime = 0.25f);
+
+    /// Change the tick rate; clears any pending time.
+    void SetTickRate(int tickRate);
+
+    /**
+     * @brief Feed real elapsed time into the accumulator.
+     *
+     * Frame time is clamped to maxFrameTime (spiral-of-death guard): after a
+     * long hitch the simulation slows down instead of running an ever
+     * growing number of catch-up ticks.
+     */
+    void Advance(float frameTime);
+
+    /**
+     * @brief Take one fixed tick from the accumulator if enough time is pending.
+     *
+     * @return true if the caller should run one simulation step of GetTickDt().
+     */
+    bool ConsumeTick();
+
+    /// Drop any pending time (e.g. when resuming from pause or a level load).
+    void Reset();
+
+    int GetTickRate() const { return tickRate; }
+    float GetTickDt() const { return tickDt; }
+
+    /// Fraction of a tick left in the accumulator, in [0, 1), for render interpolation.
+    float GetAlpha() const { return accumulator / tickDt; }
+
+    /// Ticks run since the last Advance() call.
+    int GetTicksThisFrame() const { return ticksThisFrame; }
+
+private:
+    int tickRate;
+    float tickDt;
+    float maxFrameTime;
+    int maxTicksPerFrame;
+
+    float accumulator = 0.0f;
+    int ticksThisFrame = 0;
+};
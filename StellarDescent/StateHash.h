@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#include "Random.h"
+
+/**
+ * @brief Running 64-bit hash of simulation state, for determinism checks.
+ *
+ * Floats are hashed by their bit pattern, so any difference at all (even
+ * -0 against +0) changes the result. Each value goes through the SplitMix64
+ * finalizer (MixSeed), so the order of values matters too. Not
+ * cryptographic: it catches divergence, not tampering.
+ */
+class StateHash {
+public:
+    void Add(uint64_t v) { h = MixSeed(h, v); }
+    void Add(int64_t v) { Add((uint64_t)v); }
+    void Add(int v) { Add((uint64_t)(int64_t)v); }
+    void Add(bool v) { Add((uint64_t)(v ? 1 : 0)); }
+
+    void Add(float v)
+    {
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        Add((uint64_t)bits);
+    }
+
+    void Add(double v)
+    {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        Add(bits);
+    }
+
+    /// Every element of an array, plus its length.
+    void Add(const float* values, size_t count)
+    {
+        Add((uint64_t)count);
+        for (size_t i = 0; i < count; ++i) Add(values[i]);
+    }
+
+    uint64_t Get() const { return h; }
+
+private:
+    uint64_t h = 0x5354415445ULL;   // "STATE"
+};
@@ -0,0 +1,172 @@
+#include "SweptCollision.h"
+#include "SimMath.h"
+#include <cmath>
+
+namespace
+{
+    constexpr int MAX_ITERATIONS = 32;
+
+    inline Vector2 Lerp(Vector2 a, Vector2 b, float t) { return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t }; }
+    inline float   Dot(Vector2 a, Vector2 b) { return a.x * b.x + a.y * b.y; }
+    inline float   Length(Vector2 v) { return sqrtf(v.x * v.x + v.y * v.y); }
+
+    void PoseBox(const BoxSweep& box, float t, SimMath::OrientedBox& out)
+    {
+        Vector2 center = Lerp(box.startCenter, box.endCenter, t);
+        float rot = box.startRotation + (box.endRotation - box.startRotation) * t;
+        SimMath::BuildOrientedBox(center, box.half, rot, out);
+    }
+
+    // Upper bound on how far any point of the box moves over the whole step
+    float MotionBound(const BoxSweep& box, Vector2& displacement)
+    {
+        displacement = { box.endCenter.x - box.startCenter.x, box.endCenter.y - box.startCenter.y };
+        float radius = Length(box.half);
+        return fabsf(box.endRotation - box.startRotation) * DEG2RAD * radius;
+    }
+
+    // Plain compares: fminf/fmaxf are library calls without -ffast-math
+    void ProjectOntoAxis(const Vector2 verts[4], Vector2 axis, float& outMin, float& outMax)
+    {
+        outMin = outMax = Dot(verts[0], axis);
+        for (int i = 1; i < 4; ++i) {
+            float p = Dot(verts[i], axis);
+            outMin = p < outMin ? p : outMin;
+            outMax = p > outMax ? p : outMax;
+        }
+    }
+}
+
+namespace
+{
+    // Cheap rejection before any box is posed. Also returns the bound on
+    // how fast the boxes can approach each other.
+    bool MayTouch(const BoxSweep& a, const BoxSweep& b, float& bound)
+    {
+        // -------------------- MOTION BOUND --------------------
+        // The distance between the boxes shrinks by at most this much per unit t
+        Vector2 moveA, moveB;
+        float spinA = MotionBound(a, moveA);
+        float spinB = MotionBound(b, moveB);
+        Vector2 relative = { moveA.x - moveB.x, moveA.y - moveB.y };
+        bound = Length(relative) + spinA + spinB;
+
+        // -------------------- BOUNDING CIRCLE EARLY-OUT --------------------
+        // The gap between bounding circles is also a distance lower bound and
+        // is much cheaper than SAT; most obstacle pairs stop here.
+        Vector2 startDelta = { a.startCenter.x - b.startCenter.x, a.startCenter.y - b.startCenter.y };
+        float circleGap = Length(startDelta) - Length(a.half) - Length(b.half);
+        return circleGap <= bound;
+    }
+
+    bool Advance(const BoxSweep& a, const SimMath::OrientedBox& aStart,
+        const BoxSweep& b, const SimMath::OrientedBox& bStart, float bound, SweptContact& out)
+    {
+        // -------------------- CONSERVATIVE ADVANCEMENT --------------------
+        // t = 0 uses the prebuilt poses; later iterations pose the boxes anew
+        SimMath::OrientedBox boxA = aStart, boxB = bStart;
+        Vector2 axis;
+        float t = 0.0f;
+
+        for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+            if (iter > 0) {
+                PoseBox(a, t, boxA);
+                PoseBox(b, t, boxB);
+            }
+
+            float gap = SweptCollision::SeparationGap(boxA, boxB, axis);
+            if (gap <= SweptCollision::CONTACT_TOLERANCE) {
+                out.toi = t;
+                out.normal = axis;
+
+                // Deepest vertex of A toward B
+                int deepest = 0;
+                for (int i = 1; i < 4; ++i) {
+                    if (Dot(boxA.verts[i], axis) < Dot(boxA.verts[deepest], axis)) deepest = i;
+                }
+                out.point = boxA.verts[deepest];
+                return true;
+            }
+
+            if (bound <= 0.0f) return false;
+
+            t += gap / bound;
+            if (t > 1.0f) return false;
+        }
+
+        // Did not converge (grazing contact): fall back to the end-of-step overlap
+        PoseBox(a, 1.0f, boxA);
+        PoseBox(b, 1.0f, boxB);
+        if (SweptCollision::SeparationGap(boxA, boxB, axis) > 0.0f) return false;
+
+        out.toi = 1.0f;
+        out.normal = axis;
+        out.point = boxA.center;
+        return true;
+    }
+}
+
+float SweptCollision::SeparationGap(const SimMath::OrientedBox& a, const SimMath::OrientedBox& b, Vector2& axisOut)
+{
+    // Face normals: 2 from A, 2 from B (cached unit axes)
+    const Vector2 axes[4] = { a.axes[0], a.axes[1], b.axes[0], b.axes[1] };
+
+    float best = -INFINITY;
+    axisOut = { 0.0f, -1.0f };
+
+    for (const Vector2& axis : axes) {
+        float minA, maxA, minB, maxB;
+        ProjectOntoAxis(a.verts, axis, minA, maxA);
+        ProjectOntoAxis(b.verts, axis, minB, maxB);
+
+        // Signed gap on this axis and the direction from B toward A
+        float gapAB = minA - maxB;  // A lies on the +axis side of B
+        float gapBA = minB - maxA;  // A lies on the -axis side of B
+        float gap = gapAB;
+        Vector2 dir = axis;
+        if (gapBA > gapAB) {
+            gap = gapBA;
+            dir = { -axis.x, -axis.y };
+        }
+
+        if (gap > best) {
+            best = gap;
+            axisOut = dir;
+        }
+    }
+    return best;
+}
+
+bool SweptCollision::Overlaps(const SimMath::OrientedBox& a, const SimMath::OrientedBox& b)
+{
+    const Vector2 axes[4] = { a.axes[0], a.axes[1], b.axes[0], b.axes[1] };
+
+    for (const Vector2& axis : axes) {
+        float minA, maxA, minB, maxB;
+        ProjectOntoAxis(a.verts, axis, minA, maxA);
+        ProjectOntoAxis(b.verts, axis, minB, maxB);
+
+        if (maxA < minB || maxB < minA) return false;   // separating axis
+    }
+    return true;
+}
+
+bool SweptCollision::SweepBoxes(const BoxSweep& a, const BoxSweep& b, SweptContact& out)
+{
+    float bound;
+    if (!MayTouch(a, b, bound)) return false;
+
+    SimMath::OrientedBox aStart, bStart;
+    PoseBox(a, 0.0f, aStart);
+    PoseBox(b, 0.0f, bStart);
+    return Advance(a, aStart, b, bStart, bound, out);
+}
+
+bool SweptCollision::SweepBoxes(const BoxSweep& a, const SimMath::OrientedBox& aStart,
+    const BoxSweep& b, const SimMath::OrientedBox& bStart, SweptContact& out)
+{
+    float bound;
+    if (!MayTouch(a, b, bound)) return false;
+
+    return Advance(a, aStart, b, bStart, bound, out);
+}
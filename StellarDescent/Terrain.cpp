@@ -0,0 +1,416 @@
+#include "Terrain.h"
+#include "Random.h"
+#include "StateHash.h"
+#include <cmath>
+
+namespace
+{
+    constexpr int MAX_ITERATIONS = 32;
+
+    inline Vector2 Lerp(Vector2 a, Vector2 b, float t) { return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t }; }
+
+    void PoseBox(const BoxSweep& box, float t, SimMath::OrientedBox& out)
+    {
+        Vector2 center = Lerp(box.startCenter, box.endCenter, t);
+        float rot = box.startRotation + (box.endRotation - box.startRotation) * t;
+        SimMath::BuildOrientedBox(center, box.half, rot, out);
+    }
+
+    inline float SmoothStep(float u) { return u * u * (3.0f - 2.0f * u); }
+
+    /**
+     * @brief Lower outline of a box (largest y at each x).
+     *
+     * Runs from the leftmost corner over the lowest one to the rightmost;
+     * for an unrotated box it is just the bottom edge (mid == left).
+     */
+    struct LowerChain {
+        Vector2 left, mid, right;
+
+        explicit LowerChain(const Vector2 v[4])
+        {
+            // Ties on x (vertical edges) keep the lower corner
+            int l = 0, r = 0;
+            for (int i = 1; i < 4; ++i) {
+                if (v[i].x < v[l].x || (v[i].x == v[l].x && v[i].y > v[l].y)) l = i;
+                if (v[i].x > v[r].x || (v[i].x == v[r].x && v[i].y > v[r].y)) r = i;
+            }
+
+            // Of the two other corners, the lower one is on this chain
+            int m = -1;
+            for (int i = 0; i < 4; ++i) {
+                if (i == l || i == r) continue;
+                if (m < 0 || v[i].y > v[m].y) m = i;
+            }
+
+            left = v[l];
+            right = v[r];
+            mid = (m >= 0 && v[m].x > left.x && v[m].x < right.x) ? v[m] : left;
+        }
+
+        float YAt(float x) const
+        {
+            Vector2 a = x <= mid.x ? left : mid;
+            Vector2 b = x <= mid.x ? mid : right;
+            if (b.x <= a.x) return a.y > b.y ? a.y : b.y;
+            return a.y + (b.y - a.y) * ((x - a.x) / (b.x - a.x));
+        }
+    };
+
+    /// Smoothed value noise in [0, 1] over lattice values @p lattice.
+    float ValueNoise(const std::vector<float>& lattice, float u)
+    {
+        int i = (int)u;
+        float f = u - (float)i;
+        return lattice[i] + (lattice[i + 1] - lattice[i]) * SmoothStep(f);
+    }
+}
+
+// -------------------- BUILDING --------------------
+void Terrain::Resize(float minX, float maxX, float sampleSpacing)
+{
+    spacing = sampleSpacing;
+    invSpacing = 1.0f / sampleSpacing;
+    originX = minX;
+
+    int count = (int)ceilf((maxX - minX) * invSpacing) + 1;
+    heights.assign(count < 2 ? 2 : count, 0.0f);
+}
+
+void Terrain::OnChanged()
+{
+    topY = NO_GROUND;
+    maxSlope = 0.0f;
+    for (size_t i = 0; i < heights.size(); ++i) {
+        topY = heights[i] < topY ? heights[i] : topY;
+        if (i > 0) {
+            float slope = fabsf(heights[i] - heights[i - 1]) * invSpacing;
+            maxSlope = slope > maxSlope ? slope : maxSlope;
+        }
+    }
+    revision++;
+
+    StateHash h;
+    h.Add(originX);
+    h.Add(spacing);
+    h.Add(heights.data(), heights.size());
+    hash = h.Get();
+}
+
+void Terrain::SetFlat(float minX, float maxX, float y, float sampleSpacing)
+{
+    Resize(minX, maxX, sampleSpacing);
+    for (float& h : heights) h = y;
+    OnChanged();
+}
+
+void Terrain::Clear()
+{
+    heights.clear();
+    OnChanged();
+}
+
+void Terrain::Shift(Vector2 delta)
+{
+    originX += delta.x;
+    for (float& h : heights) h += delta.y;
+    OnChanged();
+}
+
+void Terrain::Generate(const Settings& s, uint64_t seed)
+{
+    Resize(s.minX, s.maxX, s.spacing);
+    Pcg32 rng(seed, RngStream::TERRAIN);
+    const int count = GetSampleCount();
+
+    // -------------------- HILLS --------------------
+    // Two octaves of value noise; the second at half the wavelength and weight
+    const float wavelengths[2] = { s.hillWavelength, s.hillWavelength * 0.5f };
+    const float weights[2] = { 1.0f / 1.5f, 0.5f / 1.5f };
+    std::vector<float> lattice[2];
+    for (int o = 0; o < 2; ++o) {
+        int points = (int)ceilf((s.maxX - s.minX) / wavelengths[o]) + 2;
+        lattice[o].resize(points);
+        for (float& value : lattice[o]) value = rng.NextFloat();
+    }
+
+    for (int i = 0; i < count; ++i) {
+        float local = (float)i * spacing;
+        float hill = 0.0f;
+        for (int o = 0; o < 2; ++o) hill += weights[o] * ValueNoise(lattice[o], local / wavelengths[o]);
+        heights[i] = s.baseY - s.hillHeight * hill;
+    }
+
+    // -------------------- CRATERS --------------------
+    // Bowl below the local ground plus a rim around it; kept off the pad
+    const float padReach = s.padHalfWidth + s.padMargin + s.padBlend;
+    for (int c = 0; c < s.craterCount; ++c) {
+        float radius = rng.Range(s.craterMinRadius, s.craterMaxRadius);
+        float center = rng.Range(s.minX + radius, s.maxX - radius);
+        if (fabsf(center - s.padCenterX) < padReach + radius * 1.3f) continue;
+
+        for (int i = 0; i < count; ++i) {
+            float d = fabsf(GetSampleX(i) - center) / radius;
+            if (d < 1.0f) heights[i] += s.craterDepth * (1.0f - d * d);
+
+            float rim = (d - 1.0f) / 0.3f;
+            if (rim > -1.0f && rim < 1.0f) heights[i] -= s.craterDepth * 0.35f * (1.0f - rim * rim);
+        }
+    }
+
+    // -------------------- PAD PLATEAU --------------------
+    for (int i = 0; i < count; ++i) {
+        float dist = fabsf(GetSampleX(i) - s.padCenterX) - (s.padHalfWidth + s.padMargin);
+        float flat = dist <= 0.0f ? 1.0f : dist >= s.padBlend ? 0.0f : 1.0f - SmoothStep(dist / s.padBlend);
+        heights[i] += (s.baseY - heights[i]) * flat;
+    }
+
+    OnChanged();
+}
+
+// -------------------- QUERIES --------------------
+float Terrain::HeightAt(float x) const
+{
+    float f = (x - originX) * invSpacing;
+    float last = (float)(GetSampleCount() - 1);
+    if (!(f >= 0.0f && f <= last)) return NO_GROUND;
+
+    int i = (int)f;
+    if (i > GetSampleCount() - 2) i = GetSampleCount() - 2;
+    float u = f - (float)i;
+    return heights[i] + (heights[i + 1] - heights[i]) * u;
+}
+
+Vector2 Terrain::NormalAt(float x) const
+{
+    float f = (x - originX) * invSpacing;
+    float last = (float)(GetSampleCount() - 1);
+    if (!(f >= 0.0f && f <= last)) return { 0.0f, -1.0f };
+
+    int i = (int)f;
+    if (i > GetSampleCount() - 2) i = GetSampleCount() - 2;
+
+    // Surface y = h(x) with y down: the outward normal is (h', -1), normalized
+    float slope = (heights[i + 1] - heights[i]) * invSpacing;
+    float inv = 1.0f / sqrtf(1.0f + slope * slope);
+    return { slope * inv, -inv };
+}
+
+bool Terrain::SpanStats(float x0, float x1, float& top, float& slope) const
+{
+    float f0 = (x0 - originX) * invSpacing;
+    float f1 = (x1 - originX) * invSpacing;
+    int last = GetSampleCount() - 1;
+    if (f1 < 0.0f || f0 > (float)last) return false;
+
+    int first = f0 <= 0.0f ? 0 : (int)f0;
+    int end = f1 >= (float)last ? last : (int)f1 + 1;
+
+    top = heights[first];
+    slope = 0.0f;
+    for (int i = first + 1; i <= end; ++i) {
+        top = heights[i] < top ? heights[i] : top;
+        float s = fabsf(heights[i] - heights[i - 1]) * invSpacing;
+        slope = s > slope ? s : slope;
+    }
+    return true;
+}
+
+bool Terrain::IntersectSegment(Vector2 a, Vector2 b, float& t, Vector2& normal) const
+{
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+
+    // -------------------- VERTICAL SEGMENT --------------------
+    if (fabsf(dx) < 1e-6f) {
+        float h = HeightAt(a.x);
+        if (h == NO_GROUND) return false;
+        if (a.y >= h) t = 0.0f;
+        else if (b.y >= h) t = (h - a.y) / dy;
+        else return false;
+
+        normal = NormalAt(a.x);
+        return true;
+    }
+
+    // -------------------- CLIP TO THE TERRAIN --------------------
+    float sA = (GetMinX() - a.x) / dx;
+    float sB = (GetMaxX() - a.x) / dx;
+    float s0 = sA < sB ? sA : sB;
+    float s1 = sA < sB ? sB : sA;
+    s0 = s0 > 0.0f ? s0 : 0.0f;
+    s1 = s1 < 1.0f ? s1 : 1.0f;
+    if (s0 > s1) return false;
+
+    // -------------------- WALK THE COLUMNS --------------------
+    // Between two sample columns both the segment and the surface are
+    // linear, so the height difference is too and its root is exact
+    // (clip points are clamped so rounding cannot push them off the edge)
+    auto gapAt = [&](float s, float h) { return (a.y + dy * s) - h; };
+    auto heightOn = [&](float s) {
+        float x = a.x + dx * s;
+        x = x < GetMinX() ? GetMinX() : x > GetMaxX() ? GetMaxX() : x;
+        return HeightAt(x);
+    };
+
+    float s = s0;
+    float g = gapAt(s, heightOn(s));
+    if (g >= 0.0f) {
+        t = s;
+        normal = NormalAt(a.x + dx * s);
+        return true;
+    }
+
+    float f0 = (a.x + dx * s0 - originX) * invSpacing;
+    float f1 = (a.x + dx * s1 - originX) * invSpacing;
+    int step = dx > 0.0f ? 1 : -1;
+    int k = dx > 0.0f ? (int)floorf(f0) + 1 : (int)ceilf(f0) - 1;
+    int kEnd = dx > 0.0f ? (int)floorf(f1) : (int)ceilf(f1);
+
+    for (;; k += step) {
+        bool atEnd = dx > 0.0f ? k > kEnd : k < kEnd;
+
+        float sNext, gNext;
+        if (atEnd) {
+            sNext = s1;
+            gNext = gapAt(s1, heightOn(s1));
+        }
+        else {
+            sNext = (GetSampleX(k) - a.x) / dx;
+            gNext = gapAt(sNext, heights[k]);
+        }
+
+        if (gNext >= 0.0f) {
+            t = s + (sNext - s) * (g / (g - gNext));
+            normal = NormalAt(a.x + dx * t);
+            return true;
+        }
+        if (atEnd) return false;
+
+        s = sNext;
+        g = gNext;
+    }
+}
+
+float Terrain::Clearance(const SimMath::OrientedBox& box, Vector2& pointOut) const
+{
+    const LowerChain chain(box.verts);
+
+    float best = NO_GROUND;
+    auto consider = [&](float x, float y, float ground) {
+        float gap = ground - y;
+        if (gap < best) {
+            best = gap;
+            pointOut = { x, y };
+        }
+    };
+
+    // Chain corners (where the outline bends)...
+    const Vector2 corners[3] = { chain.left, chain.mid, chain.right };
+    for (const Vector2& c : corners) {
+        float h = HeightAt(c.x);
+        if (h != NO_GROUND) consider(c.x, c.y, h);
+    }
+
+    // ...and the samples under the box (where the surface bends)
+    float f0 = (chain.left.x - originX) * invSpacing;
+    float f1 = (chain.right.x - originX) * invSpacing;
+    int first = f0 <= 0.0f ? 0 : (int)ceilf(f0);
+    int last = f1 >= (float)(GetSampleCount() - 1) ? GetSampleCount() - 1 : (int)floorf(f1);
+    for (int i = first; i <= last; ++i) {
+        float x = GetSampleX(i);
+        consider(x, chain.YAt(x), heights[i]);
+    }
+
+    return best;
+}
+
+bool Terrain::SweepBox(const BoxSweep& sweep, const SimMath::OrientedBox& start, SweptContact& out) const
+{
+    if (heights.empty()) return false;
+
+    // -------------------- MOTION BOUND --------------------
+    float radius = sqrtf(sweep.half.x * sweep.half.x + sweep.half.y * sweep.half.y);
+    float moveX = fabsf(sweep.endCenter.x - sweep.startCenter.x);
+    float moveY = fabsf(sweep.endCenter.y - sweep.startCenter.y);
+    float spin = fabsf(sweep.endRotation - sweep.startRotation) * DEG2RAD * radius;
+
+    float x0 = (sweep.startCenter.x < sweep.endCenter.x ? sweep.startCenter.x : sweep.endCenter.x) - radius;
+    float x1 = (sweep.startCenter.x < sweep.endCenter.x ? sweep.endCenter.x : sweep.startCenter.x) + radius;
+    float top, slope;
+    if (!SpanStats(x0, x1, top, slope)) return false;
+
+    // -------------------- EARLY-OUT --------------------
+    // Most steps end well above the highest ground under the sweep
+    float lowest = (sweep.startCenter.y > sweep.endCenter.y ? sweep.startCenter.y : sweep.endCenter.y) + radius;
+    if (lowest < top - SweptCollision::CONTACT_TOLERANCE) return false;
+
+    // The vertical gap shrinks by at most this much per unit t: own vertical
+    // motion, plus the ground rising under horizontal motion
+    float bound = moveY + slope * moveX + spin * (1.0f + slope);
+
+    // Across an edge of the terrain the gap jumps as the box moves over
+    // ground, so the bound above does not hold there
+    bool acrossEdge = x0 < GetMinX() || x1 > GetMaxX();
+
+    // -------------------- CONSERVATIVE ADVANCEMENT --------------------
+    SimMath::OrientedBox box = start;
+    Vector2 point = start.center;
+    float t = 0.0f;
+
+    for (int iter = 0; iter < MAX_ITERATIONS; ++iter) {
+        if (iter > 0) PoseBox(sweep, t, box);
+
+        float gap = Clearance(box, point);
+        if (gap <= SweptCollision::CONTACT_TOLERANCE) {
+            out.toi = t;
+            out.normal = NormalAt(point.x);
+            out.point = point;
+            return true;
+        }
+
+        if (acrossEdge) return March(sweep, t, out);
+        if (bound <= 0.0f) return false;
+
+        t += gap / bound;
+        if (t > 1.0f) return false;
+    }
+
+    // Sliding along a slope keeps the gap small without closing it
+    return March(sweep, t, out);
+}
+
+bool Terrain::March(const BoxSweep& sweep, float from, SweptContact& out) const
+{
+    // Nothing touches before @p from: step through the rest of the sweep
+    // and bisect down to the first touching pose
+    const int marchSteps = 64;
+    SimMath::OrientedBox box;
+    Vector2 point;
+    float safe = from;
+
+    for (int k = 1; k <= marchSteps; ++k) {
+        float next = from + (1.0f - from) * ((float)k / marchSteps);
+        PoseBox(sweep, next, box);
+        if (Clearance(box, point) > SweptCollision::CONTACT_TOLERANCE) {
+            safe = next;
+            continue;
+        }
+
+        float hit = next;
+        for (int b = 0; b < 16; ++b) {
+            float midT = (safe + hit) * 0.5f;
+            PoseBox(sweep, midT, box);
+            if (Clearance(box, point) > SweptCollision::CONTACT_TOLERANCE) safe = midT;
+            else hit = midT;
+        }
+
+        PoseBox(sweep, hit, box);
+        Clearance(box, point);
+        out.toi = hit;
+        out.normal = NormalAt(point.x);
+        out.point = point;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+#include "SimMath.h"
+#include "SweptCollision.h"
+
+/**
+ * @brief Procedural heightfield ground: one height per column of samples.
+ *
+ * The surface is the polyline through (originX + i * spacing, height[i]),
+ * with heights in world y (down is +y, so smaller means higher ground).
+ * Everything below it is solid. Outside [GetMinX(), GetMaxX()] there is no
+ * ground at all, like the old fixed strip.
+ *
+ * Lookups are O(1) (the column index is computed, not searched), and the
+ * box and segment tests only read the handful of samples under the query,
+ * so the cost does not depend on how wide the level is.
+ */
+class Terrain {
+public:
+    /// Height returned where there is no ground (beyond either edge)
+    static constexpr float NO_GROUND = 1e30f;
+
+    struct Settings {
+        float minX = -1000.0f;
+        float maxX = 1000.0f;
+        float spacing = 8.0f;         // px between samples
+        float baseY = 310.0f;         // flat ground level, the pad sits here
+
+        // Hills: two octaves of smoothed value noise, heights above baseY
+        float hillHeight = 40.0f;
+        float hillWavelength = 320.0f;
+
+        // Craters: bowls with a raised rim
+        int   craterCount = 3;
+        float craterMinRadius = 40.0f;
+        float craterMaxRadius = 90.0f;
+        float craterDepth = 30.0f;    // px below the surrounding ground
+
+        // Pad plateau: flat at baseY over the pad, blended into the hills
+        float padCenterX = 0.0f;
+        float padHalfWidth = 50.0f;
+        float padMargin = 40.0f;      // flat shoulder on each side of the pad
+        float padBlend = 80.0f;       // px over which the hills fade back in
+    };
+
+    /// Flat ground at @p y over [minX, maxX].
+    void SetFlat(float minX, float maxX, float y, float spacing = 8.0f);
+
+    /// Build hills, craters and the pad plateau from @p seed.
+    void Generate(const Settings& settings, uint64_t seed);
+
+    /// No ground anywhere (open space, e.g. Endless Descent).
+    void Clear();
+
+    /// Move the whole surface by @p delta (floating-origin rebase).
+    void Shift(Vector2 delta);
+
+    // -------------------- SAMPLES --------------------
+    int GetSampleCount() const { return (int)heights.size(); }
+    float GetSample(int i) const { return heights[i]; }
+    const float* GetSamples() const { return heights.data(); }
+    float GetSampleX(int i) const { return originX + (float)i * spacing; }
+    float GetSpacing() const { return spacing; }
+    float GetMinX() const { return originX; }
+    float GetMaxX() const { return originX + (float)(GetSampleCount() - 1) * spacing; }
+
+    /// Highest ground (smallest y) anywhere on the terrain.
+    float GetTopY() const { return topY; }
+
+    /// Largest |dy/dx| of any segment.
+    float GetMaxSlope() const { return maxSlope; }
+
+    /// Bumped whenever the samples change (renderers rebuild their mesh on it).
+    uint32_t GetRevision() const { return revision; }
+
+    /// Hash of the samples and their placement (determinism checks).
+    uint64_t GetHash() const { return hash; }
+
+    // -------------------- QUERIES --------------------
+    /// Ground height at @p x (linear between samples), NO_GROUND off the edges.
+    float HeightAt(float x) const;
+
+    /// Unit surface normal at @p x, pointing out of the ground.
+    Vector2 NormalAt(float x) const;
+
+    /// Vertical distance from @p p down to the ground (negative when below it).
+    float AltitudeAt(Vector2 p) const { return HeightAt(p.x) - p.y; }
+
+    /**
+     * @brief First point where the segment a -> b meets the surface.
+     *
+     * Walks only the columns between a.x and b.x. A segment that starts
+     * below the surface hits at t = 0.
+     *
+     * @param t      Fraction along the segment (0..1)
+     * @param normal Surface normal at the hit
+     */
+    bool IntersectSegment(Vector2 a, Vector2 b, float& t, Vector2& normal) const;
+
+    /**
+     * @brief Smallest vertical gap between a posed box and the ground.
+     *
+     * The gap between the box's lower outline and the surface is piecewise
+     * linear in x, so its minimum lies at a box corner or at a sample under
+     * the box; only those are evaluated. Negative when the box dips into
+     * the ground. NO_GROUND when there is no ground under the box.
+     *
+     * @param pointOut Lowest box point at the minimum (on the box outline)
+     */
+    float Clearance(const SimMath::OrientedBox& box, Vector2& pointOut) const;
+
+    /// Discrete overlap test (touching counts).
+    bool Overlaps(const SimMath::OrientedBox& box) const
+    {
+        Vector2 p;
+        return Clearance(box, p) <= 0.0f;
+    }
+
+    /**
+     * @brief First time in [0, 1] at which the moving box touches the ground.
+     *
+     * Conservative advancement on Clearance(), as SweptCollision does for
+     * box pairs; the slope bound only covers the columns the sweep spans.
+     * Sweeps across an edge of the terrain, and grazing slides that do not
+     * converge, are stepped in 1/64ths of the sweep instead.
+     * normal is the surface normal at the contact (pointing up out of the
+     * ground), point is the box point that touched.
+     */
+    bool SweepBox(const BoxSweep& sweep, const SimMath::OrientedBox& start, SweptContact& out) const;
+
+private:
+    std::vector<float> heights;
+    float originX = 0.0f;
+    float spacing = 8.0f;
+    float invSpacing = 1.0f / 8.0f;
+    float topY = NO_GROUND;
+    float maxSlope = 0.0f;
+    uint32_t revision = 0;
+    uint64_t hash = 0;
+
+    void Resize(float minX, float maxX, float sampleSpacing);
+    void OnChanged();
+
+    /// Highest ground and steepest segment over the columns covering [x0, x1];
+    /// false when there is no ground there.
+    bool SpanStats(float x0, float x1, float& top, float& slope) const;
+
+    /// Fixed substeps over [from, 1], then bisection to the first contact.
+    bool March(const BoxSweep& sweep, float from, SweptContact& out) const;
+};
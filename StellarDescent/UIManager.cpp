@@ -1,8 +1,10 @@
 ﻿#include "UIManager.h"
+#include "GameAssets.h"
+#include "Terrain.h"
 #include "raylib.h"
 #include <cmath>
 
-void UIManager::Init() {
+void UIManager::Init(GameAssets& assets) {
     // -------------------- LOAD FONT --------------------
     int asciiCount = 95;
     int arrowsCount = 4;
@@ -18,15 +20,36 @@ void UIManager::Init() {
     codes[asciiCount + 2] = 0x2192;
     codes[asciiCount + 3] = 0x2193;
 
-    unicode = LoadFontEx("assets/fonts/NotoSansSymbols-ExtraBold.ttf", 256, codes, total);
-    title = LoadFontEx("assets/fonts/Monlight.otf", 64, nullptr, 0);
+    unicode = assets.LoadFont("fonts/NotoSansSymbols-ExtraBold.ttf", 256, codes, total);
+    title = assets.LoadFont("fonts/Monlight.otf", 64, nullptr, 0);
 
     free(codes);
 }
 
+void UIManager::DrawLoading(float progress) {
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+
+    const int barWidth = 400;
+    const int barHeight = 8;
+    int x = screenWidth / 2 - barWidth / 2;
+    int y = screenHeight / 2;
+
+    DrawText("Loading", screenWidth / 2 - MeasureText("Loading", 20) / 2, y - 40, 20, RAYWHITE);
+    DrawRectangleLines(x - 2, y - 2, barWidth + 4, barHeight + 4, GRAY);
+    DrawRectangle(x, y, (int)(barWidth * progress), barHeight, RAYWHITE);
+}
+
 void UIManager::DrawHUD(float fuel, float altitude, float timer) {
     DrawText(TextFormat("Fuel: %.0f", fuel), 20, 20, 20, RAYWHITE);
-    DrawText(TextFormat("Altitude: %.1f", altitude), 20, 50, 20, RAYWHITE);
+    if (altitude >= Terrain::NO_GROUND) DrawText("Altitude: --", 20, 50, 20, RAYWHITE);
+    else DrawText(TextFormat("Altitude: %.1f", altitude), 20, 50, 20, RAYWHITE);
+    DrawText(TextFormat("Time: %.1f", timer), 20, 80, 20, RAYWHITE);
+}
+
+void UIManager::DrawEndlessHUD(float fuel, double depth, float timer) {
+    DrawText(TextFormat("Fuel: %.0f", fuel), 20, 20, 20, RAYWHITE);
+    DrawText(TextFormat("Depth: %.0f", depth > 0.0 ? depth : 0.0), 20, 50, 20, RAYWHITE);
     DrawText(TextFormat("Time: %.1f", timer), 20, 80, 20, RAYWHITE);
 }
 
@@ -88,6 +111,14 @@ void UIManager::DrawMenu(const std::string& difficultyLabel,
 
     int infoWidth = MeasureText(info.c_str(), infoFontSize);
 
+    const char* endlessText = "Press [E] for Endless Descent";
+    int endlessWidth = MeasureText(endlessText, infoFontSize);
+    DrawText(endlessText,
+        screenWidth - endlessWidth - 20,
+        screenHeight - 2 * infoFontSize - 30,
+        infoFontSize,
+        RAYWHITE);
+
     DrawText(info.c_str(),
         screenWidth - infoWidth - 20,
         screenHeight - infoFontSize - 20,
@@ -103,10 +134,16 @@ void UIManager::DrawWin(float score) {
     DrawText("Press [M] to return to Main Menu", 440, 470, 20, WHITE);
 }
 
-void UIManager::DrawCrash() {
+void UIManager::DrawCrash(bool canRewind) {
     DrawText("You Crashed!", 530, 300, 40, RED);
     DrawText("Press [R] to Restart Level", 480, 360, 20, WHITE);
     DrawText("Press [M] to return to Main Menu", 440, 390, 20, WHITE);
+    if (canRewind) DrawText("Hold [BACKSPACE] to Rewind", 475, 420, 20, WHITE);
+}
+
+void UIManager::DrawRewind(float seconds) {
+    DrawText("<< REWIND", 20, 110, 20, SKYBLUE);
+    DrawText(TextFormat("%.1f s left", seconds), 140, 110, 20, SKYBLUE);
 }
 
 void UIManager::DrawPause() {
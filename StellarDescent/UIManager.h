@@ -2,6 +2,8 @@
 #include "raylib.h"
 #include <string>
 
+class GameAssets;
+
 /**
  * @brief Handles all on-screen user interface (UI) elements.
  *
@@ -15,13 +17,23 @@ public:
     Font unicode;
     Font title;
 
-    void Init();
+    void Init(GameAssets& assets);
+
+    /**
+     * @brief Draw the loading screen shown while cooked assets stream in.
+     *
+     * @param progress Fraction streamed, 0..1
+     *
+     * Uses raylib's built-in font only, since the game's fonts are not loaded yet.
+     */
+    void DrawLoading(float progress);
 
     /**
      * @brief Draw the in-game HUD (Heads-Up Display).
      *
      * @param fuel Current fuel level of the rocket
-     * @param altitude Current altitude of the rocket
+     * @param altitude Height of the rocket above the terrain below it
+     *                 (Terrain::NO_GROUND beyond the terrain's edge)
      * @param timer Total elapsed flight time in seconds
      *
      * Draws text elements in the top-left corner of the screen to give the player
@@ -29,6 +41,13 @@ public:
      */
     void DrawHUD(float fuel, float altitude, float timer);
 
+    /**
+     * @brief Draw the Endless Descent HUD (fuel, depth, time).
+     *
+     * @param depth Distance below the starting point in pixels
+     */
+    void DrawEndlessHUD(float fuel, double depth, float timer);
+
     /**
      * @brief Draw the main menu screen.
      *
@@ -51,9 +70,18 @@ public:
     /**
      * @brief Draw the crash/fail screen.
      *
+     * @param canRewind Whether to offer rewinding (levels with rewind history)
+     *
      * Typically called when GameState is CRASH. Shows crash message and restart instructions.
      */
-    void DrawCrash();
+    void DrawCrash(bool canRewind);
+
+    /**
+     * @brief Draw the rewind indicator while the run plays backwards.
+     *
+     * @param seconds Rewind history left in seconds
+     */
+    void DrawRewind(float seconds);
 
     /**
      * @brief Draw the pause menu overlay.
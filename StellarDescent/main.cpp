@@ -1,58 +1,184 @@
 ﻿#include "raylib.h"
-#include "Rocket.h"
 #include "UIManager.h"
 #include "AudioSystem.h"
 #include "CameraController.h"
-#include "PhysicsSystem.h"
+#include "EndlessWorld.h"
+#include "FileWatcher.h"
+#include "GameAssets.h"
 #include "GameStateManager.h"
-#include "Planet.h"
-#include "MovingObstacle.h"
 #include "LevelManager.h"
+#include "ParticleSystem.h"
+#include "Replay.h"
+#include "RewindBuffer.h"
+#include "SceneRenderer.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+#include "KeyboardInput.h"
 
-#include <vector>
 #include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <string>
 
 int main() {
     const int SCREEN_WIDTH = 1280;
     const int SCREEN_HEIGHT = 720;
+    const int SIM_TICK_RATE = SimulationClock::DEFAULT_TICK_RATE; // fixed physics ticks per second (stellar_verify accepts no other)
+
+    // World-space rectangle a camera shows on screen
+    auto cameraView = [&](const Camera2D& camera) {
+        Rectangle view;
+        view.width = SCREEN_WIDTH / camera.zoom;
+        view.height = SCREEN_HEIGHT / camera.zoom;
+        view.x = camera.target.x - camera.offset.x / camera.zoom;
+        view.y = camera.target.y - camera.offset.y / camera.zoom;
+        return view;
+    };
 
     // -------------------- INITIALIZATION --------------------
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Stellar Descent");
     SetExitKey(0); // Disable default ESC exit
     SetTargetFPS(60);
 
-    // Rocket + planet (planet will be overridden by LevelManager)
-    Rocket rocket({ 0, -200 });
-    Planet planet = { 0.0f, Rectangle{ 0, 310, 100, 10 } };
+    // World state (rocket, pad, obstacles); LevelManager fills it in
+    Simulation sim;
+    Rocket& rocket = sim.rocket;
 
     UIManager ui;
     AudioSystem audio;
     CameraController cam;
-    PhysicsSystem physics;
+    SceneRenderer renderer;
+    SimulationClock simClock(SIM_TICK_RATE);
+    KeyboardInput keyboard;
+    ParticleSystem particles;
+    int thrustEmitter = particles.AddEmitter(EmitterType::THRUST);
+
+    // -------------------- ASSETS --------------------
+    // The cooked archive (asset_cook) streams in on a worker thread behind a
+    // loading screen and needs no decoding; without it the loose files load
+    const char* ASSET_ARCHIVE_PATH = "assets/assets.sdpak";
+    GameAssets assets;
+    std::string assetError;
+    if (std::filesystem::exists(ASSET_ARCHIVE_PATH) && !assets.Open(ASSET_ARCHIVE_PATH, &assetError)) {
+        TraceLog(LOG_WARNING, "ASSETS: %s, loading loose files", assetError.c_str());
+    }
+    while (assets.IsStreaming() && !WindowShouldClose()) {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        ui.DrawLoading(assets.GetProgress());
+        EndDrawing();
+    }
 
-    ui.Init();
-    audio.Init();
+    ui.Init(assets);
+    audio.Init(assets);
     cam.Init(rocket.position);
     cam.camera.offset = { SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f };
 
-    Texture2D starfield = LoadTexture("assets/textures/starfield.png");
+    Texture2D starfield = assets.LoadTexture("textures/starfield.png");
+    TraceLog(LOG_INFO, "ASSETS: %d cooked, %d loose", assets.GetCookedCount(), assets.GetLooseCount());
     float parallaxFactor = 0.3f;
 
     GameState state = GameState::MENU;
-    float timer = 0.0f;
-    float score = 0.0f;
-    bool  startGame = false;
 
     // -------------------- LEVELS / OBSTACLES --------------------
-    std::vector<MovingObstacle> obstacles;
-    LevelManager levelManager;
-    levelManager.Init(rocket, planet, obstacles); // applies starting difficulty + level
+    // New layouts every session, like raylib's time-seeded generator
+    LevelManager levelManager((uint64_t)time(nullptr));
+
+    // Presets come from the compiled pack when there is one (level_pack
+    // builds it from assets/levels/levels.txt), else the built-in ones
+    const char* LEVEL_PACK_PATH = "assets/levels/levels.sdpack";
+    std::string packError;
+    if (std::filesystem::exists(LEVEL_PACK_PATH) && !levelManager.LoadPack(LEVEL_PACK_PATH, &packError)) {
+        TraceLog(LOG_WARNING, "LEVELS: %s, using built-in presets", packError.c_str());
+    }
+    levelManager.Init(sim); // applies starting difficulty + level
+
+    // Hot reload: a recompiled pack replaces the presets in place
+    FileWatcher packWatcher(LEVEL_PACK_PATH);
+
+    // -------------------- ENDLESS DESCENT --------------------
+    EndlessWorld endless;
+    bool endlessMode = false;
+    uint64_t endlessSeed = 0;
+
+    // Fixed levels clamp the camera; endless mode lifts the clamp (the
+    // floating origin keeps positions within a few chunks of zero)
+    const Vector2 levelMinScroll = cam.minScroll;
+    const Vector2 levelMaxScroll = cam.maxScroll;
+    const float endlessScroll = EndlessWorld::REBASE_DISTANCE + 2.0f * EndlessWorld::CHUNK_SIZE;
+
+    // Starfield offset carried across rebases so the background does not jump
+    Vector2 parallaxShift = { 0, 0 };
+
+    auto startEndless = [&]() {
+        endless.Begin(sim, endlessSeed);
+        sim.ResetRun();
+        particles.Clear();
+        cam.minScroll = { -endlessScroll, -endlessScroll };
+        cam.maxScroll = { endlessScroll, endlessScroll };
+        cam.Init(rocket.position);
+        cam.camera.offset = { SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f };
+    };
+    auto leaveEndless = [&]() {
+        if (!endlessMode) return;
+        endlessMode = false;
+        cam.minScroll = levelMinScroll;
+        cam.maxScroll = levelMaxScroll;
+        levelManager.RestartCurrentLevel(sim);
+        particles.Clear();
+    };
+
+    // -------------------- REPLAYS --------------------
+    // Every run is recorded and saved to replays/ when it ends or is abandoned
+    ReplayRecorder recorder;
+    int replayCount = 0;
+
+    auto saveReplay = [&]() {
+        if (!recorder.IsRecording()) return;
+        const Replay& replay = recorder.Finish(sim);
+        if (replay.tickCount == 0) return;
+
+        std::error_code ec;
+        std::filesystem::create_directories("replays", ec);
+
+        char stamp[32];
+        time_t now = time(nullptr);
+        strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+        char path[64];
+        snprintf(path, sizeof(path), "replays/%s-%d.sdr", stamp, replayCount++);
+        replay.Save(path);
+    };
+
+    // -------------------- REWIND --------------------
+    // Practice aid on levels: holding BACKSPACE plays the run backwards and
+    // letting go carries on from there. A rewound run is no longer recorded.
+    RewindBuffer::Settings rewindSettings;
+    rewindSettings.tickRate = SIM_TICK_RATE;
+    RewindBuffer rewind(rewindSettings);
+    bool rewinding = false;
 
     // -------------------- GAME LOOP --------------------
     while (!WindowShouldClose()) {
         float dt = GetFrameTime();
         audio.Update();
 
+        // ----------------- LEVEL PACK RELOAD -----------------
+        // A run in progress keeps its world; the menu shows the new one at
+        // once and every later build or restart uses it
+        if (packWatcher.Update(dt)) {
+            if (levelManager.LoadPack(LEVEL_PACK_PATH, &packError)) {
+                TraceLog(LOG_INFO, "LEVELS: reloaded %s (%d levels)", LEVEL_PACK_PATH, levelManager.GetLevelCount());
+                if (state == GameState::MENU) {
+                    levelManager.SetPreset(levelManager.GetDifficultyIndex(), levelManager.GetLevelIndex(), sim);
+                    sim.ResetRun();
+                }
+            }
+            else {
+                TraceLog(LOG_WARNING, "LEVELS: reload failed, keeping current presets: %s", packError.c_str());
+            }
+        }
+
         // ----------------- AUDIO CONTROLS -----------------
         if (IsKeyPressed(KEY_ZERO)) {
             audio.ToggleMute();
@@ -70,7 +196,36 @@ int main() {
             // ----- MENU -----
         case GameState::MENU:
         {
-            levelManager.HandleMenu(state, rocket, planet, obstacles, timer, startGame);
+            // 1/2/3 change difficulty, LEFT/RIGHT change level. The level
+            // is built on the worker thread and swapped in once it is done.
+            int difficulty = levelManager.GetSelectedDifficultyIndex();
+            int level = levelManager.GetSelectedLevelIndex();
+            const int levelCount = levelManager.GetLevelCount();
+            bool changed = false;
+            if (IsKeyPressed(KEY_ONE))   { difficulty = 0; changed = true; }
+            if (IsKeyPressed(KEY_TWO))   { difficulty = 1; changed = true; }
+            if (IsKeyPressed(KEY_THREE)) { difficulty = 2; changed = true; }
+
+            if (IsKeyPressed(KEY_LEFT))  { level = (level + levelCount - 1) % levelCount; changed = true; }
+            if (IsKeyPressed(KEY_RIGHT)) { level = (level + 1) % levelCount; changed = true; }
+
+            if (changed) levelManager.Prebuild(difficulty, level);
+            levelManager.SwapInPrebuilt(sim, false);
+
+            // ENTER starts the selected level (waiting for it if still building)
+            if (IsKeyPressed(KEY_ENTER)) {
+                if (!levelManager.SwapInPrebuilt(sim, true)) sim.ResetRun();
+                state = GameState::PLAYING;
+            }
+
+            // E starts Endless Descent on a fresh world
+            if (IsKeyPressed(KEY_E)) {
+                levelManager.CancelPrebuild();
+                endlessMode = true;
+                endlessSeed = (uint64_t)time(nullptr);
+                startEndless();
+                state = GameState::PLAYING;
+            }
 
             if (IsKeyPressed(KEY_Q)) {
                 CloseWindow();
@@ -82,100 +237,97 @@ int main() {
         case GameState::PLAYING:
         {
             if (IsKeyPressed(KEY_ESCAPE)) state = GameState::PAUSED;
-            if (IsKeyPressed(KEY_UP))     startGame = true;
-            if (startGame) {
-                timer += dt;
-            }
-
-            rocket.Update(dt);
-            cam.Update(rocket.position, dt);
 
             if (IsKeyDown(KEY_UP)) audio.PlayThrust(true);
 
-            // Update obstacles
-            for (auto& o : obstacles) {
-                o.Update(dt);
-            }
-
-            // -------------------- COLLISION LOGIC --------------------
-            {
-                Rectangle groundRect = { -1000, 310, 2000, 400 };
-                Rectangle rocketRect = { rocket.position.x - 5, rocket.position.y - 15, 10, 30 };
+            simClock.Advance(dt);
 
-                bool onPad = CheckCollisionRecs(rocketRect, planet.landingPad);
-                bool hitsGround = CheckCollisionRecs(rocketRect, groundRect);
-
-                // -------------------- VIEW RECTANGLE --------------------
-                Rectangle viewRect;
-                viewRect.width = SCREEN_WIDTH / cam.camera.zoom;
-                viewRect.height = SCREEN_HEIGHT / cam.camera.zoom;
-                viewRect.x = cam.camera.target.x - viewRect.width / 2.0f;
-                viewRect.y = cam.camera.target.y - viewRect.height / 2.0f;
-
-                const float margin = 40.0f;
-                viewRect.x -= margin;
-                viewRect.y -= margin;
-                viewRect.width += margin * 2.0f;
-                viewRect.height += margin * 2.0f;
-
-                // -------------------- OBSTACLE COLLISION --------------------
-                bool hitsObstacle = false;
+            // -------------------- REWIND --------------------
+            // One tick back per tick of real time, until the history runs out
+            rewinding = state == GameState::PLAYING && !endlessMode &&
+                IsKeyDown(KEY_BACKSPACE) && rewind.GetFrameCount() > 0;
+            if (rewinding) {
+                recorder.Cancel();
+                while (simClock.ConsumeTick() && rewind.StepBack(sim) > 0) {
+                    cam.Update(rocket.position, simClock.GetTickDt());
+                }
+            }
 
-                // Rocket as an oriented box (10x30, centered at rocket.position)
-                Vector2 rocketCenter = rocket.position;
-                Vector2 rocketHalfExtents = { 5.0f, 15.0f };
+            // -------------------- FIXED-STEP SIMULATION --------------------
+            // Physics always advances in SIM_TICK_RATE steps, independent of
+            // the render frame rate. Stop stepping as soon as the run ends.
+            while (!rewinding && state == GameState::PLAYING && simClock.ConsumeTick()) {
+                float tickDt = simClock.GetTickDt();
+
+                // Obstacles on screen are always posed at full rate
+                sim.activity.SetView(cameraView(cam.camera));
+
+                ControlInput input = keyboard.Poll();
+
+                // A fresh run starts a fresh recording
+                if (!recorder.IsRecording() && sim.GetTickCount() == 0) {
+                    ReplayHeader header;
+                    header.mode = endlessMode ? ReplayMode::ENDLESS : ReplayMode::LEVEL;
+                    header.difficulty = levelManager.GetDifficultyIndex();
+                    header.level = levelManager.GetLevelIndex();
+                    header.seed = endlessMode ? endlessSeed : levelManager.GetLayoutSeed();
+                    header.pack = endlessMode ? 0 : levelManager.GetPackHash();
+                    header.tickRate = SIM_TICK_RATE;
+                    recorder.Begin(header);
+                }
+                recorder.Record(input, sim, endlessMode ? &endless : nullptr);
 
-                for (const auto& o : obstacles) {
-                    if (!o.IsNear(viewRect)) continue;
+                // ...and a fresh rewind history
+                if (!endlessMode) {
+                    if (sim.GetTickCount() == 0) rewind.Clear();
+                    rewind.Push(sim);
+                }
 
-                    if (o.CheckCollisionOBB(rocketCenter, rocketHalfExtents, rocket.rotation)) {
-                        hitsObstacle = true;
-                        break;
+                SimEvent event = sim.Step(input, tickDt);
+
+                // Stream chunks around the rocket; a rebase moves everything
+                // the simulation does not own by the same amount
+                if (endlessMode) {
+                    Vector2 shift = endless.Update(sim);
+                    if (shift.x != 0.0f || shift.y != 0.0f) {
+                        cam.Shift(shift);
+                        particles.Shift(shift);
+                        parallaxShift.x = fmodf(parallaxShift.x - shift.x * parallaxFactor, (float)starfield.width);
+                        parallaxShift.y = fmodf(parallaxShift.y - shift.y * parallaxFactor, (float)starfield.height);
                     }
                 }
 
-                if (hitsObstacle) {
+                cam.Update(rocket.position, tickDt);
+
+                // -------------------- OUTCOME --------------------
+                if (event != SimEvent::NONE) saveReplay();
+                switch (event) {
+                case SimEvent::LANDED:
+                    state = GameState::WIN;
+                    // Build the next level while the player reads the score
+                    if (!endlessMode) levelManager.PrebuildNextLevel();
+                    audio.PlayLand();
+                    particles.Burst(EmitterType::LANDING_DUST, { rocket.position.x, Simulation::GROUND_Y });
+                    break;
+                case SimEvent::CRASHED_OBSTACLE:
                     state = GameState::CRASH;
                     audio.PlayCrash();
-                    rocket.velocity = { 0, 0 };
-                }
-                else if (hitsGround) {
-                    if (onPad) {
-                        float padCenterX = planet.landingPad.x + planet.landingPad.width / 2.0f;
-                        float rocketCenterX = rocket.position.x;
-                        float horizontalTolerance = planet.landingPad.width / 2.0f - 5;
-
-                        bool  withinPadHoriz = std::fabs(rocketCenterX - padCenterX) <= horizontalTolerance;
-                        float maxVerticalSpeed = 50.0f;
-                        float maxRotationDeg = 30.0f;
-
-                        if (withinPadHoriz &&
-                            physics.CheckLanding(rocket, planet.landingPad, maxVerticalSpeed, maxRotationDeg)) {
-
-                            rocket.hasLanded = true;
-                            state = GameState::WIN;
-                            audio.PlayLand();
-
-                            float accuracy = 1.0f - (std::fabs(rocketCenterX - padCenterX) /
-                                (planet.landingPad.width / 2.0f));
-                            float timeFactor = 1.0f / (1.0f + timer);
-                            float fuelFactor = rocket.fuel / 100.0f;
-
-                            score = (accuracy * 0.5f + timeFactor * 0.3f + fuelFactor * 0.2f) * 1000.0f;
-                        }
-                        else {
-                            state = GameState::CRASH;
-                            audio.PlayCrash();
-                        }
-                    }
-                    else {
-                        state = GameState::CRASH;
-                        audio.PlayCrash();
-                    }
-                    rocket.position.y = 310 - 15;
-                    rocket.velocity = { 0, 0 };
+                    particles.Burst(EmitterType::CRASH_BURST, rocket.position);
+                    particles.Burst(EmitterType::OBSTACLE_SPARKS, rocket.position);
+                    break;
+                case SimEvent::CRASHED_GROUND:
+                    state = GameState::CRASH;
+                    audio.PlayCrash();
+                    particles.Burst(EmitterType::CRASH_BURST, rocket.position);
+                    break;
+                case SimEvent::NONE:
+                    break;
                 }
             }
+
+            // Exhaust follows the nozzle while the engine fires
+            particles.SetEmitter(thrustEmitter, rocket.position, rocket.rotation,
+                state == GameState::PLAYING && !rewinding && rocket.isThrusting);
             break;
         }
 
@@ -184,10 +336,15 @@ int main() {
             if (IsKeyPressed(KEY_ESCAPE)) state = GameState::PLAYING;
 
             if (IsKeyPressed(KEY_R)) {
-                levelManager.RestartCurrentLevel(rocket, planet, obstacles, timer, startGame);
+                saveReplay();
+                if (endlessMode) startEndless();
+                else levelManager.RestartCurrentLevel(sim);
+                particles.Clear();
                 state = GameState::PLAYING;
             }
             if (IsKeyPressed(KEY_M)) {
+                saveReplay();
+                leaveEndless();
                 state = GameState::MENU;
             }
 
@@ -197,16 +354,20 @@ int main() {
             // ----- WIN -----
         case GameState::WIN:
             if (IsKeyPressed(KEY_ENTER)) {
-                // Next level
-                levelManager.AdvanceToNextLevel(rocket, planet, obstacles, timer, startGame);
+                // Next level (already built in the background)
+                levelManager.AdvanceToNextLevel(sim);
+                particles.Clear();
                 state = GameState::PLAYING;
             }
             if (IsKeyPressed(KEY_R)) {
                 // Restart current level
-                levelManager.RestartCurrentLevel(rocket, planet, obstacles, timer, startGame);
+                levelManager.CancelPrebuild();
+                levelManager.RestartCurrentLevel(sim);
+                particles.Clear();
                 state = GameState::PLAYING;
             }
             if (IsKeyPressed(KEY_M)) {
+                levelManager.CancelPrebuild();
                 state = GameState::MENU;
             }
             if (IsKeyPressed(KEY_Q)) break;
@@ -214,26 +375,51 @@ int main() {
 
             // ----- CRASH -----
         case GameState::CRASH:
+            // Rewinding picks the run back up from before the crash
+            if (!endlessMode && IsKeyDown(KEY_BACKSPACE) && rewind.GetFrameCount() > 0) {
+                particles.Clear();
+                state = GameState::PLAYING;
+            }
             if (IsKeyPressed(KEY_R)) {
-                levelManager.RestartCurrentLevel(rocket, planet, obstacles, timer, startGame);
+                saveReplay();
+                if (endlessMode) startEndless();
+                else levelManager.RestartCurrentLevel(sim);
+                particles.Clear();
                 state = GameState::PLAYING;
             }
             if (IsKeyPressed(KEY_M)) {
+                saveReplay();
+                leaveEndless();
                 state = GameState::MENU;
             }
             if (IsKeyPressed(KEY_Q)) break;
             break;
         }
 
+        // ----------------- PARTICLES -----------------
+        // Effects keep animating on WIN/CRASH screens but freeze while paused
+        if (state != GameState::PLAYING) {
+            particles.SetEmitter(thrustEmitter, rocket.position, rocket.rotation, false);
+        }
+        if (state != GameState::PAUSED) {
+            particles.Update(dt);
+        }
+
         // ----------------- DRAW -----------------
         BeginDrawing();
         ClearBackground(BLACK);
 
-        BeginMode2D(cam.camera);
+        // Blend between the last two simulation ticks so motion stays smooth
+        // even when the render rate and tick rate differ (backwards while rewinding)
+        float renderAlpha = (state != GameState::PLAYING) ? 1.0f :
+            rewinding ? 1.0f - simClock.GetAlpha() : simClock.GetAlpha();
+        Camera2D renderCam = cam.GetRenderCamera(renderAlpha);
+
+        BeginMode2D(renderCam);
 
         // Parallax background
-        Vector2 parallaxOffset = { cam.camera.target.x * parallaxFactor,
-                                   cam.camera.target.y * parallaxFactor };
+        Vector2 parallaxOffset = { renderCam.target.x * parallaxFactor + parallaxShift.x,
+                                   renderCam.target.y * parallaxFactor + parallaxShift.y };
         int tilesX = SCREEN_WIDTH / starfield.width + 3;
         int tilesY = SCREEN_HEIGHT / starfield.height + 3;
 
@@ -246,17 +432,15 @@ int main() {
             }
         }
 
-        // Ground + landing pad
-        DrawRectangle(-1000, 310, 2000, 400, DARKGRAY);
-        DrawRectangleRec(planet.landingPad, GREEN);
-
-        // Obstacles
-        for (const auto& o : obstacles) {
-            o.Draw();
-        }
+        // Ground + landing pad, obstacles
+        renderer.DrawGround(sim);
+        // Same view the obstacles were posed for; the camera moves less than
+        // ActivityRegions' view margin between that tick and this frame
+        renderer.DrawObstacles(sim, cameraView(renderCam), renderAlpha);
 
-        // Rocket
-        rocket.Draw();
+        // Particles (under the rocket) + rocket
+        particles.Draw();
+        renderer.DrawRocket(rocket, renderAlpha);
 
         EndMode2D();
 
@@ -265,20 +449,23 @@ int main() {
         case GameState::MENU:
             // Right now DrawMenu only knows about difficulty;
             // you could extend it later to also show levelManager.GetLevelName().
-            ui.DrawMenu(levelManager.GetDifficultyName(),
-                levelManager.GetLevelName());
+            ui.DrawMenu(levelManager.GetDifficultyName(levelManager.GetSelectedDifficultyIndex()),
+                levelManager.GetLevelName(levelManager.GetSelectedLevelIndex()));
             break;
         case GameState::PLAYING:
-            ui.DrawHUD(rocket.fuel, 300 - rocket.position.y, timer);
+            if (endlessMode) ui.DrawEndlessHUD(rocket.fuel, endless.GetDepth(sim), sim.timer);
+            else ui.DrawHUD(rocket.fuel, sim.GetAltitude(), sim.timer);
+            if (rewinding) ui.DrawRewind(rewind.GetSeconds());
             break;
         case GameState::PAUSED:
             ui.DrawPause();
             break;
         case GameState::WIN:
-            ui.DrawWin(score);
+            ui.DrawWin(sim.score);
             break;
         case GameState::CRASH:
-            ui.DrawCrash();
+            if (endlessMode) ui.DrawEndlessHUD(rocket.fuel, endless.GetDepth(sim), sim.timer);
+            ui.DrawCrash(!endlessMode && rewind.GetFrameCount() > 0);
             break;
         }
 
@@ -295,6 +482,7 @@ int main() {
     }
 
     // -------------------- CLEANUP --------------------
+    saveReplay();
     UnloadTexture(starfield);
     audio.Close();
     ui.Close();
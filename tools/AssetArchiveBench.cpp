@@ -0,0 +1,355 @@
+// Asset archive benchmark + equivalence check.
+//
+// Verifies that an archive written by AssetArchiveWriter reads back every
+// payload, type and parameter exactly, that names are found by binary
+// search, that damaged archives are rejected at Open() (header and table
+// of contents) or by a verifying AssetLoader (payloads, per entry), and
+// that an archive replaced on disk while mapped keeps serving its old
+// contents. Then times opening archives of game-like assets and streaming
+// them in on the worker (paging in, as the game does, and hashing every
+// byte, as --check does), against reading the same bytes from loose files.
+// This is I/O only: neither side decodes anything, so it says nothing
+// about the PNG, font and WAV decoding the archive removes from startup;
+// asset_cook --bench times the game's real loads both ways. Exit code is
+// non-zero on any mismatch.
+//
+//   asset_archive_bench            verify + benchmark
+//   asset_archive_bench --verify   equivalence check only
+
+#include "AssetArchive.h"
+#include "AssetLoader.h"
+#include "StateHash.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace AssetArchiveFormat;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct TestAsset {
+        std::string name;
+        AssetType type;
+        std::vector<uint32_t> params;
+        std::vector<uint8_t> bytes;
+    };
+
+    bool Check(const char* what, bool ok)
+    {
+        std::printf("%-52s %s\n", what, ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+    std::vector<uint8_t> Pattern(size_t size, uint32_t seed)
+    {
+        std::vector<uint8_t> bytes(size);
+        uint32_t x = seed * 2654435761u + 1;
+        for (size_t i = 0; i < size; ++i) {
+            x = x * 1664525u + 1013904223u;
+            bytes[i] = (uint8_t)(x >> 24);
+        }
+        return bytes;
+    }
+
+    /// Shaped like the game's cooked assets, scaled by @p scale.
+    std::vector<TestAsset> GameLikeAssets(int scale)
+    {
+        std::vector<TestAsset> assets;
+        for (int s = 0; s < scale; ++s) {
+            std::string suffix = scale > 1 ? "-" + std::to_string(s) : "";
+            assets.push_back({ "textures/starfield" + suffix + ".png", AssetType::TEXTURE,
+                { 1024, 1024, 7, 1 }, Pattern(1024 * 1024 * 4, 1 + s) });
+            assets.push_back({ "fonts/symbols" + suffix + ".ttf", AssetType::FONT,
+                { 256, 99, 4, 2048, 1024, 2 }, Pattern(99 * sizeof(Glyph) + 2048 * 1024 * 2, 2 + s) });
+            assets.push_back({ "fonts/title" + suffix + ".otf", AssetType::FONT,
+                { 64, 95, 4, 512, 512, 2 }, Pattern(95 * sizeof(Glyph) + 512 * 512 * 2, 3 + s) });
+            assets.push_back({ "audio/crash" + suffix + ".wav", AssetType::SOUND,
+                { 274000, 44100, 32, 2 }, Pattern(274000 * 8, 4 + s) });
+            assets.push_back({ "audio/land" + suffix + ".wav", AssetType::SOUND,
+                { 113700, 44100, 32, 2 }, Pattern(113700 * 8, 5 + s) });
+            assets.push_back({ "audio/music" + suffix + ".wav", AssetType::STREAM,
+                {}, Pattern(3 * 1024 * 1024 + 17, 6 + s) });
+        }
+        return assets;
+    }
+
+    void AddAll(const std::vector<TestAsset>& assets, AssetArchiveWriter& writer)
+    {
+        for (const TestAsset& a : assets) {
+            uint32_t p[PARAM_COUNT] = {};
+            for (size_t i = 0; i < a.params.size() && i < PARAM_COUNT; ++i) p[i] = a.params[i];
+            writer.Add(a.name, a.type, { p[0], p[1], p[2], p[3], p[4], p[5] }, a.bytes.data(), a.bytes.size());
+        }
+    }
+
+    bool WriteArchive(const std::vector<TestAsset>& assets, const std::string& path)
+    {
+        AssetArchiveWriter writer;
+        AddAll(assets, writer);
+        std::string error;
+        return writer.Write(path.c_str(), error);
+    }
+
+    bool WriteBytes(const std::string& path, const std::vector<uint8_t>& bytes)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    bool Rejects(const std::string& path, const std::vector<uint8_t>& bytes)
+    {
+        AssetArchive archive;
+        return WriteBytes(path, bytes) && !archive.Open(path.c_str()) && !archive.IsOpen();
+    }
+
+    template <typename T>
+    void Poke(std::vector<uint8_t>& bytes, size_t offset, T value)
+    {
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    // -------------------- EQUIVALENCE --------------------
+    bool Verify(const fs::path& temp)
+    {
+        bool ok = true;
+        std::string error;
+        const std::string path = (temp / "assets.sdpak").string();
+
+        // Small assets of every type, added out of order, one empty
+        std::vector<TestAsset> assets = {
+            { "textures/b.png", AssetType::TEXTURE, { 16, 8, 7, 1 }, Pattern(16 * 8 * 4, 1) },
+            { "audio/a.wav", AssetType::SOUND, { 100, 44100, 32, 2 }, Pattern(800, 2) },
+            { "fonts/c.ttf", AssetType::FONT, { 32, 3, 4, 64, 32, 2 }, Pattern(3 * sizeof(Glyph) + 64 * 32 * 2, 3) },
+            { "audio/music.wav", AssetType::STREAM, {}, Pattern(1001, 4) },
+            { "empty", AssetType::STREAM, {}, {} },
+        };
+
+        AssetArchiveWriter writer;
+        AddAll(assets, writer);
+        std::vector<uint8_t> image;
+        bool built = writer.Build(image, error) && writer.Write(path.c_str(), error);
+
+        // Round trip
+        {
+            AssetArchive archive;
+            bool same = built && archive.Open(path.c_str(), &error) && archive.GetEntryCount() == (int)assets.size();
+            for (const TestAsset& a : assets) {
+                int index = same ? archive.Find(a.name.c_str()) : -1;
+                same = same && index >= 0;
+                if (!same) break;
+
+                const Entry& e = archive.GetEntry(index);
+                same = std::strcmp(archive.GetName(index), a.name.c_str()) == 0 && e.type == a.type &&
+                    e.size == a.bytes.size() && e.offset % ALIGNMENT == 0 &&
+                    (a.bytes.empty() || std::memcmp(archive.GetData(index), a.bytes.data(), a.bytes.size()) == 0) &&
+                    archive.VerifyEntry(index);
+                for (size_t i = 0; same && i < PARAM_COUNT; ++i) {
+                    same = e.params[i] == (i < a.params.size() ? a.params[i] : 0u);
+                }
+            }
+            for (int i = 1; same && i < archive.GetEntryCount(); ++i) {
+                same = std::strcmp(archive.GetName(i - 1), archive.GetName(i)) < 0;
+            }
+            same = same && archive.Find("textures/missing.png") < 0 && archive.Find("") < 0;
+            ok &= Check("payloads, types and params read back exactly", same);
+        }
+
+        // Writer checks
+        {
+            AssetArchiveWriter duplicate;
+            duplicate.Add("a", AssetType::STREAM, {}, "x", 1);
+            duplicate.Add("a", AssetType::STREAM, {}, "y", 1);
+            AssetArchiveWriter unnamed;
+            unnamed.Add("", AssetType::STREAM, {}, "x", 1);
+            std::vector<uint8_t> out;
+            ok &= Check("duplicate and empty names are rejected",
+                !duplicate.Build(out, error) && !unnamed.Build(out, error));
+        }
+
+        // Damaged header or table of contents: rejected at Open()
+        {
+            const std::string bad = (temp / "bad.sdpak").string();
+            const Header& header = *(const Header*)image.data();
+            std::vector<uint8_t> b;
+            bool rejected = built;
+
+            b = image; b.resize(b.size() - 1);                        rejected &= Rejects(bad, b);
+            b = image; b.resize(sizeof(Header) - 1);                  rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, 0, 0x12345678);              rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, 4, VERSION + 1);             rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, offsetof(Header, entryCount), 1u << 30); rejected &= Rejects(bad, b);
+            b = image; b[header.entryOffset + offsetof(Entry, size)] ^= 1;        rejected &= Rejects(bad, b);
+            b = image; b[header.stringOffset] ^= 1;                   rejected &= Rejects(bad, b);
+            rejected &= Rejects(bad, {});
+
+            // An entry out of bounds with a table hash to match
+            b = image;
+            Poke<uint64_t>(b, header.entryOffset + offsetof(Entry, offset), (uint64_t)b.size());
+            Poke<uint64_t>(b, header.entryOffset + offsetof(Entry, size), 64);
+            StateHash toc;
+            toc.Add(AssetArchive::HashBytes(b.data() + header.entryOffset, (size_t)header.entryCount * sizeof(Entry)));
+            toc.Add(AssetArchive::HashBytes(b.data() + header.stringOffset, header.stringBytes));
+            Poke<uint64_t>(b, offsetof(Header, tocHash), toc.Get());
+            rejected &= Rejects(bad, b);
+
+            AssetArchive archive;
+            rejected &= !archive.Open((temp / "missing.sdpak").string().c_str(), &error) && !error.empty();
+            ok &= Check("damaged header or table of contents is rejected", rejected);
+
+            // Damaged payload: only that entry fails, when it is streamed
+            // with verification; plain streaming does not look
+            b = image;
+            AssetArchive clean;
+            clean.Open(path.c_str());
+            int victim = clean.Find("textures/b.png");
+            b[(size_t)clean.GetEntry(victim).offset + 5] ^= 0x20;
+            bool caught = victim >= 0 && WriteBytes(bad, b) && archive.Open(bad.c_str());
+            if (caught) {
+                AssetLoader loader(archive, true);
+                loader.Start();
+                for (int i = 0; i < archive.GetEntryCount(); ++i) caught &= loader.Wait(i) == (i != victim);
+                AssetLoader::Stats stats = loader.GetStats();
+                caught &= loader.IsDone() && stats.failed == 1 && stats.streamed == archive.GetEntryCount() - 1 &&
+                    loader.GetProgress() == 1.0f;
+
+                AssetLoader paging(archive);
+                paging.Start();
+                caught &= paging.Wait(victim) && !archive.VerifyEntry(victim);
+            }
+            ok &= Check("damaged payload fails only its own entry", caught);
+        }
+
+        // Loader: inline without a worker, clean shutdown mid-stream
+        {
+            AssetArchive archive;
+            bool streamed = archive.Open(path.c_str());
+            {
+                AssetLoader loader(archive);
+                for (int i = archive.GetEntryCount() - 1; i >= 0; --i) streamed &= loader.Wait(i);
+                streamed &= loader.IsDone();
+            }
+
+            const std::string big = (temp / "big.sdpak").string();
+            AssetArchive large;
+            streamed &= WriteArchive(GameLikeAssets(4), big) && large.Open(big.c_str());
+            for (int round = 0; round < 20 && streamed; ++round) {
+                AssetLoader loader(large);
+                loader.Start();
+                if (round % 2) streamed &= loader.Wait(0);
+            }
+            ok &= Check("loader: inline streaming, stop mid-stream", streamed);
+        }
+
+        // Replaced on disk while mapped: the mapping keeps the old contents
+        {
+            AssetArchive before;
+            bool kept = before.Open(path.c_str());
+            int index = before.Find("audio/a.wav");
+            std::vector<uint8_t> old(before.GetData(index), before.GetData(index) + before.GetEntry(index).size);
+
+            AssetArchiveWriter next;
+            std::vector<uint8_t> fresh = Pattern(800, 99);
+            next.Add("audio/a.wav", AssetType::SOUND, { 100, 44100, 32, 2 }, fresh.data(), fresh.size());
+            kept &= next.Write(path.c_str(), error) &&
+                std::memcmp(before.GetData(index), old.data(), old.size()) == 0 && before.VerifyEntry(index);
+
+            AssetArchive after;
+            kept &= after.Open(path.c_str()) && after.GetEntryCount() == 1 &&
+                std::memcmp(after.GetData(0), fresh.data(), fresh.size()) == 0;
+            ok &= Check("archive replaced while mapped", kept);
+        }
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    void Benchmark(const fs::path& temp)
+    {
+        std::printf("\n%-8s %8s %9s %10s %10s %12s %14s\n", "assets", "MB", "open us", "stream ms", "GB/s",
+            "verified ms", "loose read ms");
+
+        const int scales[] = { 1, 4, 16 };
+        for (int scale : scales) {
+            std::vector<TestAsset> assets = GameLikeAssets(scale);
+            const std::string path = (temp / "bench.sdpak").string();
+            WriteArchive(assets, path);
+
+            // The same bytes as loose files, read without decoding
+            std::vector<std::string> loosePaths;
+            for (size_t i = 0; i < assets.size(); ++i) {
+                loosePaths.push_back((temp / ("loose-" + std::to_string(i))).string());
+                WriteBytes(loosePaths.back(), assets[i].bytes);
+            }
+
+            const int iterations = 10;
+            double openUs = 0.0, streamMs = 0.0, verifiedMs = 0.0, looseMs = 0.0;
+            size_t bytes = 0;
+            for (int it = 0; it < iterations; ++it) {
+                auto start = Clock::now();
+                AssetArchive archive;
+                archive.Open(path.c_str());
+                openUs += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+                AssetLoader loader(archive);
+                loader.Start();
+                loader.Wait(archive.GetEntryCount() - 1);
+                streamMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                bytes = loader.GetStats().bytes;
+
+                start = Clock::now();
+                AssetLoader verifier(archive, true);
+                verifier.Start();
+                verifier.Wait(archive.GetEntryCount() - 1);
+                verifiedMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+                start = Clock::now();
+                for (const std::string& p : loosePaths) {
+                    FILE* file = std::fopen(p.c_str(), "rb");
+                    std::vector<uint8_t> data((size_t)fs::file_size(p));
+                    size_t n = std::fread(data.data(), 1, data.size(), file);
+                    (void)n;
+                    std::fclose(file);
+                }
+                looseMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            }
+            openUs /= iterations;
+            streamMs /= iterations;
+            verifiedMs /= iterations;
+            looseMs /= iterations;
+
+            std::printf("%-8zu %8.1f %9.1f %10.2f %10.2f %12.2f %14.2f\n", assets.size(), bytes / 1048576.0, openUs,
+                streamMs, streamMs > 0.0 ? bytes / (streamMs * 1e6) : 0.0, verifiedMs, looseMs);
+            for (const std::string& p : loosePaths) fs::remove(p);
+        }
+        std::printf("(warm page cache, I/O only: decoding is timed by asset_cook --bench)\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    std::error_code ec;
+    fs::path temp = fs::temp_directory_path(ec) / "asset_archive_bench";
+    fs::create_directories(temp, ec);
+    if (ec) {
+        std::fprintf(stderr, "cannot create %s\n", temp.string().c_str());
+        return 2;
+    }
+
+    bool ok = Verify(temp);
+    std::printf("equivalence: %s\n", ok ? "bit-exact" : "MISMATCH");
+    if (!verifyOnly && ok) Benchmark(temp);
+
+    fs::remove_all(temp, ec);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,434 @@
+// asset_cook: cooks the game's assets into one memory-mapped archive.
+//
+//   asset_cook [--assets DIR] [--manifest FILE] [--out FILE] [--bench]
+//   asset_cook [--assets DIR] [--out FILE] --check
+//
+// Reads the manifest (default DIR/assets.txt), decodes every asset it
+// lists with raylib's own loaders, exactly as the game would at startup,
+// and writes the results to DIR/assets.sdpak:
+//
+//   texture NAME                     decoded pixels, as LoadTexture uploads them
+//   font NAME size=N [codepoints=L]  glyph metrics + rasterized atlas, as LoadFontEx
+//                                    builds them; L is e.g. 32-126,0x2190-0x2193
+//                                    (default: ASCII 32..126)
+//   sound NAME [rate=HZ]             PCM converted to 32-bit float stereo, the
+//                                    audio device's format (rate kept by default)
+//   music NAME                       the file as is (streams decode while playing)
+//
+// NAME is the path under DIR the game loads the asset by. A listed file
+// that does not exist is skipped with a warning; the game falls back to
+// the loose file for anything not in the archive.
+//
+// --bench then times the game's startup loads both ways, in a hidden window
+// with the audio device open: every cooked asset through raylib's loose
+// loaders (LoadTexture, LoadFontEx, LoadSound, LoadMusicStream), as the game
+// did, against GameAssets on the new archive (open, stream in, create).
+//
+// --check cooks nothing: it hashes every payload of the archive and reports
+// damaged ones. The game only pages payloads in, so this is where a bad
+// download or disk shows up.
+//
+// Needs raylib (for its decoders), so it is built with the game
+// (-DSTELLAR_BUILD_GAME=ON). Only --bench opens a window.
+
+#include "raylib.h"
+
+#include "AssetArchive.h"
+#include "GameAssets.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace AssetArchiveFormat;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // rtext.c's FONT_TTF_DEFAULT_CHARS_PADDING, which LoadFontEx uses
+    constexpr int FONT_GLYPH_PADDING_PX = 4;
+
+    struct Options {
+        std::string assetsDir = "assets";
+        std::string manifest;
+        std::string output;
+        bool bench = false;
+        bool check = false;
+    };
+
+    struct Item {
+        std::string kind;
+        std::string name;
+        int fontSize = 0;
+        std::vector<int> codepoints;
+        int sampleRate = 0;          // 0 = keep the file's
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: asset_cook [--assets DIR] [--manifest FILE] [--out FILE] [--bench]\n"
+            "       asset_cook [--assets DIR] [--out FILE] --check\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h") { PrintUsage(); std::exit(0); }
+            else if (arg == "--assets" && hasValue) opt.assetsDir = argv[++i];
+            else if (arg == "--manifest" && hasValue) opt.manifest = argv[++i];
+            else if (arg == "--out" && hasValue) opt.output = argv[++i];
+            else if (arg == "--bench") opt.bench = true;
+            else if (arg == "--check") opt.check = true;
+            else {
+                std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+        }
+        if (opt.manifest.empty()) opt.manifest = opt.assetsDir + "/assets.txt";
+        if (opt.output.empty()) opt.output = opt.assetsDir + "/assets.sdpak";
+        return true;
+    }
+
+    // -------------------- MANIFEST --------------------
+    bool ParseCodepoints(const std::string& list, std::vector<int>& out)
+    {
+        std::stringstream items(list);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            char* end;
+            long first = std::strtol(item.c_str(), &end, 0);
+            long last = first;
+            if (*end == '-') last = std::strtol(end + 1, &end, 0);
+            if (*end != '\0' || first < 0 || last < first || last > 0x10ffff) return false;
+            for (long c = first; c <= last; ++c) out.push_back((int)c);
+        }
+        return !out.empty();
+    }
+
+    bool ParseManifest(const char* path, std::vector<Item>& items)
+    {
+        char* text = LoadFileText(path);
+        if (!text) {
+            std::fprintf(stderr, "%s: cannot read\n", path);
+            return false;
+        }
+        std::stringstream lines(text);
+        UnloadFileText(text);
+
+        std::string line;
+        for (int number = 1; std::getline(lines, line); ++number) {
+            size_t hash = line.find('#');
+            if (hash != std::string::npos) line.erase(hash);
+
+            std::stringstream words(line);
+            Item item;
+            if (!(words >> item.kind)) continue;
+            bool ok = (bool)(words >> item.name) &&
+                (item.kind == "texture" || item.kind == "font" || item.kind == "sound" || item.kind == "music");
+
+            std::string option;
+            while (ok && words >> option) {
+                size_t eq = option.find('=');
+                std::string key = option.substr(0, eq);
+                std::string value = eq == std::string::npos ? "" : option.substr(eq + 1);
+                if (item.kind == "font" && key == "size") ok = (item.fontSize = std::atoi(value.c_str())) > 0;
+                else if (item.kind == "font" && key == "codepoints") ok = ParseCodepoints(value, item.codepoints);
+                else if (item.kind == "sound" && key == "rate") ok = (item.sampleRate = std::atoi(value.c_str())) > 0;
+                else ok = false;
+            }
+            if (ok && item.kind == "font" && item.fontSize == 0) ok = false;
+            if (!ok) {
+                std::fprintf(stderr, "%s: line %d: expected texture|font|sound|music NAME [options]"
+                    " (fonts need size=N)\n", path, number);
+                return false;
+            }
+            if (item.kind == "font" && item.codepoints.empty()) {
+                for (int c = 32; c <= 126; ++c) item.codepoints.push_back(c);
+            }
+            items.push_back(item);
+        }
+        return true;
+    }
+
+    // -------------------- COOKING --------------------
+    // Each returns false if the source cannot be decoded
+
+    bool CookTexture(const std::string& path, const Item& item, AssetArchiveWriter& out)
+    {
+        Image image = LoadImage(path.c_str());
+        if (!image.data) return false;
+
+        int bytes = GetPixelDataSize(image.width, image.height, image.format);
+        out.Add(item.name, AssetType::TEXTURE,
+            { (uint32_t)image.width, (uint32_t)image.height, (uint32_t)image.format, 1u }, image.data, (size_t)bytes);
+        UnloadImage(image);
+        return true;
+    }
+
+    bool CookFont(const std::string& path, const Item& item, AssetArchiveWriter& out)
+    {
+        int fileSize = 0;
+        unsigned char* file = LoadFileData(path.c_str(), &fileSize);
+        if (!file) return false;
+
+        int count = (int)item.codepoints.size();
+        GlyphInfo* glyphs = LoadFontData(file, fileSize, item.fontSize, (int*)item.codepoints.data(), count, FONT_DEFAULT);
+        UnloadFileData(file);
+        if (!glyphs) return false;
+
+        Rectangle* recs = nullptr;
+        Image atlas = GenImageFontAtlas(glyphs, &recs, count, item.fontSize, FONT_GLYPH_PADDING_PX, 0);
+
+        std::vector<uint8_t> payload((size_t)count * sizeof(Glyph));
+        for (int i = 0; i < count; ++i) {
+            Glyph g = { glyphs[i].value, glyphs[i].offsetX, glyphs[i].offsetY, glyphs[i].advanceX,
+                recs[i].x, recs[i].y, recs[i].width, recs[i].height };
+            std::memcpy(payload.data() + i * sizeof(Glyph), &g, sizeof(Glyph));
+        }
+        const uint8_t* pixels = (const uint8_t*)atlas.data;
+        payload.insert(payload.end(), pixels, pixels + GetPixelDataSize(atlas.width, atlas.height, atlas.format));
+
+        out.Add(item.name, AssetType::FONT,
+            { (uint32_t)item.fontSize, (uint32_t)count, (uint32_t)FONT_GLYPH_PADDING_PX,
+              (uint32_t)atlas.width, (uint32_t)atlas.height, (uint32_t)atlas.format },
+            payload.data(), payload.size());
+
+        UnloadImage(atlas);
+        MemFree(recs);
+        UnloadFontData(glyphs, count);
+        return true;
+    }
+
+    bool CookSound(const std::string& path, const Item& item, AssetArchiveWriter& out)
+    {
+        Wave wave = LoadWave(path.c_str());
+        if (!wave.data) return false;
+
+        // The device mixes 32-bit float stereo; only a rate change is left for load time
+        WaveFormat(&wave, item.sampleRate > 0 ? item.sampleRate : (int)wave.sampleRate, 32, 2);
+        size_t bytes = (size_t)wave.frameCount * wave.channels * (wave.sampleSize / 8);
+        out.Add(item.name, AssetType::SOUND,
+            { wave.frameCount, wave.sampleRate, wave.sampleSize, wave.channels }, wave.data, bytes);
+        UnloadWave(wave);
+        return true;
+    }
+
+    bool CookMusic(const std::string& path, const Item& item, AssetArchiveWriter& out)
+    {
+        int size = 0;
+        unsigned char* file = LoadFileData(path.c_str(), &size);
+        if (!file) return false;
+        out.Add(item.name, AssetType::STREAM, {}, file, (size_t)size);
+        UnloadFileData(file);
+        return true;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    using Loaded = std::vector<std::function<void()>>;   // unloads, run after timing
+
+    double Ms(Clock::time_point since) { return std::chrono::duration<double, std::milli>(Clock::now() - since).count(); }
+
+    // What the game did at startup before the archive
+    double LoadLoose(const Options& opt, const std::vector<Item>& items, std::vector<double>& ms, Loaded& loaded)
+    {
+        double total = 0.0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            const Item& item = items[i];
+            std::string path = opt.assetsDir + "/" + item.name;
+
+            auto start = Clock::now();
+            if (item.kind == "texture") {
+                Texture2D texture = LoadTexture(path.c_str());
+                ms[i] = Ms(start);
+                loaded.push_back([texture]() { UnloadTexture(texture); });
+            }
+            else if (item.kind == "font") {
+                Font font = LoadFontEx(path.c_str(), item.fontSize, (int*)item.codepoints.data(), (int)item.codepoints.size());
+                ms[i] = Ms(start);
+                loaded.push_back([font]() { UnloadFont(font); });
+            }
+            else if (item.kind == "sound") {
+                Sound sound = LoadSound(path.c_str());
+                ms[i] = Ms(start);
+                loaded.push_back([sound]() { UnloadSound(sound); });
+            }
+            else {
+                Music music = LoadMusicStream(path.c_str());
+                ms[i] = Ms(start);
+                loaded.push_back([music]() { UnloadMusicStream(music); });
+            }
+            total += ms[i];
+        }
+        return total;
+    }
+
+    // What the game does now: open, stream, create (the loading screen is
+    // up until the last asset's wait returns)
+    double LoadCooked(const Options& opt, const std::vector<Item>& items, std::vector<double>& ms,
+        double& openMs, int& looseCount, Loaded& loaded)
+    {
+        auto start = Clock::now();
+        auto assets = std::make_shared<GameAssets>(opt.assetsDir);
+        assets->Open(opt.output.c_str());
+        openMs = Ms(start);
+        double total = openMs;
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            const Item& item = items[i];
+            auto t0 = Clock::now();
+            if (item.kind == "texture") {
+                Texture2D texture = assets->LoadTexture(item.name.c_str());
+                ms[i] = Ms(t0);
+                loaded.push_back([texture]() { UnloadTexture(texture); });
+            }
+            else if (item.kind == "font") {
+                Font font = assets->LoadFont(item.name.c_str(), item.fontSize, item.codepoints.data(), (int)item.codepoints.size());
+                ms[i] = Ms(t0);
+                loaded.push_back([font]() { UnloadFont(font); });
+            }
+            else if (item.kind == "sound") {
+                Sound sound = assets->LoadSound(item.name.c_str());
+                ms[i] = Ms(t0);
+                loaded.push_back([sound]() { UnloadSound(sound); });
+            }
+            else {
+                Music music = assets->LoadMusic(item.name.c_str());
+                ms[i] = Ms(t0);
+                loaded.push_back([music, assets]() { UnloadMusicStream(music); });   // streams from the mapping
+            }
+            total += ms[i];
+        }
+        looseCount = assets->GetLooseCount();
+        return total;
+    }
+
+    void Unload(Loaded& loaded)
+    {
+        for (auto& unload : loaded) unload();
+        loaded.clear();
+    }
+
+    int Benchmark(const Options& opt, const std::vector<Item>& items)
+    {
+        // Only what was cooked (the rest loads loose either way)
+        std::vector<Item> cooked;
+        for (const Item& item : items) {
+            if (FileExists((opt.assetsDir + "/" + item.name).c_str())) cooked.push_back(item);
+        }
+
+        // Real loads need the GL context and the audio device, as in the game
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(320, 180, "asset_cook --bench");
+        InitAudioDevice();
+        if (!IsWindowReady() || !IsAudioDeviceReady()) {
+            std::fprintf(stderr, "--bench needs a display and an audio device\n");
+            if (IsAudioDeviceReady()) CloseAudioDevice();
+            if (IsWindowReady()) CloseWindow();
+            return 1;
+        }
+
+        // Alternate the two ways and keep each one's best round, so the
+        // page cache is equally warm for both
+        const int ROUNDS = 5;
+        std::vector<double> looseMs(cooked.size()), cookedMs(cooked.size()), ms(cooked.size());
+        double looseBest = 1e30, cookedBest = 1e30, openBest = 0.0;
+        int fellBack = 0;
+        Loaded loaded;
+        for (int round = 0; round < ROUNDS; ++round) {
+            double total = LoadLoose(opt, cooked, ms, loaded);
+            Unload(loaded);
+            if (total < looseBest) { looseBest = total; looseMs = ms; }
+
+            double openMs = 0.0;
+            total = LoadCooked(opt, cooked, ms, openMs, fellBack, loaded);
+            Unload(loaded);
+            if (total < cookedBest) { cookedBest = total; cookedMs = ms; openBest = openMs; }
+        }
+        CloseAudioDevice();
+        CloseWindow();
+
+        std::printf("\nstartup loads, best of %d (GPU and audio device uploads included)\n", ROUNDS);
+        std::printf("%-40s %12s %12s\n", "asset", "loose ms", "cooked ms");
+        std::printf("%-40s %12s %12.2f\n", "open archive", "", openBest);
+        for (size_t i = 0; i < cooked.size(); ++i) {
+            std::printf("%-40s %12.2f %12.2f\n", cooked[i].name.c_str(), looseMs[i], cookedMs[i]);
+        }
+        std::printf("%-40s %12.2f %12.2f  (%.1fx)\n", "total", looseBest, cookedBest,
+            cookedBest > 0.0 ? looseBest / cookedBest : 0.0);
+        if (fellBack > 0) std::printf("warning: %d assets fell back to their loose files\n", fellBack);
+        return 0;
+    }
+
+    // -------------------- CHECK --------------------
+    int Check(const Options& opt)
+    {
+        std::string error;
+        AssetArchive archive;
+        if (!archive.Open(opt.output.c_str(), &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        int damaged = 0;
+        for (int i = 0; i < archive.GetEntryCount(); ++i) {
+            if (!archive.VerifyEntry(i)) {
+                std::fprintf(stderr, "%s: %s is damaged\n", opt.output.c_str(), archive.GetName(i));
+                damaged++;
+            }
+        }
+        std::printf("%s: %d assets, %d damaged\n", opt.output.c_str(), archive.GetEntryCount(), damaged);
+        return damaged == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage();
+        return 2;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    if (opt.check) return Check(opt);
+
+    std::vector<Item> items;
+    if (!ParseManifest(opt.manifest.c_str(), items)) return 1;
+
+    AssetArchiveWriter writer;
+    auto start = Clock::now();
+    for (const Item& item : items) {
+        std::string path = opt.assetsDir + "/" + item.name;
+        if (!FileExists(path.c_str())) {
+            std::fprintf(stderr, "warning: %s does not exist, skipped\n", path.c_str());
+            continue;
+        }
+
+        bool ok = item.kind == "texture" ? CookTexture(path, item, writer) :
+            item.kind == "font" ? CookFont(path, item, writer) :
+            item.kind == "sound" ? CookSound(path, item, writer) : CookMusic(path, item, writer);
+        if (!ok) {
+            std::fprintf(stderr, "%s: cannot decode\n", path.c_str());
+            return 1;
+        }
+    }
+
+    std::string error;
+    if (!writer.Write(opt.output.c_str(), error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::printf("%s: %d assets cooked (%.0f ms)\n", opt.output.c_str(), writer.GetEntryCount(), ms);
+
+    return opt.bench ? Benchmark(opt, items) : 0;
+}
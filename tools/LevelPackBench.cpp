@@ -0,0 +1,421 @@
+// Level pack benchmark + equivalence check.
+//
+// Verifies that the compiled level pack path changes nothing: the built-in
+// presets survive text and back bit for bit, assets/levels/levels.txt
+// compiles to exactly the built-in pack, and presets built from a mapped
+// pack file are the same worlds as the built-in ones. Checks that authored
+// obstacles and terrain are used, that damaged packs are rejected, and
+// that a pack replaced on disk is picked up by FileWatcher + LoadPack
+// (and that replays from the old one no longer load). Then times opening
+// a compiled pack against parsing and compiling its text, for 10 to 100k
+// levels. Exit code is non-zero on any mismatch.
+//
+//   level_pack_bench            verify + benchmark
+//   level_pack_bench --verify   equivalence check only
+
+#include "FileWatcher.h"
+#include "LevelManager.h"
+#include "LevelPack.h"
+#include "LevelPackCompiler.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifndef STELLAR_ASSETS_DIR
+#define STELLAR_ASSETS_DIR "StellarDescent/assets"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float TICK_DT = 1.0f / SimulationClock::DEFAULT_TICK_RATE;
+
+    bool SameBits(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+    // Every pose plus the rocket and run state (hash)
+    bool SameWorld(const Simulation& a, const Simulation& b)
+    {
+        if (a.GetStateHash() != b.GetStateHash() || a.obstacles.Size() != b.obstacles.Size()) return false;
+        if (a.terrain.GetHash() != b.terrain.GetHash()) return false;
+
+        std::vector<float> pa(a.obstacles.GetPoseFloats()), pb(b.obstacles.GetPoseFloats());
+        a.obstacles.CopyPosesTo(pa.data());
+        b.obstacles.CopyPosesTo(pb.data());
+        for (size_t i = 0; i < pa.size(); ++i) {
+            if (!SameBits(pa[i], pb[i])) return false;
+        }
+        return true;
+    }
+
+    void Fly(Simulation& sim, int ticks)
+    {
+        ControlInput input;
+        input.throttle = 1.0f;
+        input.rotate = 0.4f;
+        for (int t = 0; t < ticks && sim.GetOutcome() == SimOutcome::RUNNING; ++t) sim.Step(input, TICK_DT);
+    }
+
+    bool Check(const char* what, bool ok)
+    {
+        std::printf("%-52s %s\n", what, ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+    std::vector<uint8_t> BuiltinImage()
+    {
+        LevelManager presets;
+        presets.UseBuiltinPack();
+        const LevelPack& pack = presets.GetPack();
+
+        // The pack does not expose its bytes; recompile its text instead and
+        // let the round-trip check prove that is the same thing
+        std::string error;
+        LevelPackSource source;
+        std::vector<uint8_t> image;
+        LevelPackCompiler::Parse(LevelPackCompiler::ToText(pack), source, error);
+        LevelPackCompiler::Compile(source, image, error);
+        return image;
+    }
+
+    bool CompileText(const std::string& text, std::vector<uint8_t>& image, std::string& error)
+    {
+        LevelPackSource source;
+        return LevelPackCompiler::Parse(text, source, error) && LevelPackCompiler::Compile(source, image, error);
+    }
+
+    bool WriteBytes(const std::string& path, const std::vector<uint8_t>& bytes)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    bool Rejects(const std::string& path, const std::vector<uint8_t>& bytes)
+    {
+        LevelPack pack;
+        return WriteBytes(path, bytes) && !pack.Open(path.c_str()) && !pack.IsOpen();
+    }
+
+    template<typename T>
+    void Poke(std::vector<uint8_t>& bytes, size_t offset, T value)
+    {
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    /// A pack of @p levels levels, each with a couple of authored obstacles.
+    std::string SyntheticText(int levels)
+    {
+        std::string text =
+            "difficulty \"Easy\" gravity=60 fuel=150 pad=140 obstacles=2\n"
+            "difficulty \"Normal\" gravity=80 fuel=100 pad=100 obstacles=4\n"
+            "difficulty \"Hard\" gravity=100 fuel=70 pad=70 obstacles=6\n";
+        char line[256];
+        for (int i = 0; i < levels; ++i) {
+            float x = (float)((i * 37) % 500 - 250);
+            std::snprintf(line, sizeof(line),
+                "\nlevel \"Level %d\"\nstart %g -220\npad %g\nterrain hills=%d craters=%d\n"
+                "obstacle %g -40 60 12 pattern=horizontal amplitude=30 frequency=0.5 phase=%d\n"
+                "obstacle %g 60 40 10 spin=%d\n",
+                i, x, -x * 0.5f, 20 + i % 40, i % 5, x - 30.0f, i % 7, -x, 10 + i % 90);
+            text += line;
+        }
+        return text;
+    }
+
+    // -------------------- EQUIVALENCE --------------------
+    bool Verify(const fs::path& temp)
+    {
+        bool ok = true;
+        std::string error;
+
+        LevelManager builtin(17);
+        Simulation builtinSim;
+        builtin.Init(builtinSim);
+        const LevelPack& builtinPack = builtin.GetPack();
+
+        // Text round trip: ToText -> Parse -> Compile gives the same bytes
+        std::vector<uint8_t> image = BuiltinImage();
+        {
+            LevelPack again;
+            bool same = again.Adopt(image) && again.GetHash() == builtinPack.GetHash() &&
+                again.GetSize() == builtinPack.GetSize() && again.VerifyHash();
+            ok &= Check("built-in presets: text round trip is bit-exact", same);
+        }
+
+        // The shipped text is the built-in presets
+        {
+            std::string text;
+            std::vector<uint8_t> asset;
+            bool same = LevelPackCompiler::ReadText(STELLAR_ASSETS_DIR "/levels/levels.txt", text, error) &&
+                CompileText(text, asset, error) && asset == image;
+            if (!same) std::printf("  %s\n", error.c_str());
+            ok &= Check("assets/levels/levels.txt == built-in presets", same);
+        }
+
+        // Mapped pack file: the same worlds as the built-in presets
+        const std::string packPath = (temp / "levels.sdpack").string();
+        {
+            bool same = LevelPackCompiler::Write(image, packPath.c_str(), error);
+            LevelManager mapped(17);
+            Simulation mappedSim, refSim;
+            same = same && mapped.LoadPack(packPath.c_str(), &error);
+            mapped.Init(mappedSim);
+            same = same && mapped.GetPackHash() == builtin.GetPackHash() && !mapped.GetPack().GetPath().empty();
+
+            LevelManager reference(17);
+            reference.Init(refSim);
+            for (int d = 0; d < mapped.GetDifficultyCount() && same; ++d) {
+                for (int l = 0; l < mapped.GetLevelCount() && same; ++l) {
+                    mapped.SetPreset(d, l, mappedSim);
+                    reference.SetPreset(d, l, refSim);
+                    mappedSim.ResetRun();
+                    refSim.ResetRun();
+                    same = same && std::strcmp(mapped.GetLevelName(l), reference.GetLevelName(l)) == 0 &&
+                        std::strcmp(mapped.GetDifficultyName(d), reference.GetDifficultyName(d)) == 0 &&
+                        mapped.GetLayoutSeed() == reference.GetLayoutSeed() && SameWorld(mappedSim, refSim);
+
+                    // ...and stay the same through a run and a restart
+                    Fly(mappedSim, 240);
+                    Fly(refSim, 240);
+                    same = same && SameWorld(mappedSim, refSim);
+                    mapped.RestartCurrentLevel(mappedSim);
+                    reference.RestartCurrentLevel(refSim);
+                    same = same && SameWorld(mappedSim, refSim);
+                }
+            }
+            ok &= Check("mapped pack == built-in presets, every preset", same);
+        }
+
+        // Authored obstacles and terrain
+        {
+            const char* text =
+                "difficulty \"Test\" gravity=50 fuel=80 pad=90 obstacles=3\n"
+                "level \"Flat\"\nstart 10 -150\npad 40\n"
+                "terrain min_x=-800 max_x=800 spacing=8 hills=0 craters=0\n"
+                "obstacle -100 20 50 10\n"
+                "obstacle 120 -30 30 30 pattern=vertical amplitude=25 frequency=2 phase=0.5 spin=90\n";
+            std::vector<uint8_t> authored;
+            bool parsed = CompileText(text, authored, error);
+            if (!parsed) std::printf("  %s\n", error.c_str());
+            bool written = parsed && LevelPackCompiler::Write(authored, packPath.c_str(), error);
+
+            LevelManager levels;
+            Simulation sim;
+            bool loaded = written && levels.LoadPack(packPath.c_str(), &error);
+            levels.Init(sim);
+
+            bool obstaclesOk = loaded && sim.obstacles.Size() == 3 + 2;
+            for (int i = 0; obstaclesOk && i < sim.obstacles.Size(); ++i) {
+                int source = sim.obstacles.GetSourceIndex(i);
+                if (source == 3) {
+                    Vector2 c = sim.obstacles.GetCenter(i), h = sim.obstacles.GetHalfExtents(i);
+                    obstaclesOk = sim.obstacles.GetPattern(i) == ObstaclePattern::STATIC &&
+                        c.x == -75.0f && c.y == 25.0f && h.x == 25.0f && h.y == 5.0f;
+                }
+                else if (source == 4) {
+                    obstaclesOk = sim.obstacles.GetPattern(i) == ObstaclePattern::VERTICAL;
+                }
+            }
+            ok &= Check("authored obstacles follow the generated ones", obstaclesOk);
+
+            bool flat = loaded && sim.terrain.GetMinX() == -800.0f && sim.terrain.GetSpacing() == 8.0f;
+            for (int i = 0; flat && i < sim.terrain.GetSampleCount(); ++i) {
+                flat = sim.terrain.GetSample(i) == Simulation::GROUND_Y;
+            }
+            ok &= Check("authored terrain settings are used", flat &&
+                sim.planet.gravity == 50.0f && sim.planet.landingPad.width == 90.0f &&
+                sim.rocket.position.x == 10.0f && sim.rocket.position.y == -150.0f);
+        }
+
+        // Damaged packs
+        {
+            using namespace LevelPackFormat;
+            const std::string bad = (temp / "bad.sdpack").string();
+            const Header& header = *(const Header*)image.data();
+            std::vector<uint8_t> b;
+            bool rejected = true;
+
+            b = image; b.resize(b.size() - 8);                         rejected &= Rejects(bad, b);
+            b = image; b.resize(20);                                   rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, 0, 0x12345678);               rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, 4, VERSION + 1);              rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, offsetof(Header, levelOffset), 4);        rejected &= Rejects(bad, b);
+            b = image; Poke<uint32_t>(b, offsetof(Header, levelCount), 1u << 28); rejected &= Rejects(bad, b);
+            b = image; b[header.stringOffset + header.stringBytes - 1] = 'x'; rejected &= Rejects(bad, b);
+            rejected &= Rejects(bad, {});
+
+            // A byte-swapped header names the problem
+            b = image;
+            Poke<uint32_t>(b, 0, (MAGIC >> 24) | ((MAGIC >> 8) & 0xff00) | ((MAGIC << 8) & 0xff0000) | (MAGIC << 24));
+            LevelPack pack;
+            rejected &= WriteBytes(bad, b) && !pack.Open(bad.c_str(), &error) && error.find("byte order") != std::string::npos;
+            ok &= Check("damaged headers are rejected", rejected);
+
+            // Payload damage passes the header check; the hash finds it
+            b = image;
+            b[sizeof(Header) + 5] ^= 0x40;
+            bool caught = WriteBytes(bad, b) && pack.Open(bad.c_str()) && !pack.VerifyHash();
+            pack.Close();
+
+            // Bad obstacle ranges are bounds-checked where they are read
+            b = image;
+            Poke<uint32_t>(b, header.levelOffset + offsetof(Level, obstacleCount), 1000000);
+            int count = -1;
+            caught &= WriteBytes(bad, b) && pack.Open(bad.c_str()) &&
+                pack.GetObstacles(pack.GetLevel(0), count) == nullptr && count == 0;
+            pack.Close();
+            ok &= Check("damaged payloads: hash + bounds checks catch them", caught);
+
+            LevelManager levels;
+            Simulation sim;
+            levels.Init(sim);
+            bool kept = !levels.LoadPack((temp / "missing.sdpack").string().c_str()) &&
+                levels.GetPackHash() == builtin.GetPackHash();
+            b = image; Poke<uint32_t>(b, 0, 0);
+            kept &= WriteBytes(bad, b) && !levels.LoadPack(bad.c_str(), &error) && !error.empty() &&
+                levels.GetPackHash() == builtin.GetPackHash() && levels.GetLevelCount() == builtin.GetLevelCount();
+            ok &= Check("failed load keeps the presets in use", kept);
+
+            LevelPackSource source;
+            bool parseErrors =
+                !LevelPackCompiler::Parse("difficulty \"A\" gravity=1\nlevel \"B\"\nstart 0\n", source, error) &&
+                error.find("line 3") == 0 &&
+                !LevelPackCompiler::Parse("difficulty \"A\"\nlevel \"B\"\nbogus 1\n", source, error) &&
+                !LevelPackCompiler::Parse("difficulty \"A\" gravity=abc\n", source, error);
+            std::vector<uint8_t> out;
+            parseErrors &= !CompileText("level \"no difficulties\"\n", out, error);
+            ok &= Check("bad text is rejected with a line number", parseErrors);
+        }
+
+        // Hot reload: the file is replaced while mapped
+        {
+            std::string textA = SyntheticText(8), textB = SyntheticText(12);
+            std::vector<uint8_t> a, b;
+            bool reloaded = CompileText(textA, a, error) && CompileText(textB, b, error) &&
+                LevelPackCompiler::Write(a, packPath.c_str(), error);
+
+            LevelManager levels(3);
+            Simulation sim;
+            reloaded = reloaded && levels.LoadPack(packPath.c_str(), &error);
+            levels.Init(sim);
+            levels.SetPreset(1, 7, sim);
+            uint64_t hashA = levels.GetPackHash();
+
+            // A replay recorded on pack A
+            ReplayRecorder recorder;
+            ReplayHeader header;
+            header.difficulty = 1;
+            header.level = 7;
+            header.seed = levels.GetLayoutSeed();
+            header.pack = hashA;
+            header.tickRate = SimulationClock::DEFAULT_TICK_RATE;
+            sim.ResetRun();
+            recorder.Begin(header);
+            for (int t = 0; t < 60; ++t) {
+                ControlInput input;
+                input.throttle = 0.5f;
+                recorder.Record(input, sim);
+                sim.Step(input, TICK_DT);
+            }
+            Replay replay = recorder.Finish(sim);
+
+            // A build still pending on the worker is dropped by the reload
+            levels.PrebuildNextLevel();
+
+            FileWatcher watcher(packPath);
+            reloaded = reloaded && !watcher.Poll() && LevelPackCompiler::Write(b, packPath.c_str(), error);
+            reloaded = reloaded && watcher.Poll() && levels.LoadPack(packPath.c_str(), &error);
+            reloaded = reloaded && !levels.HasPrebuild() && levels.GetLevelCount() == 12 &&
+                levels.GetPackHash() != hashA && std::strcmp(levels.GetLevelName(11), "Level 11") == 0;
+            ok &= Check("replaced pack is reloaded in place", reloaded);
+
+            Simulation playSim;
+            ReplayPlayer player(replay);
+            bool refused = !player.LoadWorld(playSim, levels, nullptr);
+            reloaded = LevelPackCompiler::Write(a, packPath.c_str(), error) && levels.LoadPack(packPath.c_str(), &error);
+            bool accepted = reloaded && player.LoadWorld(playSim, levels, nullptr);
+            while (accepted && playSim.GetTickCount() < replay.tickCount) playSim.Step(player.Poll(), TICK_DT);
+            ok &= Check("replays only load on the pack they were recorded on",
+                refused && accepted && playSim.GetStateHash() == replay.finalHash);
+        }
+
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    void Benchmark(const fs::path& temp)
+    {
+        std::printf("\n%-8s %12s %16s %14s %16s %9s\n", "levels", "pack bytes", "parse+compile us", "open us",
+            "open+build us", "speedup");
+
+        const std::string packPath = (temp / "bench.sdpack").string();
+        const int sizes[] = { 10, 1000, 10000, 100000 };
+        for (int levels : sizes) {
+            std::string text = SyntheticText(levels), error;
+            std::vector<uint8_t> image;
+
+            // What loading the text at startup would cost
+            const int compileIterations = std::max(1, 2000 / levels);
+            auto start = Clock::now();
+            for (int i = 0; i < compileIterations; ++i) {
+                image.clear();
+                CompileText(text, image, error);
+            }
+            double compileUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / compileIterations;
+            LevelPackCompiler::Write(image, packPath.c_str(), error);
+
+            // Open: map + header check, independent of the level count
+            const int openIterations = 2000;
+            LevelPack pack;
+            start = Clock::now();
+            for (int i = 0; i < openIterations; ++i) pack.Open(packPath.c_str());
+            double openUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / openIterations;
+
+            // ...plus building the last level, the first thing a player would see
+            LevelManager manager;
+            Simulation sim;
+            const int buildIterations = 200;
+            start = Clock::now();
+            for (int i = 0; i < buildIterations; ++i) {
+                manager.LoadPack(packPath.c_str());
+                manager.SetPreset(1, levels - 1, sim);
+            }
+            double buildUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / buildIterations;
+
+            std::printf("%-8d %12zu %16.1f %14.2f %16.1f %8.0fx\n", levels, image.size(), compileUs, openUs, buildUs,
+                openUs > 0.0 ? compileUs / openUs : 0.0);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    std::error_code ec;
+    fs::path temp = fs::temp_directory_path(ec) / "level_pack_bench";
+    fs::create_directories(temp, ec);
+    if (ec) {
+        std::fprintf(stderr, "cannot create %s\n", temp.string().c_str());
+        return 2;
+    }
+
+    bool ok = Verify(temp);
+    std::printf("equivalence: %s\n", ok ? "bit-exact" : "MISMATCH");
+    if (!verifyOnly && ok) Benchmark(temp);
+
+    fs::remove_all(temp, ec);
+    return ok ? 0 : 1;
+}
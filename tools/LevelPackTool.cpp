@@ -0,0 +1,193 @@
+// level_pack: compiles level pack text into the binary pack the game maps.
+//
+//   level_pack SRC.txt OUT.sdpack            compile once
+//   level_pack SRC.txt OUT.sdpack --watch    recompile whenever SRC changes
+//   level_pack --dump PACK.sdpack            print a compiled pack as text
+//   level_pack --check PACK.sdpack           validate header and content hash
+//   level_pack --builtin OUT.txt             write the built-in presets as text
+//
+// The output is written beside OUT and renamed over it, so a running game
+// (which watches assets/levels/levels.sdpack) only ever reloads a whole
+// pack. A source with errors leaves OUT untouched. The text format is
+// documented in LevelPackCompiler.h.
+
+#include "FileWatcher.h"
+#include "LevelManager.h"
+#include "LevelPack.h"
+#include "LevelPackCompiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string source;
+        std::string output;
+        std::string dump;
+        std::string check;
+        std::string builtin;
+        bool watch = false;
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: level_pack SRC.txt OUT.sdpack [--watch]\n"
+            "       level_pack --dump PACK.sdpack\n"
+            "       level_pack --check PACK.sdpack\n"
+            "       level_pack --builtin OUT.txt\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h") { PrintUsage(); std::exit(0); }
+            else if (arg == "--watch") opt.watch = true;
+            else if (arg == "--dump" && hasValue) opt.dump = argv[++i];
+            else if (arg == "--check" && hasValue) opt.check = argv[++i];
+            else if (arg == "--builtin" && hasValue) opt.builtin = argv[++i];
+            else if (arg[0] != '-' && opt.source.empty()) opt.source = arg;
+            else if (arg[0] != '-' && opt.output.empty()) opt.output = arg;
+            else {
+                std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        int modes = !opt.source.empty() + !opt.dump.empty() + !opt.check.empty() + !opt.builtin.empty();
+        if (modes != 1 || (!opt.source.empty() && opt.output.empty()) || (opt.watch && opt.source.empty())) {
+            std::fprintf(stderr, "give exactly one of SRC OUT, --dump, --check or --builtin\n");
+            return false;
+        }
+        return true;
+    }
+
+    // -------------------- COMPILE --------------------
+    bool CompileFile(const Options& opt)
+    {
+        auto start = Clock::now();
+
+        std::string text, error;
+        LevelPackSource source;
+        std::vector<uint8_t> image;
+        if (!LevelPackCompiler::ReadText(opt.source.c_str(), text, error) ||
+            !LevelPackCompiler::Parse(text, source, error) ||
+            !LevelPackCompiler::Compile(source, image, error) ||
+            !LevelPackCompiler::Write(image, opt.output.c_str(), error)) {
+            std::fprintf(stderr, "%s: %s\n", opt.source.c_str(), error.c_str());
+            return false;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::printf("%s: %zu difficulties, %zu levels, %zu bytes (%.1f ms)\n", opt.output.c_str(),
+            source.difficulties.size(), source.levels.size(), image.size(), ms);
+        return true;
+    }
+
+    int Watch(const Options& opt)
+    {
+        FileWatcher watcher(opt.source, 0.25f);
+        std::printf("watching %s (Ctrl+C to stop)\n", opt.source.c_str());
+        std::fflush(stdout);
+        for (;;) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            if (watcher.Poll()) {
+                CompileFile(opt);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    // -------------------- INSPECT --------------------
+    int Dump(const Options& opt)
+    {
+        LevelPack pack;
+        std::string error;
+        if (!pack.Open(opt.dump.c_str(), &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        std::fputs(LevelPackCompiler::ToText(pack).c_str(), stdout);
+        return 0;
+    }
+
+    int Check(const Options& opt)
+    {
+        LevelPack pack;
+        std::string error;
+        if (!pack.Open(opt.check.c_str(), &error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        if (!pack.VerifyHash()) {
+            std::fprintf(stderr, "%s: content hash does not match (corrupt or edited pack)\n", opt.check.c_str());
+            return 1;
+        }
+
+        // Every cross reference, which the game only checks as it reads them
+        int obstacles = 0;
+        for (int i = 0; i < pack.GetLevelCount(); ++i) {
+            const LevelPackFormat::Level& level = pack.GetLevel(i);
+            int count;
+            const LevelPackFormat::Obstacle* authored = pack.GetObstacles(level, count);
+            if (!authored && level.obstacleCount > 0) {
+                std::fprintf(stderr, "%s: level %d obstacle range out of bounds\n", opt.check.c_str(), i);
+                return 1;
+            }
+            obstacles += count;
+        }
+
+        std::printf("%s: ok, %d difficulties, %d levels, %d authored obstacles, %zu bytes, hash %016llx\n",
+            opt.check.c_str(), pack.GetDifficultyCount(), pack.GetLevelCount(), obstacles, pack.GetSize(),
+            (unsigned long long)pack.GetHash());
+        return 0;
+    }
+
+    int Builtin(const Options& opt)
+    {
+        LevelManager presets;
+        presets.UseBuiltinPack();
+
+        FILE* file = std::fopen(opt.builtin.c_str(), "wb");
+        if (!file) {
+            std::fprintf(stderr, "cannot write %s\n", opt.builtin.c_str());
+            return 1;
+        }
+        std::string text = LevelPackCompiler::ToText(presets.GetPack());
+        bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+        ok = std::fclose(file) == 0 && ok;
+        if (!ok) {
+            std::fprintf(stderr, "cannot write %s\n", opt.builtin.c_str());
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage();
+        return 2;
+    }
+
+    if (!opt.dump.empty()) return Dump(opt);
+    if (!opt.check.empty()) return Check(opt);
+    if (!opt.builtin.empty()) return Builtin(opt);
+
+    bool ok = CompileFile(opt);
+    if (opt.watch) return Watch(opt);
+    return ok ? 0 : 1;
+}
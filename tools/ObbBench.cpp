@@ -0,0 +1,262 @@
+// Rocket-vs-obstacle OBB narrow-phase benchmark + property test.
+//
+// Times one overlap test per rocket/obstacle pair several ways:
+//   rebuild  MovingObstacle::CheckCollisionOBB, which poses both boxes
+//            (cos/sin) and normalizes every SAT axis on every call
+//   cached   rocket box built once, obstacle boxes from the axes that
+//            ObstacleField caches, SAT on the stored unit axes
+//   scalar / sse2 / avx2
+//            OverlapKernels: half-extent SAT over the field's arrays,
+//            4 or 8 obstacles per instruction, hit bitmask out
+//
+// The property test runs randomized scenes (odd counts, thin boxes,
+// axis-aligned and right-angle poses) and requires every method to agree
+// with CheckCollisionOBB on every pair, and every SIMD mask to equal the
+// scalar kernel's. Exit code is non-zero otherwise.
+//
+//   obb_bench [--pairs N]   verify + benchmark
+//   obb_bench --verify      property test only
+
+#include "ObstacleField.h"
+#include "OverlapKernels.h"
+#include "SimMath.h"
+#include "SweptCollision.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const Vector2 ROCKET_HALF = { 5.0f, 15.0f };
+
+    const OverlapKernels::Path kPaths[] = {
+        OverlapKernels::Path::SCALAR,
+        OverlapKernels::Path::SSE2,
+        OverlapKernels::Path::AVX2
+    };
+
+    using Kernel = int (*)(const SimMath::OrientedBox&, const float*, const float*,
+        const float*, const float*, const float*, const float*, int, uint32_t*);
+
+    Kernel KernelFor(OverlapKernels::Path path)
+    {
+        switch (path) {
+        case OverlapKernels::Path::SSE2: return OverlapKernels::OverlapsSSE2;
+        case OverlapKernels::Path::AVX2: return OverlapKernels::OverlapsAVX2;
+        default:                         return OverlapKernels::OverlapsScalar;
+        }
+    }
+
+    /// Obstacles as descriptors (reference) and as kernel input arrays.
+    struct Scene {
+        std::vector<MovingObstacle> aos;
+        ObstacleField field;
+        std::vector<int> slot;   // descriptor index -> field index
+        std::vector<float> centerX, centerY, halfW, halfH, axisCos, axisSin;
+        std::vector<uint32_t> mask;
+        Vector2 rocketCenter = { 0.0f, 0.0f };
+        float rocketRotation = 0.0f;
+
+        int Size() const { return (int)aos.size(); }
+
+        int Run(Kernel k, const SimMath::OrientedBox& rocket)
+        {
+            return k(rocket, centerX.data(), centerY.data(), halfW.data(), halfH.data(),
+                axisCos.data(), axisSin.data(), Size(), mask.data());
+        }
+
+        bool MaskBit(int i) const { return (mask[i >> 5] >> (i & 31)) & 1u; }
+    };
+
+    /// Static obstacles around the rocket; @p spread controls the hit rate.
+    void Build(Scene& s, int count, unsigned seed, float spread)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> offset(-spread, spread);
+        std::uniform_real_distribution<float> width(2.0f, 80.0f);
+        std::uniform_real_distribution<float> height(1.0f, 18.0f);
+        std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+        std::uniform_int_distribution<int> kind(0, 3);
+
+        // A quarter of the poses are exact multiples of 90 degrees, where
+        // edges line up and projections tie
+        auto pose = [&]() { return kind(rng) == 0 ? 90.0f * (float)(kind(rng) - 1) : angle(rng); };
+
+        s.aos.clear();
+        s.aos.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            float w = width(rng), h = height(rng);
+            s.aos.emplace_back(Rectangle{ offset(rng) - w * 0.5f, offset(rng) - h * 0.5f, w, h },
+                ObstaclePattern::STATIC, 0.0f, 0.0f, 0.0f, 0.0f);
+            s.aos.back().startRotation = pose();
+            s.aos.back().SetTime(0.0);
+        }
+        s.field.Assign(s.aos);
+
+        // Kernel arrays follow the descriptor order
+        s.slot.resize(count);
+        for (int i = 0; i < count; ++i) s.slot[s.field.GetSourceIndex(i)] = i;
+
+        s.centerX.resize(count);
+        s.centerY.resize(count);
+        s.halfW.resize(count);
+        s.halfH.resize(count);
+        s.axisCos.resize(count);
+        s.axisSin.resize(count);
+        for (int i = 0; i < count; ++i) {
+            SimMath::OrientedBox box;
+            s.field.GetBox(s.slot[i], box);
+            s.centerX[i] = box.center.x;
+            s.centerY[i] = box.center.y;
+            s.halfW[i] = box.half.x;
+            s.halfH[i] = box.half.y;
+            s.axisCos[i] = box.axes[0].x;
+            s.axisSin[i] = box.axes[0].y;
+        }
+        s.mask.assign(OverlapKernels::MaskWords(count), 0u);
+
+        s.rocketCenter = { offset(rng) * 0.1f, offset(rng) * 0.1f };
+        s.rocketRotation = pose();
+    }
+
+    // -------------------- PROPERTY TEST --------------------
+    bool Verify()
+    {
+        // Odd sizes exercise the 4-wide block and the scalar tails
+        const int sizes[] = { 0, 1, 3, 4, 5, 7, 8, 9, 12, 31, 33, 100, 1021 };
+        const int seedsPerSize = 40;
+        bool ok = true;
+        long long pairs = 0, hits = 0;
+
+        Scene s;
+        for (int n : sizes) {
+            for (int seed = 0; seed < seedsPerSize; ++seed) {
+                Build(s, n, 7919u * n + seed, 20.0f + 2.0f * seed);
+
+                SimMath::OrientedBox rocket;
+                SimMath::BuildOrientedBox(s.rocketCenter, ROCKET_HALF, s.rocketRotation, rocket);
+
+                std::vector<unsigned char> reference(n);
+                for (int i = 0; i < n; ++i) {
+                    reference[i] = s.aos[i].CheckCollisionOBB(s.rocketCenter, ROCKET_HALF, s.rocketRotation);
+                    hits += reference[i];
+
+                    SimMath::OrientedBox obstacle;
+                    s.field.GetBox(s.slot[i], obstacle);
+                    if (SweptCollision::Overlaps(obstacle, rocket) != (bool)reference[i]) {
+                        std::printf("MISMATCH: cached vs rebuild at n=%d seed=%d pair=%d\n", n, seed, i);
+                        ok = false;
+                    }
+                }
+                pairs += n;
+
+                s.Run(OverlapKernels::OverlapsScalar, rocket);
+                const std::vector<uint32_t> scalarMask = s.mask;
+
+                for (OverlapKernels::Path path : kPaths) {
+                    if (!OverlapKernels::IsSupported(path)) continue;
+
+                    int count = s.Run(KernelFor(path), rocket);
+                    int expected = 0;
+                    for (int i = 0; i < n; ++i) {
+                        expected += reference[i];
+                        if (s.MaskBit(i) != (bool)reference[i]) {
+                            std::printf("MISMATCH: %s vs rebuild at n=%d seed=%d pair=%d\n",
+                                OverlapKernels::PathName(path), n, seed, i);
+                            ok = false;
+                        }
+                    }
+                    if (count != expected || s.mask != scalarMask) {
+                        std::printf("MISMATCH: %s mask vs scalar at n=%d seed=%d\n",
+                            OverlapKernels::PathName(path), n, seed);
+                        ok = false;
+                    }
+                }
+            }
+        }
+
+        std::printf("property test: %s (%lld pairs, %lld overlapping, active path: %s)\n",
+            ok ? "ok" : "FAILED", pairs, hits, OverlapKernels::PathName(OverlapKernels::ActivePath()));
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    void Benchmark(int pairs)
+    {
+        Scene s;
+        Build(s, pairs, 2024u, 60.0f);
+
+        SimMath::OrientedBox rocket;
+        SimMath::BuildOrientedBox(s.rocketCenter, ROCKET_HALF, s.rocketRotation, rocket);
+
+        const int reps = pairs > 0 ? 1 + 800000 / pairs : 1;
+        std::vector<unsigned char> result(pairs);
+        volatile int sink = 0;
+
+        std::printf("\npairs: %d, %d reps\n", pairs, reps);
+        std::printf("%10s %12s %9s\n", "method", "ns/pair", "speedup");
+
+        auto report = [&](const char* name, Clock::time_point t0, Clock::time_point t1, double baseNs) {
+            double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)reps * pairs);
+            std::printf("%10s %12.2f %8.2fx\n", name, ns, baseNs > 0.0 ? baseNs / ns : 1.0);
+            return ns;
+        };
+
+        // Rebuild both boxes for every pair
+        auto t0 = Clock::now();
+        for (int r = 0; r < reps; ++r) {
+            for (int i = 0; i < pairs; ++i) {
+                result[i] = s.aos[i].CheckCollisionOBB(s.rocketCenter, ROCKET_HALF, s.rocketRotation);
+            }
+        }
+        double rebuildNs = report("rebuild", t0, Clock::now(), 0.0);
+
+        // Cached axes, one pair at a time
+        t0 = Clock::now();
+        for (int r = 0; r < reps; ++r) {
+            SimMath::OrientedBox rocketBox, obstacleBox;
+            SimMath::BuildOrientedBox(s.rocketCenter, ROCKET_HALF, s.rocketRotation, rocketBox);
+
+            for (int i = 0; i < pairs; ++i) {
+                s.field.GetBox(s.slot[i], obstacleBox);
+                result[i] = SweptCollision::Overlaps(obstacleBox, rocketBox);
+            }
+        }
+        report("cached", t0, Clock::now(), rebuildNs);
+
+        // Batched kernels
+        for (OverlapKernels::Path path : kPaths) {
+            if (!OverlapKernels::IsSupported(path)) continue;
+
+            Kernel k = KernelFor(path);
+            t0 = Clock::now();
+            for (int r = 0; r < reps; ++r) sink = sink + s.Run(k, rocket);
+            report(OverlapKernels::PathName(path), t0, Clock::now(), rebuildNs);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int pairs = 4096;
+    bool verifyOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--pairs" && i + 1 < argc) pairs = std::atoi(argv[++i]);
+        else if (arg == "--verify") verifyOnly = true;
+        else {
+            std::printf("usage: obb_bench [--pairs N] [--verify]\n");
+            return 2;
+        }
+    }
+
+    if (!Verify()) return 1;
+    if (!verifyOnly) Benchmark(pairs);
+    return 0;
+}
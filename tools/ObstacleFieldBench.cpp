@@ -0,0 +1,236 @@
+// ObstacleField benchmark + equivalence check.
+//
+// Verifies that every SIMD path the CPU supports poses obstacles exactly
+// like the scalar kernels, like MovingObstacle::Update (the AoS reference)
+// and like a direct ObstacleField::PoseAt jump to the same time, and that
+// deferred posing (SetTimeDeferred + Sync) reproduces full steps, then
+// times AoS vs SoA scalar vs each SIMD path at 1k / 100k / 1M obstacles. Exit code is non-zero on any mismatch.
+//
+//   obstacle_field_bench            verify + benchmark
+//   obstacle_field_bench --verify   equivalence check only
+
+#include "ObstacleField.h"
+#include "ObstacleKernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Path = ObstacleKernels::Path;
+
+    constexpr float TICK_DT = 1.0f / 120.0f;
+
+    std::vector<MovingObstacle> MakeObstacles(int n, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-2000.0f, 2000.0f);
+        std::uniform_real_distribution<float> size(8.0f, 80.0f);
+        std::uniform_int_distribution<int> pattern(0, 2);
+        std::uniform_real_distribution<float> amp(20.0f, 80.0f);
+        std::uniform_real_distribution<float> freq(0.5f, 1.5f);
+        std::uniform_real_distribution<float> phase(0.0f, 6.28f);
+        std::uniform_real_distribution<float> spin(-90.0f, 90.0f);
+
+        std::vector<MovingObstacle> obstacles;
+        obstacles.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            ObstaclePattern p = (ObstaclePattern)pattern(rng);
+            obstacles.emplace_back(Rectangle{ pos(rng), pos(rng), size(rng), size(rng) },
+                p, amp(rng), freq(rng), phase(rng), spin(rng));
+        }
+        return obstacles;
+    }
+
+    void UpdateField(ObstacleField& field, Path path)
+    {
+        // The field only exposes the scalar kernels and the dispatched best path
+        if (path == Path::SCALAR) field.UpdateScalar(TICK_DT);
+        else field.Update(TICK_DT);
+    }
+
+    bool SameBits(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+    // Raw kernel check: every path against the scalar reference, all sizes
+    bool VerifyKernels()
+    {
+        const int sizes[] = { 0, 1, 7, 31, 33, 1000, 4099 };
+        const Path paths[] = { Path::SSE2, Path::AVX2 };
+        bool ok = true;
+
+        for (int n : sizes) {
+            std::mt19937 rng(99u + n);
+            std::uniform_real_distribution<float> val(-500.0f, 500.0f);
+            std::vector<float> start(n), vel(n), freq(n), ph(n), amp(n), base(n);
+            for (int i = 0; i < n; ++i) {
+                start[i] = val(rng) * 20.0f; vel[i] = val(rng); freq[i] = val(rng) / 300.0f;
+                ph[i] = val(rng) / 80.0f; amp[i] = val(rng) / 5.0f; base[i] = val(rng);
+            }
+            const float t = 37.25f;
+
+            std::vector<float> refRot(n), refCenter(n);
+            ObstacleKernels::PoseScalar(start.data(), vel.data(), freq.data(), ph.data(),
+                amp.data(), base.data(), refRot.data(), refCenter.data(), n, t);
+
+            for (Path path : paths) {
+                if (!CpuFeatures::IsSupported(path)) continue;
+
+                std::vector<float> r(n), c(n);
+                auto kernel = path == Path::AVX2 ? ObstacleKernels::PoseAVX2 : ObstacleKernels::PoseSSE2;
+                kernel(start.data(), vel.data(), freq.data(), ph.data(), amp.data(), base.data(),
+                    r.data(), c.data(), n, t);
+
+                for (int i = 0; i < n; ++i) {
+                    if (!SameBits(r[i], refRot[i]) || !SameBits(c[i], refCenter[i])) {
+                        std::printf("MISMATCH: %s vs scalar at n=%d, i=%d\n", CpuFeatures::SimdPathName(path), n, i);
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+        }
+        return ok;
+    }
+
+    // Whole-field check: SoA (best path) against MovingObstacle over many steps
+    bool VerifyField()
+    {
+        std::vector<MovingObstacle> aos = MakeObstacles(5000, 7u);
+        ObstacleField field;
+        field.Assign(aos);
+
+        // Field order differs from the descriptors; map each AoS obstacle to its slot
+        std::vector<int> slot(aos.size());
+        for (int i = 0; i < field.Size(); ++i) slot[field.GetSourceIndex(i)] = i;
+
+        for (int step = 0; step < 600; ++step) {
+            for (auto& o : aos) o.Update(TICK_DT);
+            field.Update(TICK_DT);
+        }
+
+        // Stepped poses must equal a direct jump to the same level time
+        const float t = (float)field.GetTime();
+        for (size_t i = 0; i < aos.size(); ++i) {
+            ObstaclePose direct = field.PoseAt(slot[i], t);
+            if (!SameBits(direct.rotation, field.GetRotation(slot[i])) ||
+                !SameBits(direct.center.x, field.GetCenter(slot[i]).x) ||
+                !SameBits(direct.center.y, field.GetCenter(slot[i]).y)) {
+                std::printf("MISMATCH: field PoseAt vs stepped at %zu\n", i);
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < aos.size(); ++i) {
+            Vector2 c = field.GetCenter(slot[i]);
+            float cx = aos[i].rect.x + aos[i].rect.width * 0.5f;
+            float cy = aos[i].rect.y + aos[i].rect.height * 0.5f;
+
+            // Rotation must match bit for bit; the AoS center goes through a
+            // top-left round trip, so allow for that rounding
+            if (!SameBits(field.GetRotation(slot[i]), aos[i].rotation) ||
+                fabsf(c.x - cx) > 1e-3f || fabsf(c.y - cy) > 1e-3f) {
+                std::printf("MISMATCH: field vs MovingObstacle at %zu\n", i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SameBox(const SimMath::OrientedBox& a, const SimMath::OrientedBox& b)
+    {
+        return std::memcmp(&a, &b, sizeof(a)) == 0;
+    }
+
+    // Deferred posing: obstacles synced after skipped steps (one at a time
+    // or batched) must hold exactly the poses of a field posed every step
+    bool VerifyDeferred()
+    {
+        std::vector<MovingObstacle> aos = MakeObstacles(3000, 11u);
+        ObstacleField full, deferred;
+        full.Assign(aos);
+        deferred.Assign(aos);
+
+        std::vector<int> ids;
+        for (int step = 0; step < 240; ++step) {
+            full.Update(TICK_DT);
+
+            // Every few steps one full pass, otherwise a shifting subset
+            if (step % 50 == 49) {
+                deferred.Update(TICK_DT);
+            }
+            else {
+                deferred.SetTimeDeferred(deferred.GetTime() + TICK_DT);
+                ids.clear();
+                for (int i = 0; i < deferred.Size(); ++i) {
+                    if ((i + step) % 5 == 0) ids.push_back(i);
+                    else if ((i * 7 + step) % 11 == 0) deferred.Sync(i);
+                }
+                deferred.SyncMany(ids.data(), (int)ids.size());
+            }
+
+            for (int i = 0; i < deferred.Size(); ++i) {
+                if (!deferred.IsPosed(i)) continue;
+
+                SimMath::OrientedBox a, b, pa, pb;
+                full.GetBox(i, a);
+                deferred.GetBox(i, b);
+                full.GetPrevBox(i, pa);
+                deferred.GetPrevBox(i, pb);
+                if (!SameBox(a, b) || !SameBox(pa, pb)) {
+                    std::printf("MISMATCH: deferred vs full at step %d, i=%d\n", step, i);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    // -------------------- EQUIVALENCE --------------------
+    bool ok = VerifyKernels() && VerifyField() && VerifyDeferred();
+    std::printf("equivalence: %s (active path: %s)\n",
+        ok ? "ok" : "FAILED", CpuFeatures::SimdPathName(ObstacleKernels::ActivePath()));
+    if (!ok) return 1;
+    if (verifyOnly) return 0;
+
+    // -------------------- BENCHMARK --------------------
+    const int sizes[] = { 1000, 100000, 1000000 };
+
+    std::printf("\n%10s %10s %14s %10s\n", "obstacles", "layout", "ns/obstacle", "speedup");
+    for (int n : sizes) {
+        std::vector<MovingObstacle> aos = MakeObstacles(n, 42u);
+        ObstacleField field;
+        field.Assign(aos);
+
+        int steps = n >= 1000000 ? 20 : (n >= 100000 ? 100 : 5000);
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int s = 0; s < steps; ++s) {
+            for (auto& o : aos) o.Update(TICK_DT);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        double aosNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)steps * n);
+        std::printf("%10d %10s %14.3f %9.2fx\n", n, "aos", aosNs, 1.0);
+
+        const Path paths[] = { Path::SCALAR, ObstacleKernels::ActivePath() };
+        for (Path path : paths) {
+            t0 = std::chrono::steady_clock::now();
+            for (int s = 0; s < steps; ++s) UpdateField(field, path);
+            t1 = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)steps * n);
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "soa-%s", CpuFeatures::SimdPathName(path));
+            std::printf("%10d %10s %14.3f %9.2fx\n", n, name, ns, ns > 0.0 ? aosNs / ns : 0.0);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,313 @@
+// Particle integration kernel benchmark + equivalence check.
+//
+// Verifies that every SIMD path the CPU supports is bit-identical to the
+// scalar reference, that a full ParticlePool spawns, integrates and evicts
+// without touching the heap, and that it evicts in the documented order. Then
+// times each path at 1k / 100k / 1M particles and evicting spawns into full
+// pools. Exit code is non-zero if any check fails.
+//
+//   ParticleKernelBench            verify + benchmark
+//   ParticleKernelBench --verify   equivalence check only
+
+#include "ParticleKernels.h"
+#include "ParticlePool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+// Every heap allocation in the process, so the pool check below observes
+// real allocations rather than trusting the pool's own word
+static std::atomic<long long> gAllocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+    struct Streams {
+        std::vector<float> posX, posY, velX, velY, life;
+        std::vector<uint32_t> mask;
+
+        explicit Streams(int n)
+            : posX(n), posY(n), velX(n), velY(n), life(n),
+            mask(ParticleKernels::MaskWords(n))
+        {
+        }
+    };
+
+    void Fill(Streams& s, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> vel(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> life(-0.1f, 0.7f);
+
+        for (size_t i = 0; i < s.posX.size(); ++i) {
+            s.posX[i] = pos(rng);
+            s.posY[i] = pos(rng);
+            s.velX[i] = vel(rng);
+            s.velY[i] = vel(rng);
+            s.life[i] = life(rng);
+        }
+    }
+
+    using Kernel = int (*)(float*, float*, const float*, const float*,
+        float*, int, float, uint32_t*);
+
+    Kernel KernelFor(ParticleKernels::Path path)
+    {
+        switch (path) {
+        case ParticleKernels::Path::SSE2: return ParticleKernels::IntegrateSSE2;
+        case ParticleKernels::Path::AVX2: return ParticleKernels::IntegrateAVX2;
+        default:                          return ParticleKernels::IntegrateScalar;
+        }
+    }
+
+    int Run(Kernel k, Streams& s, float dt)
+    {
+        return k(s.posX.data(), s.posY.data(), s.velX.data(), s.velY.data(),
+            s.life.data(), (int)s.posX.size(), dt, s.mask.data());
+    }
+
+    bool SameBits(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        return std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    const ParticleKernels::Path kPaths[] = {
+        ParticleKernels::Path::SCALAR,
+        ParticleKernels::Path::SSE2,
+        ParticleKernels::Path::AVX2
+    };
+
+    // -------------------- EQUIVALENCE --------------------
+    bool Verify()
+    {
+        // Odd sizes exercise the scalar tails of the SIMD loops
+        const int sizes[] = { 0, 1, 7, 31, 33, 1000, 4099 };
+        const float dt = 1.0f / 120.0f;
+        bool ok = true;
+
+        for (int n : sizes) {
+            Streams ref(n);
+            Fill(ref, 1234u + n);
+            int refDead = 0;
+            for (int step = 0; step < 16; ++step) refDead = Run(ParticleKernels::IntegrateScalar, ref, dt);
+
+            for (ParticleKernels::Path path : kPaths) {
+                if (!ParticleKernels::IsSupported(path)) continue;
+
+                Streams s(n);
+                Fill(s, 1234u + n);
+                int dead = 0;
+                for (int step = 0; step < 16; ++step) dead = Run(KernelFor(path), s, dt);
+
+                bool same = dead == refDead &&
+                    SameBits(s.posX, ref.posX) && SameBits(s.posY, ref.posY) &&
+                    SameBits(s.life, ref.life) && s.mask == ref.mask;
+
+                if (!same) {
+                    std::printf("MISMATCH: %s vs scalar at n=%d\n", ParticleKernels::PathName(path), n);
+                    ok = false;
+                }
+            }
+        }
+
+        std::printf("equivalence: %s (active path: %s)\n",
+            ok ? "bit-exact" : "FAILED",
+            ParticleKernels::PathName(ParticleKernels::ActivePath()));
+        return ok;
+    }
+
+    // -------------------- POOL ALLOCATIONS --------------------
+    bool VerifyPoolAllocations()
+    {
+        const int capacity = 4099;
+        ParticlePool pool(capacity);
+        const float* streams[] = { pool.PositionX(), pool.PositionY(), pool.VelocityX(),
+            pool.VelocityY(), pool.Life() };
+        const Color* colors = pool.Colors();
+
+        // Over-spawn so most frames run full and evict, with lifetimes that
+        // make every integration kill a few
+        std::mt19937 rng(7u);
+        std::uniform_real_distribution<float> life(0.0f, 0.5f);
+        const long long before = gAllocations.load(std::memory_order_relaxed);
+        for (int frame = 0; frame < 600; ++frame) {
+            for (int i = 0; i < 300; ++i) {
+                pool.Spawn({ 1.0f, 2.0f }, { 3.0f, 4.0f }, life(rng), WHITE, (uint8_t)(i % 3));
+            }
+            pool.Integrate(1.0f / 120.0f);
+            if (frame % 100 == 99) pool.Clear();
+        }
+        const long long allocations = gAllocations.load(std::memory_order_relaxed) - before;
+
+        const float* after[] = { pool.PositionX(), pool.PositionY(), pool.VelocityX(),
+            pool.VelocityY(), pool.Life() };
+        bool ok = allocations == 0 && std::memcmp(streams, after, sizeof(streams)) == 0 &&
+            colors == pool.Colors() && pool.GetEvictionCount() > 0;
+
+        std::printf("pool: %lld heap allocations over 600 frames, %u evictions: %s\n",
+            allocations, pool.GetEvictionCount(), ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+    // -------------------- POOL EVICTION ORDER --------------------
+    // Random spawns, kills and integrations against a brute-force model of
+    // the eviction rule (lowest priority, then oldest). Each particle's id
+    // rides in its x position, which zero velocity leaves alone.
+    bool VerifyPoolEviction()
+    {
+        struct Live { int id; int priority; int birth; };
+        const int capacity = 257;
+        ParticlePool pool(capacity);
+        std::vector<Live> model;
+        std::mt19937 rng(11u);
+        const uint8_t priorities[] = { 0, 1, 2, 3, 64, 200, 255 };
+        int nextId = 0;
+        bool ok = true;
+
+        for (int op = 0; op < 40000 && ok; ++op) {
+            int kind = (int)(rng() % 16);
+            if (kind == 0 && pool.Count() > 0) {
+                int index = (int)(rng() % pool.Count());
+                int id = (int)pool.PositionX()[index];
+                pool.Kill(index);
+                for (size_t i = 0; i < model.size(); ++i) {
+                    if (model[i].id == id) { model.erase(model.begin() + i); break; }
+                }
+            }
+            else if (kind == 1) {
+                pool.Integrate(0.01f);
+                std::vector<Live> alive;
+                for (const Live& l : model) {
+                    for (int i = 0; i < pool.Count(); ++i) {
+                        if ((int)pool.PositionX()[i] == l.id) { alive.push_back(l); break; }
+                    }
+                }
+                model.swap(alive);
+            }
+            else {
+                int p = priorities[rng() % 7 < 4 ? rng() % 4 : 4 + rng() % 3];
+                int id = nextId++;
+                float life = 0.01f * (float)(1 + rng() % 50);
+                int slot = pool.Spawn({ (float)id, 0.0f }, {}, life, WHITE, (uint8_t)p);
+
+                if ((int)model.size() == capacity) {
+                    size_t victim = 0;
+                    for (size_t i = 1; i < model.size(); ++i) {
+                        if (model[i].priority < model[victim].priority ||
+                            (model[i].priority == model[victim].priority && model[i].birth < model[victim].birth)) {
+                            victim = i;
+                        }
+                    }
+                    if (model[victim].priority > p) {
+                        ok = slot == -1;
+                        continue;
+                    }
+                    model.erase(model.begin() + victim);
+                }
+                model.push_back({ id, p, id });
+                ok = slot >= 0;
+            }
+
+            // Same particles live in pool and model?
+            std::vector<int> inPool, inModel;
+            for (int i = 0; i < pool.Count(); ++i) inPool.push_back((int)pool.PositionX()[i]);
+            for (const Live& l : model) inModel.push_back(l.id);
+            std::sort(inPool.begin(), inPool.end());
+            std::sort(inModel.begin(), inModel.end());
+            if (inPool != inModel) ok = false;
+        }
+
+        std::printf("pool eviction order: %s (%u evictions, %u rejects)\n",
+            ok ? "matches reference" : "FAILED", pool.GetEvictionCount(), pool.GetRejectCount());
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    void Benchmark()
+    {
+        const int sizes[] = { 1000, 100000, 1000000 };
+        const float dt = 1.0f / 120.0f;
+        const double targetUpdates = 2e8; // particle-steps per measurement
+
+        std::printf("\n%10s %8s %12s %10s\n", "particles", "path", "ns/particle", "speedup");
+
+        for (int n : sizes) {
+            int iterations = (int)(targetUpdates / n);
+            if (iterations < 10) iterations = 10;
+
+            double scalarNs = 0.0;
+            for (ParticleKernels::Path path : kPaths) {
+                if (!ParticleKernels::IsSupported(path)) continue;
+
+                Streams s(n);
+                Fill(s, 99u);
+                Kernel k = KernelFor(path);
+                Run(k, s, dt); // warm caches
+
+                auto start = std::chrono::steady_clock::now();
+                volatile int sink = 0;
+                for (int it = 0; it < iterations; ++it) sink = sink + Run(k, s, dt);
+                auto end = std::chrono::steady_clock::now();
+
+                double ns = std::chrono::duration<double, std::nano>(end - start).count() /
+                    ((double)iterations * n);
+                if (path == ParticleKernels::Path::SCALAR) scalarNs = ns;
+
+                std::printf("%10d %8s %12.3f %9.2fx\n", n, ParticleKernels::PathName(path), ns,
+                    scalarNs > 0.0 ? scalarNs / ns : 1.0);
+            }
+        }
+    }
+    // Spawn bursts into a pool that is already full, so every spawn evicts:
+    // the cost the budget is meant to keep bounded
+    void BenchmarkEviction()
+    {
+        const int capacities[] = { 1000, 16384, 65536 };
+        const int burst = 1000;
+
+        std::printf("\n%10s %8s %12s\n", "capacity", "burst", "ns/spawn");
+        for (int capacity : capacities) {
+            ParticlePool pool(capacity);
+            for (int i = 0; i < capacity; ++i) pool.Spawn({}, {}, 1.0f, WHITE, (uint8_t)(i % 3));
+
+            const int bursts = 2000000 / capacity + 20;
+            auto start = std::chrono::steady_clock::now();
+            for (int b = 0; b < bursts; ++b) {
+                for (int i = 0; i < burst; ++i) pool.Spawn({}, {}, 1.0f, WHITE, (uint8_t)(i % 3));
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            double ns = std::chrono::duration<double, std::nano>(end - start).count() / ((double)bursts * burst);
+            std::printf("%10d %8d %12.1f\n", capacity, burst, ns);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    if (!Verify() || !VerifyPoolAllocations() || !VerifyPoolEviction()) return 1;
+    if (!verifyOnly) {
+        Benchmark();
+        BenchmarkEviction();
+    }
+    return 0;
+}
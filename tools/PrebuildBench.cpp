@@ -0,0 +1,241 @@
+// Background level build benchmark + equivalence check.
+//
+// Verifies that levels built on LevelManager's worker thread and swapped in
+// are bit-identical to the same levels built synchronously: the WIN -> ENTER
+// chain through every level and difficulty, menu selections that replace
+// each other before the worker gets to them, and a request whose seed was
+// drawn by a synchronous rebuild in the meantime. Checks that swapping a
+// finished level in allocates nothing. Then times the main thread's part of
+// AdvanceToNextLevel() with and without a prebuilt level.
+// Exit code is non-zero on any mismatch or allocation.
+//
+//   prebuild_bench            verify + benchmark
+//   prebuild_bench --verify   equivalence check only
+
+#include "LevelManager.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+// -------------------- ALLOCATION COUNTER --------------------
+// Counts every global new in this process (worker included); the checks
+// only read it while the worker is idle
+namespace
+{
+    std::atomic<long long> g_allocations(0);
+}
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float TICK_DT = 1.0f / SimulationClock::DEFAULT_TICK_RATE;
+
+    bool SameBits(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+    // Every pose, current and previous, plus the rocket and run state (hash)
+    bool SameWorld(const Simulation& a, const Simulation& b)
+    {
+        if (a.GetStateHash() != b.GetStateHash() || a.obstacles.Size() != b.obstacles.Size()) return false;
+
+        std::vector<float> pa(a.obstacles.GetPoseFloats()), pb(b.obstacles.GetPoseFloats());
+        a.obstacles.CopyPosesTo(pa.data());
+        b.obstacles.CopyPosesTo(pb.data());
+        for (size_t i = 0; i < pa.size(); ++i) {
+            if (!SameBits(pa[i], pb[i])) return false;
+        }
+        return SameBits(a.rocket.prevPosition.x, b.rocket.prevPosition.x) &&
+            SameBits(a.rocket.prevPosition.y, b.rocket.prevPosition.y) &&
+            SameBits(a.rocket.prevRotation, b.rocket.prevRotation);
+    }
+
+    bool SameLevel(const LevelManager& a, const Simulation& sa, const LevelManager& b, const Simulation& sb)
+    {
+        return a.GetDifficultyIndex() == b.GetDifficultyIndex() && a.GetLevelIndex() == b.GetLevelIndex() &&
+            a.GetLayoutSeed() == b.GetLayoutSeed() && SameWorld(sa, sb);
+    }
+
+    // Fly a little so a swap has a used world to replace
+    void Fly(Simulation& sim, int ticks)
+    {
+        ControlInput input;
+        input.throttle = 1.0f;
+        input.rotate = -0.3f;
+        for (int t = 0; t < ticks && sim.GetOutcome() == SimOutcome::RUNNING; ++t) sim.Step(input, TICK_DT);
+    }
+
+    void WaitReady(LevelManager& levels)
+    {
+        while (!levels.IsPrebuildReady()) std::this_thread::yield();
+    }
+
+    bool Check(const char* what, bool ok)
+    {
+        std::printf("%-52s %s\n", what, ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+    // -------------------- EQUIVALENCE --------------------
+    bool Verify()
+    {
+        bool ok = true;
+
+        // WIN -> ENTER through every level of every difficulty
+        {
+            Simulation sim, ref;
+            LevelManager levels(11), reference(11);
+            levels.Init(sim);
+            reference.Init(ref);
+
+            bool same = true;
+            long long allocations = 0;
+            for (int d = 0; d < levels.GetDifficultyCount(); ++d) {
+                levels.SetDifficulty(d, sim);
+                reference.SetDifficulty(d, ref);
+                for (int l = 0; l < levels.GetLevelCount(); ++l) {
+                    Fly(sim, 200);
+                    levels.PrebuildNextLevel();
+                    WaitReady(levels);
+
+                    long long before = g_allocations.load();
+                    levels.AdvanceToNextLevel(sim);
+                    allocations += g_allocations.load() - before;
+
+                    reference.AdvanceToNextLevel(ref);
+                    same = same && !levels.HasPrebuild() && SameLevel(levels, sim, reference, ref);
+                }
+            }
+            ok &= Check("next level: prebuilt == synchronous", same);
+            ok &= Check("next level: swap allocates nothing", allocations == 0);
+
+            // Restart after a swap restores the swapped-in level
+            uint64_t seed = levels.GetLayoutSeed();
+            Fly(sim, 300);
+            levels.RestartCurrentLevel(sim);
+            Fly(ref, 300);
+            reference.RestartCurrentLevel(ref);
+            ok &= Check("restart after a swap", levels.GetLayoutSeed() == seed && SameLevel(levels, sim, reference, ref));
+        }
+
+        // Menu: selections replace each other faster than the worker builds
+        {
+            Simulation sim, ref;
+            LevelManager levels(23), reference(23);
+            levels.Init(sim);
+            reference.Init(ref);
+
+            bool same = true;
+            for (int round = 0; round < 20; ++round) {
+                levels.Prebuild(round % 3, round % 6);
+                levels.Prebuild((round + 1) % 3, (round + 4) % 6);
+
+                // A frame that may or may not find it finished (then it is shown)
+                if (levels.SwapInPrebuilt(sim, false)) {
+                    reference.SetPreset((round + 1) % 3, (round + 4) % 6, ref);
+                    ref.ResetRun();
+                }
+                int d = (round * 2) % 3, l = (round * 5) % 6;
+                levels.Prebuild(d, l);
+                bool selected = levels.GetSelectedDifficultyIndex() == d && levels.GetSelectedLevelIndex() == l;
+                levels.SwapInPrebuilt(sim, true);
+
+                reference.SetPreset(d, l, ref);
+                ref.ResetRun();
+                same = same && selected && SameLevel(levels, sim, reference, ref);
+            }
+            ok &= Check("menu: latest selection wins, == synchronous", same);
+        }
+
+        // A synchronous rebuild draws the seed the request was built from
+        {
+            Simulation sim, ref;
+            LevelManager levels(31), reference(31);
+            levels.Init(sim);
+            reference.Init(ref);
+
+            levels.Prebuild(2, 3);
+            WaitReady(levels);
+            levels.SetDifficulty(0, sim);
+            levels.SwapInPrebuilt(sim, true);
+
+            reference.SetDifficulty(0, ref);
+            reference.SetPreset(2, 3, ref);
+            ref.ResetRun();
+            ok &= Check("stale request rebuilt from the next seed", SameLevel(levels, sim, reference, ref));
+
+            // Cancelled requests are never swapped in
+            levels.Prebuild(1, 1);
+            levels.CancelPrebuild();
+            ok &= Check("cancelled request is dropped", !levels.SwapInPrebuilt(sim, true) && SameLevel(levels, sim, reference, ref));
+        }
+
+        std::printf("equivalence: %s\n", ok ? "bit-exact" : "FAILED");
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    void Benchmark()
+    {
+        std::printf("\n%-12s %16s %16s %16s %9s\n", "difficulty", "synchronous us", "prebuilt us", "worker build us", "speedup");
+
+        const int iterations = 2000;
+        LevelManager presets;
+        presets.UseBuiltinPack();
+        for (int d = 0; d < presets.GetDifficultyCount(); ++d) {
+            Simulation sim;
+            LevelManager levels(5);
+            levels.Init(sim);
+            levels.SetDifficulty(d, sim);
+
+            double sync = 0.0;
+            for (int i = 0; i < iterations; ++i) {
+                auto start = Clock::now();
+                levels.AdvanceToNextLevel(sim);
+                sync += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            }
+
+            double swap = 0.0, build = 0.0;
+            for (int i = 0; i < iterations; ++i) {
+                auto start = Clock::now();
+                levels.PrebuildNextLevel();
+                WaitReady(levels);
+                auto ready = Clock::now();
+                levels.AdvanceToNextLevel(sim);
+                swap += std::chrono::duration<double, std::micro>(Clock::now() - ready).count();
+                build += std::chrono::duration<double, std::micro>(ready - start).count();
+            }
+
+            sync /= iterations;
+            swap /= iterations;
+            build /= iterations;
+            std::printf("%-12s %16.3f %16.3f %16.3f %8.0fx\n", levels.GetDifficultyName(), sync, swap, build, sync / swap);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    if (!Verify()) return 1;
+    if (!verifyOnly) Benchmark();
+    return 0;
+}
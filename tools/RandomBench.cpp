@@ -0,0 +1,182 @@
+// Random number generator benchmark + sanity check.
+//
+// Checks that Pcg32::Fill matches one-at-a-time draws, that a CounterRng
+// fill split across threads matches a serial one, that streams of the same
+// seed differ, and that each generator's floats are roughly uniform. Then
+// times uniform floats from rand(), std::mt19937, Pcg32 and CounterRng,
+// one at a time and in batches.
+// Exit code is non-zero if any check fails.
+//
+//   random_bench            check + benchmark
+//   random_bench --verify   checks only
+
+#include "Random.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // -------------------- CHECKS --------------------
+    // Chi-square of 256 equal buckets; 255 degrees of freedom, so anything
+    // under ~330 (p = 0.001) is unremarkable
+    double ChiSquare(const std::vector<float>& values)
+    {
+        constexpr int BUCKETS = 256;
+        long long counts[BUCKETS] = {};
+        for (float v : values) {
+            int b = (int)(v * BUCKETS);
+            counts[b < 0 ? 0 : (b >= BUCKETS ? BUCKETS - 1 : b)]++;
+        }
+        double expected = (double)values.size() / BUCKETS;
+        double chi = 0.0;
+        for (long long c : counts) chi += (c - expected) * (c - expected) / expected;
+        return chi;
+    }
+
+    bool Check(const char* what, bool ok)
+    {
+        std::printf("%-44s %s\n", what, ok ? "ok" : "FAILED");
+        return ok;
+    }
+
+    void FillSplit(const CounterRng& rng, std::vector<float>& out, int threads)
+    {
+        std::vector<std::thread> workers;
+        size_t per = (out.size() + threads - 1) / threads;
+        for (int t = 0; t < threads; ++t) {
+            size_t first = (size_t)t * per;
+            if (first >= out.size()) break;
+            size_t count = out.size() - first < per ? out.size() - first : per;
+            workers.emplace_back([&rng, &out, first, count]() { rng.Fill(first, out.data() + first, count); });
+        }
+        for (auto& w : workers) w.join();
+    }
+
+    bool Verify()
+    {
+        const size_t n = 1 << 20;
+        bool ok = true;
+
+        Pcg32 a(42, RngStream::EFFECTS);
+        Pcg32 b(42, RngStream::EFFECTS);
+        std::vector<float> filled(n), single(n);
+        a.Fill(filled.data(), n, -3.0f, 5.0f);
+        for (size_t i = 0; i < n; ++i) single[i] = b.Range(-3.0f, 5.0f);
+        ok &= Check("Pcg32::Fill matches Range()", std::memcmp(filled.data(), single.data(), n * sizeof(float)) == 0);
+
+        CounterRng counter(42, RngStream::EFFECTS);
+        std::vector<float> serial(n), split(n);
+        counter.Fill(0, serial.data(), n);
+        FillSplit(counter, split, 7);
+        ok &= Check("CounterRng fill on 7 threads matches serial", std::memcmp(serial.data(), split.data(), n * sizeof(float)) == 0);
+
+        std::vector<float> tail(1000);
+        counter.Fill(n - 1000, tail.data(), tail.size());
+        ok &= Check("CounterRng fill from an offset matches", std::memcmp(tail.data(), &serial[n - 1000], 1000 * sizeof(float)) == 0);
+
+        Pcg32 other(42, RngStream::TERRAIN);
+        CounterRng otherCounter(42, RngStream::TERRAIN);
+        int sameP = 0, sameC = 0;
+        Pcg32 again(42, RngStream::EFFECTS);
+        for (int i = 0; i < 1000; ++i) {
+            sameP += other.NextU32() == again.NextU32();
+            sameC += otherCounter.At((uint64_t)i) == counter.At((uint64_t)i);
+        }
+        ok &= Check("streams of one seed are independent", sameP == 0 && sameC == 0);
+
+        Pcg32 unit(7);
+        unit.Fill(filled.data(), n);
+        double chiP = ChiSquare(filled);
+        double chiC = ChiSquare(serial);
+        char line[64];
+        std::snprintf(line, sizeof(line), "uniformity (chi^2: Pcg32 %.0f, Counter %.0f)", chiP, chiC);
+        ok &= Check(line, chiP < 330.0 && chiC < 330.0);
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    template <typename F>
+    double TimeNs(size_t n, F&& fill)
+    {
+        fill(); // warm up
+        auto start = std::chrono::steady_clock::now();
+        const int repeats = 8;
+        for (int r = 0; r < repeats; ++r) fill();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / ((double)n * repeats);
+    }
+
+    void Benchmark()
+    {
+        const size_t n = 1 << 20;
+        std::vector<float> out(n);
+        volatile float sink = 0.0f;
+        int threads = (int)std::thread::hardware_concurrency();
+        if (threads < 1) threads = 1;
+
+        std::printf("\n%-28s %12s %10s\n", "generator", "ns/float", "vs rand()");
+
+        std::srand(1);
+        double randNs = TimeNs(n, [&]() {
+            for (size_t i = 0; i < n; ++i) out[i] = (float)std::rand() / RAND_MAX;
+            sink = sink + out[n - 1];
+        });
+
+        std::mt19937 mt(1);
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        double mtNs = TimeNs(n, [&]() {
+            for (size_t i = 0; i < n; ++i) out[i] = dist(mt);
+            sink = sink + out[n - 1];
+        });
+
+        Pcg32 pcg(1, RngStream::EFFECTS);
+        double pcgNs = TimeNs(n, [&]() {
+            for (size_t i = 0; i < n; ++i) out[i] = pcg.NextFloat();
+            sink = sink + out[n - 1];
+        });
+        double pcgFillNs = TimeNs(n, [&]() {
+            pcg.Fill(out.data(), n);
+            sink = sink + out[n - 1];
+        });
+
+        CounterRng counter(1, RngStream::EFFECTS);
+        uint64_t next = 0;
+        double counterFillNs = TimeNs(n, [&]() {
+            counter.Fill(next, out.data(), n);
+            next += n;
+            sink = sink + out[n - 1];
+        });
+        double counterSplitNs = TimeNs(n, [&]() {
+            FillSplit(counter, out, threads);
+            sink = sink + out[n - 1];
+        });
+
+        auto row = [&](const char* name, double ns) {
+            std::printf("%-28s %12.3f %9.2fx\n", name, ns, randNs / ns);
+        };
+        row("rand()", randNs);
+        row("std::mt19937", mtNs);
+        row("Pcg32::NextFloat", pcgNs);
+        row("Pcg32::Fill", pcgFillNs);
+        row("CounterRng::Fill", counterFillNs);
+        char name[40];
+        std::snprintf(name, sizeof(name), "CounterRng::Fill x%d threads", threads);
+        row(name, counterSplitNs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    if (!Verify()) return 1;
+    if (!verifyOnly) Benchmark();
+    return 0;
+}
@@ -0,0 +1,223 @@
+// Level restart benchmark + equivalence check.
+//
+// Verifies that LevelManager::RestartCurrentLevel (a LevelSnapshot restore)
+// puts every preset back exactly as a fresh build of the same layout seed
+// would, obstacle poses included, even after a run has moved everything,
+// and that it allocates nothing. Then times snapshot restores against
+// rebuilding, for the presets and for synthetic fields of 1k / 10k / 100k
+// obstacles. Exit code is non-zero on any mismatch or allocation.
+//
+//   restart_bench            verify + benchmark
+//   restart_bench --verify   equivalence check only
+
+#include "LevelManager.h"
+#include "LevelSnapshot.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+// -------------------- ALLOCATION COUNTER --------------------
+// Counts every global new in this process; the checks read it around restarts
+namespace
+{
+    std::atomic<long long> g_allocations(0);
+}
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float TICK_DT = 1.0f / SimulationClock::DEFAULT_TICK_RATE;
+
+    bool SameBits(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+
+    // Every pose, current and previous, plus the rocket and run state (hash)
+    bool SameWorld(const Simulation& a, const Simulation& b)
+    {
+        if (a.GetStateHash() != b.GetStateHash() || a.obstacles.Size() != b.obstacles.Size()) return false;
+
+        std::vector<float> pa(a.obstacles.GetPoseFloats()), pb(b.obstacles.GetPoseFloats());
+        a.obstacles.CopyPosesTo(pa.data());
+        b.obstacles.CopyPosesTo(pb.data());
+        for (size_t i = 0; i < pa.size(); ++i) {
+            if (!SameBits(pa[i], pb[i])) return false;
+        }
+        return SameBits(a.rocket.prevPosition.x, b.rocket.prevPosition.x) &&
+            SameBits(a.rocket.prevPosition.y, b.rocket.prevPosition.y) &&
+            SameBits(a.rocket.prevRotation, b.rocket.prevRotation);
+    }
+
+    // Burn and turn for a few seconds so there is something to undo
+    void Fly(Simulation& sim, int ticks)
+    {
+        ControlInput input;
+        input.throttle = 1.0f;
+        input.rotate = 0.5f;
+        for (int t = 0; t < ticks && sim.GetOutcome() == SimOutcome::RUNNING; ++t) sim.Step(input, TICK_DT);
+    }
+
+    // -------------------- EQUIVALENCE --------------------
+    bool Verify()
+    {
+        bool ok = true;
+        Simulation sim, fresh;
+        LevelManager levels(7), reference;
+        levels.Init(sim);
+        reference.Init(fresh);
+
+        for (int d = 0; d < levels.GetDifficultyCount(); ++d) {
+            for (int l = 0; l < levels.GetLevelCount(); ++l) {
+                levels.SetPreset(d, l, sim);
+                sim.ResetRun();
+                uint64_t seed = levels.GetLayoutSeed();
+                reference.LoadLayout(d, l, seed, fresh);
+
+                // Warm-up restart: the first one may size the collision scratch
+                Fly(sim, 300);
+                levels.RestartCurrentLevel(sim);
+
+                bool same = true;
+                long long allocations = 0;
+                for (int i = 0; i < 4; ++i) {
+                    Fly(sim, 120 * (i + 1));
+                    long long before = g_allocations.load();
+                    levels.RestartCurrentLevel(sim);
+                    allocations += g_allocations.load() - before;
+                    same = same && SameWorld(sim, fresh) && levels.GetLayoutSeed() == seed;
+                }
+
+                if (!same || allocations != 0) {
+                    std::printf("MISMATCH: %s / %s (%s, %lld allocations)\n",
+                        levels.GetLevelName(), levels.GetDifficultyName(),
+                        same ? "same world" : "different world", allocations);
+                    ok = false;
+                }
+            }
+        }
+
+        // Leaving the level for another world forces a rebuild of the same layout
+        levels.SetPreset(1, 2, sim);
+        sim.ResetRun();
+        reference.LoadLayout(1, 2, levels.GetLayoutSeed(), fresh);
+        sim.obstacles.Assign({});
+        sim.OnObstaclesChanged();
+        sim.terrain.Clear();
+        levels.RestartCurrentLevel(sim);
+        if (!SameWorld(sim, fresh)) {
+            std::printf("MISMATCH: restart after the level was replaced\n");
+            ok = false;
+        }
+
+        std::printf("equivalence: %s (restart == fresh build of the same seed, no allocation)\n",
+            ok ? "bit-exact" : "FAILED");
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    std::vector<MovingObstacle> MakeObstacles(int n, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-4000.0f, 4000.0f);
+        std::uniform_real_distribution<float> size(8.0f, 80.0f);
+        std::uniform_int_distribution<int> pattern(0, 2);
+        std::uniform_real_distribution<float> amp(20.0f, 80.0f);
+        std::uniform_real_distribution<float> freq(0.5f, 1.5f);
+        std::uniform_real_distribution<float> phase(0.0f, 6.28f);
+        std::uniform_real_distribution<float> spin(-90.0f, 90.0f);
+
+        std::vector<MovingObstacle> obstacles;
+        obstacles.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            ObstaclePattern p = (ObstaclePattern)pattern(rng);
+            obstacles.emplace_back(Rectangle{ pos(rng), pos(rng), size(rng), size(rng) },
+                p, amp(rng), freq(rng), phase(rng), spin(rng));
+        }
+        return obstacles;
+    }
+
+    template <typename F>
+    double TimeUs(int iterations, F&& f)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) f();
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+    }
+
+    void Benchmark()
+    {
+        std::printf("\n%-22s %10s %12s %12s %9s\n", "preset", "obstacles", "rebuild us", "restart us", "speedup");
+
+        // -------------------- PRESETS --------------------
+        Simulation sim;
+        LevelManager levels;
+        levels.Init(sim);
+        for (int d = 0; d < levels.GetDifficultyCount(); ++d) {
+            levels.SetPreset(d, levels.GetLevelCount() - 1, sim);
+            sim.ResetRun();
+            uint64_t seed = levels.GetLayoutSeed();
+            int level = levels.GetLevelIndex();
+
+            double rebuild = TimeUs(2000, [&]() { levels.LoadLayout(d, level, seed, sim); });
+            double restart = TimeUs(20000, [&]() { levels.RestartCurrentLevel(sim); });
+
+            char name[48];
+            std::snprintf(name, sizeof(name), "%s/%s", levels.GetLevelName(), levels.GetDifficultyName());
+            std::printf("%-22s %10d %12.3f %12.3f %8.0fx\n", name, sim.obstacles.Size(), rebuild, restart, rebuild / restart);
+        }
+
+        // -------------------- LARGE FIELDS --------------------
+        // Rebuild = what a level build does to the obstacles (Assign + broadphase)
+        const int sizes[] = { 1000, 10000, 100000 };
+        for (int n : sizes) {
+            std::vector<MovingObstacle> obstacles = MakeObstacles(n, 5u + n);
+            Simulation big;
+            big.obstacles.Assign(obstacles);
+            big.OnObstaclesChanged();
+            big.rocket.Reset({ 0.0f, 0.0f });
+            LevelSnapshot snapshot;
+            snapshot.Capture(big);
+
+            int iterations = n >= 100000 ? 10 : 100;
+            double rebuild = TimeUs(iterations, [&]() {
+                big.obstacles.Assign(obstacles);
+                big.OnObstaclesChanged();
+                big.rocket.Reset({ 0.0f, 0.0f });
+                big.ResetRun();
+            });
+            long long before = g_allocations.load();
+            double restart = TimeUs(iterations * 10, [&]() { snapshot.Restore(big); });
+            long long allocations = g_allocations.load() - before;
+
+            char name[48];
+            std::snprintf(name, sizeof(name), "synthetic%s", allocations ? " (ALLOCATED)" : "");
+            std::printf("%-22s %10d %12.3f %12.3f %8.0fx\n", name, n, rebuild, restart, rebuild / restart);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    if (!Verify()) return 1;
+    if (!verifyOnly) Benchmark();
+    return 0;
+}
@@ -0,0 +1,319 @@
+// stellar_eval: parallel Monte-Carlo difficulty evaluator.
+//
+// Flies tens of thousands of headless landings for every difficulty/level
+// preset pair with randomized and heuristic pilots, spread over all cores,
+// and reports success rate, fuel-used distribution and crash causes.
+//
+//   stellar_eval [--runs N] [--threads N] [--seed S] [--policy random|heuristic|both]
+//                [--format csv|json] [--max-seconds S] [--tick-rate HZ]
+//
+// Every run is seeded from (seed, pair, policy, run index) only, so results
+// are identical for any thread count.
+
+#include "LevelManager.h"
+#include "Pilots.h"
+#include "Random.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    enum class Policy { RANDOM, HEURISTIC };
+
+    const char* PolicyName(Policy p) { return p == Policy::RANDOM ? "random" : "heuristic"; }
+
+    struct Options {
+        int runs = 10000;          // per preset pair and policy
+        int threads = 0;           // 0 = all hardware threads
+        unsigned long long seed = 1;
+        std::string policy = "both";
+        std::string format = "csv";
+        float maxSeconds = 60.0f;  // game time before a run counts as a timeout
+        int tickRate = SimulationClock::DEFAULT_TICK_RATE;
+    };
+
+    struct Job {
+        int difficulty;
+        int level;
+        Policy policy;
+    };
+
+    // -------------------- PER-JOB STATISTICS --------------------
+    constexpr int FUEL_BINS = 100;   // 1% of max fuel per bin
+    constexpr int CAUSE_COUNT = 5;   // CrashCause values
+
+    struct Stats {
+        long long runs = 0;
+        long long landed = 0;
+        long long timeouts = 0;
+        long long crashes[CAUSE_COUNT] = {};
+        long long fuelHist[FUEL_BINS] = {};
+        double fuelUsedSum = 0.0;    // fraction of max fuel
+        double landedTimeSum = 0.0;  // seconds
+        double scoreSum = 0.0;
+
+        void Merge(const Stats& o)
+        {
+            runs += o.runs;
+            landed += o.landed;
+            timeouts += o.timeouts;
+            for (int i = 0; i < CAUSE_COUNT; ++i) crashes[i] += o.crashes[i];
+            for (int i = 0; i < FUEL_BINS; ++i) fuelHist[i] += o.fuelHist[i];
+            fuelUsedSum += o.fuelUsedSum;
+            landedTimeSum += o.landedTimeSum;
+            scoreSum += o.scoreSum;
+        }
+
+        // Percentile of fuel used (fraction of max fuel) from the histogram
+        double FuelPercentile(double p) const
+        {
+            if (runs == 0) return 0.0;
+            long long target = (long long)(p * (runs - 1));
+            long long seen = 0;
+            for (int i = 0; i < FUEL_BINS; ++i) {
+                seen += fuelHist[i];
+                if (seen > target) return (i + 0.5) / FUEL_BINS;
+            }
+            return 1.0;
+        }
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: stellar_eval [--runs N] [--threads N] [--seed S] [--policy random|heuristic|both]\n"
+            "                    [--format csv|json] [--max-seconds S] [--tick-rate HZ]\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h") { PrintUsage(); std::exit(0); }
+            else if (arg == "--runs" && hasValue) opt.runs = std::atoi(argv[++i]);
+            else if (arg == "--threads" && hasValue) opt.threads = std::atoi(argv[++i]);
+            else if (arg == "--seed" && hasValue) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--policy" && hasValue) opt.policy = argv[++i];
+            else if (arg == "--format" && hasValue) opt.format = argv[++i];
+            else if (arg == "--max-seconds" && hasValue) opt.maxSeconds = (float)std::atof(argv[++i]);
+            else if (arg == "--tick-rate" && hasValue) opt.tickRate = std::atoi(argv[++i]);
+            else {
+                std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        if (opt.runs < 1 || opt.threads < 0 || opt.tickRate < 1 || opt.maxSeconds <= 0.0f ||
+            (opt.policy != "random" && opt.policy != "heuristic" && opt.policy != "both") ||
+            (opt.format != "csv" && opt.format != "json")) {
+            std::fprintf(stderr, "invalid option value\n");
+            return false;
+        }
+        return true;
+    }
+
+    // -------------------- WORKER --------------------
+    // Runs are handed out in chunks from one atomic counter; everything else
+    // (simulation, level generator, pilots, statistics) is thread-private.
+    constexpr int CHUNK_RUNS = 128;
+
+    void Worker(const Options& opt, const std::vector<Job>& jobs,
+        std::atomic<long long>& nextChunk, std::vector<Stats>& out)
+    {
+        SimulationClock clock(opt.tickRate);
+        const float tickDt = clock.GetTickDt();
+        const long long maxTicks = (long long)(opt.maxSeconds * opt.tickRate);
+
+        Simulation sim;
+        LevelManager levels;
+        levels.Init(sim);
+
+        RandomPilot randomPilot(0, opt.tickRate);
+        HeuristicPilot heuristicPilot(sim, 0);
+
+        const long long chunksPerJob = (opt.runs + CHUNK_RUNS - 1) / CHUNK_RUNS;
+        const long long totalChunks = chunksPerJob * (long long)jobs.size();
+
+        for (;;) {
+            long long chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= totalChunks) break;
+
+            int jobIndex = (int)(chunk / chunksPerJob);
+            const Job& job = jobs[jobIndex];
+            Stats& stats = out[jobIndex];
+
+            int firstRun = (int)(chunk % chunksPerJob) * CHUNK_RUNS;
+            int lastRun = std::min(firstRun + CHUNK_RUNS, opt.runs);
+
+            for (int run = firstRun; run < lastRun; ++run) {
+                uint64_t runSeed = MixSeed(MixSeed(opt.seed, (uint64_t)jobIndex), (uint64_t)run);
+
+                levels.SetSeed(runSeed);
+                levels.SetPreset(job.difficulty, job.level, sim);
+                sim.ResetRun();
+
+                InputSource* pilot;
+                if (job.policy == Policy::RANDOM) {
+                    randomPilot.Reseed(runSeed ^ 0xa5a5a5a5ULL);
+                    pilot = &randomPilot;
+                }
+                else {
+                    heuristicPilot.Reseed(runSeed ^ 0xa5a5a5a5ULL);
+                    pilot = &heuristicPilot;
+                }
+
+                while (sim.GetOutcome() == SimOutcome::RUNNING && sim.GetTickCount() < maxTicks) {
+                    sim.Step(pilot->Poll(), tickDt);
+                }
+
+                // -------------------- RECORD --------------------
+                stats.runs++;
+
+                float maxFuel = sim.rocket.maxFuel;
+                float used = maxFuel > 0.0f ? (maxFuel - sim.rocket.fuel) / maxFuel : 0.0f;
+                int bin = std::min(FUEL_BINS - 1, std::max(0, (int)(used * FUEL_BINS)));
+                stats.fuelHist[bin]++;
+                stats.fuelUsedSum += used;
+
+                switch (sim.GetOutcome()) {
+                case SimOutcome::LANDED:
+                    stats.landed++;
+                    stats.landedTimeSum += sim.timer;
+                    stats.scoreSum += sim.score;
+                    break;
+                case SimOutcome::CRASHED:
+                    stats.crashes[(int)sim.GetCrashCause()]++;
+                    break;
+                case SimOutcome::RUNNING:
+                    stats.timeouts++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // -------------------- OUTPUT --------------------
+    const char* const kCauseNames[CAUSE_COUNT] = {
+        "none", "obstacle", "off_pad", "hard_landing", "tilted"
+    };
+
+    // namer/scratch only turn preset indices back into display names
+    void PrintCsv(const std::vector<Job>& jobs, const std::vector<Stats>& stats,
+        Simulation& scratch, LevelManager& namer)
+    {
+        std::printf("difficulty,level,policy,runs,landed,success_rate,"
+            "fuel_used_mean,fuel_used_p10,fuel_used_p50,fuel_used_p90,"
+            "crash_obstacle,crash_off_pad,crash_hard_landing,crash_tilted,timeout,"
+            "mean_landing_time,mean_score\n");
+
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            const Stats& s = stats[i];
+            namer.SetPreset(jobs[i].difficulty, jobs[i].level, scratch);
+
+            std::printf("%s,%s,%s,%lld,%lld,%.4f,%.4f,%.3f,%.3f,%.3f,%lld,%lld,%lld,%lld,%lld,%.3f,%.1f\n",
+                namer.GetDifficultyName(), namer.GetLevelName(), PolicyName(jobs[i].policy),
+                s.runs, s.landed, s.runs ? (double)s.landed / s.runs : 0.0,
+                s.runs ? s.fuelUsedSum / s.runs : 0.0,
+                s.FuelPercentile(0.10), s.FuelPercentile(0.50), s.FuelPercentile(0.90),
+                s.crashes[1], s.crashes[2], s.crashes[3], s.crashes[4], s.timeouts,
+                s.landed ? s.landedTimeSum / s.landed : 0.0,
+                s.landed ? s.scoreSum / s.landed : 0.0);
+        }
+    }
+
+    void PrintJson(const std::vector<Job>& jobs, const std::vector<Stats>& stats,
+        Simulation& scratch, LevelManager& namer)
+    {
+        std::printf("[\n");
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            const Stats& s = stats[i];
+            namer.SetPreset(jobs[i].difficulty, jobs[i].level, scratch);
+
+            std::printf("  {\"difficulty\": \"%s\", \"level\": \"%s\", \"policy\": \"%s\", "
+                "\"runs\": %lld, \"landed\": %lld, \"success_rate\": %.4f,\n",
+                namer.GetDifficultyName(), namer.GetLevelName(), PolicyName(jobs[i].policy),
+                s.runs, s.landed, s.runs ? (double)s.landed / s.runs : 0.0);
+            std::printf("   \"fuel_used\": {\"mean\": %.4f, \"p10\": %.3f, \"p50\": %.3f, \"p90\": %.3f},\n",
+                s.runs ? s.fuelUsedSum / s.runs : 0.0,
+                s.FuelPercentile(0.10), s.FuelPercentile(0.50), s.FuelPercentile(0.90));
+            std::printf("   \"crashes\": {");
+            for (int c = 1; c < CAUSE_COUNT; ++c) {
+                std::printf("\"%s\": %lld, ", kCauseNames[c], s.crashes[c]);
+            }
+            std::printf("\"timeout\": %lld},\n", s.timeouts);
+            std::printf("   \"mean_landing_time\": %.3f, \"mean_score\": %.1f}%s\n",
+                s.landed ? s.landedTimeSum / s.landed : 0.0,
+                s.landed ? s.scoreSum / s.landed : 0.0,
+                i + 1 < jobs.size() ? "," : "");
+        }
+        std::printf("]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage();
+        return 2;
+    }
+
+    int threadCount = opt.threads > 0 ? opt.threads : (int)std::thread::hardware_concurrency();
+    if (threadCount < 1) threadCount = 1;
+
+    // -------------------- JOB LIST --------------------
+    std::vector<Job> jobs;
+    LevelManager presets;
+    presets.UseBuiltinPack();
+    for (int d = 0; d < presets.GetDifficultyCount(); ++d) {
+        for (int l = 0; l < presets.GetLevelCount(); ++l) {
+            if (opt.policy != "heuristic") jobs.push_back({ d, l, Policy::RANDOM });
+            if (opt.policy != "random")    jobs.push_back({ d, l, Policy::HEURISTIC });
+        }
+    }
+
+    // -------------------- RUN --------------------
+    std::vector<std::vector<Stats>> perThread(threadCount, std::vector<Stats>(jobs.size()));
+    std::atomic<long long> nextChunk(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back(Worker, std::cref(opt), std::cref(jobs),
+            std::ref(nextChunk), std::ref(perThread[t]));
+    }
+    for (auto& w : workers) w.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::vector<Stats> totals(jobs.size());
+    for (const auto& threadStats : perThread) {
+        for (size_t i = 0; i < jobs.size(); ++i) totals[i].Merge(threadStats[i]);
+    }
+
+    // -------------------- REPORT --------------------
+    Simulation scratch;
+    LevelManager namer;
+    namer.Init(scratch);
+
+    if (opt.format == "json") PrintJson(jobs, totals, scratch, namer);
+    else PrintCsv(jobs, totals, scratch, namer);
+
+    long long totalRuns = (long long)jobs.size() * opt.runs;
+    std::fprintf(stderr, "%lld runs on %d threads in %.2f s (%.0f runs/sec)\n",
+        totalRuns, threadCount, seconds, seconds > 0.0 ? totalRuns / seconds : 0.0);
+    return 0;
+}
@@ -0,0 +1,659 @@
+// stellar_sim: headless simulation runner.
+//
+// Loads a level/difficulty preset and steps the simulation uncapped with
+// no window, rendering or audio, then reports outcomes and steps/second.
+//
+//   stellar_sim [--level N] [--difficulty N] [--seed S] [--runs N]
+//               [--max-ticks N] [--tick-rate HZ] [--pilot idle|script]
+//               [--endless] [--record FILE] [--play FILE]
+//               [--hashes FILE] [--determinism THREADS]
+//               [--rewind] [--rewind-budget KB] [--pack FILE]
+//
+// --endless flies one long Endless Descent instead (default 5 minutes of
+// game time) and reports chunk streaming: main-thread cost per step, chunks
+// the worker did not have ready in time, and pool memory. A crash respawns
+// the rocket further down so a single run streams a long way. The loop
+// yields once per step to stand in for the game's idle time between frames.
+//
+// --record FILE saves the first run as a replay. --play FILE plays a replay
+// back, checks the claimed result, and checks that seeking to ticks across
+// the run lands on exactly the state straight playback reached, by the
+// state hashes stored in the replay as well as against playback itself.
+//
+// --hashes FILE writes the world state hash after every tick of the first
+// run (or of the endless descent), one hex value per line. Two builds that
+// agree produce identical files, so compare them with cmp/diff.
+//
+// --determinism THREADS flies every level and difficulty plus an endless
+// descent once on the main thread, then again on THREADS threads at once,
+// and fails unless every per-tick hash stream matches the first.
+//
+// --rewind snapshots every tick into a RewindBuffer (restarting the level
+// whenever a run ends, default 60 s), reports its memory and per-tick
+// cost, then steps all the way back checking every restored state.
+// --rewind-budget sets its memory budget (default RewindBuffer's).
+//
+// --pack FILE takes the presets from a compiled level pack instead of the
+// built-in ones (every mode; replays must be played on the pack they were
+// recorded on).
+
+#include "EndlessWorld.h"
+#include "InputSource.h"
+#include "LevelManager.h"
+#include "Replay.h"
+#include "RewindBuffer.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Options {
+        int level = 0;
+        int difficulty = 1;
+        unsigned long long seed = 1;
+        int runs = 1000;
+        int maxTicks = 0;        // 0 = 60 seconds of game time
+        int tickRate = SimulationClock::DEFAULT_TICK_RATE;
+        std::string pilot = "script";
+        bool endless = false;
+        std::string recordPath;
+        std::string playPath;
+        std::string hashPath;
+        int determinismThreads = 0;
+        bool rewind = false;
+        int rewindBudgetKb = 0;   // 0 = RewindBuffer default
+        std::string packPath;     // empty = built-in presets
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: stellar_sim [--level N] [--difficulty N] [--seed S] [--runs N]\n"
+            "                   [--max-ticks N] [--tick-rate HZ] [--pilot idle|script]\n"
+            "                   [--endless] [--record FILE] [--play FILE]\n"
+            "                   [--hashes FILE] [--determinism THREADS]\n"
+            "                   [--rewind] [--rewind-budget KB] [--pack FILE]\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h") { PrintUsage(); std::exit(0); }
+            else if (arg == "--level" && hasValue) opt.level = std::atoi(argv[++i]);
+            else if (arg == "--difficulty" && hasValue) opt.difficulty = std::atoi(argv[++i]);
+            else if (arg == "--seed" && hasValue) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--runs" && hasValue) opt.runs = std::atoi(argv[++i]);
+            else if (arg == "--max-ticks" && hasValue) opt.maxTicks = std::atoi(argv[++i]);
+            else if (arg == "--tick-rate" && hasValue) opt.tickRate = std::atoi(argv[++i]);
+            else if (arg == "--pilot" && hasValue) opt.pilot = argv[++i];
+            else if (arg == "--endless") opt.endless = true;
+            else if (arg == "--record" && hasValue) opt.recordPath = argv[++i];
+            else if (arg == "--play" && hasValue) opt.playPath = argv[++i];
+            else if (arg == "--hashes" && hasValue) opt.hashPath = argv[++i];
+            else if (arg == "--determinism" && hasValue) opt.determinismThreads = std::atoi(argv[++i]);
+            else if (arg == "--rewind") opt.rewind = true;
+            else if (arg == "--rewind-budget" && hasValue) opt.rewindBudgetKb = std::atoi(argv[++i]);
+            else if (arg == "--pack" && hasValue) opt.packPath = argv[++i];
+            else {
+                std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        // Upper bounds depend on the pack, see main()
+        if (opt.level < 0 || opt.difficulty < 0 || opt.runs < 1 || opt.tickRate < 1 ||
+            (opt.pilot != "idle" && opt.pilot != "script") ||
+            (opt.endless && !opt.recordPath.empty()) || opt.determinismThreads < 0 ||
+            opt.rewindBudgetKb < 0) {
+            std::fprintf(stderr, "invalid option value\n");
+            return false;
+        }
+        return true;
+    }
+
+    /// Presets from --pack if given, else the built-in ones; then Init().
+    bool InitLevels(LevelManager& levels, Simulation& sim, const Options& opt)
+    {
+        std::string error;
+        if (!opt.packPath.empty() && !levels.LoadPack(opt.packPath.c_str(), &error)) {
+            std::fprintf(stderr, "cannot load level pack: %s\n", error.c_str());
+            return false;
+        }
+        levels.Init(sim);
+        return true;
+    }
+
+    // Fixed burn/coast pattern: enough to exercise thrust, rotation and fuel
+    void BuildScript(ScriptedInput& script, int tickRate)
+    {
+        ControlInput burn;   burn.throttle = 1.0f;
+        ControlInput coast;
+        ControlInput left;   left.rotate = -1.0f;
+        ControlInput right;  right.rotate = 1.0f;
+
+        script.AddStep(tickRate / 2, coast);
+        script.AddStep(tickRate / 4, left);
+        script.AddStep(tickRate / 2, burn);
+        script.AddStep(tickRate / 4, right);
+        for (int i = 0; i < 20; ++i) {
+            script.AddStep(tickRate / 3, burn);
+            script.AddStep(tickRate / 2, coast);
+        }
+    }
+
+    bool SameState(const SimState& a, const SimState& b)
+    {
+        return std::memcmp(&a.position, &b.position, sizeof(Vector2)) == 0 &&
+            std::memcmp(&a.velocity, &b.velocity, sizeof(Vector2)) == 0 &&
+            std::memcmp(&a.rotation, &b.rotation, sizeof(float)) == 0 &&
+            std::memcmp(&a.fuel, &b.fuel, sizeof(float)) == 0 &&
+            std::memcmp(&a.obstacleTime, &b.obstacleTime, sizeof(double)) == 0 &&
+            std::memcmp(&a.timer, &b.timer, sizeof(float)) == 0 &&
+            a.isThrusting == b.isThrusting && a.startGame == b.startGame &&
+            a.tickCount == b.tickCount;
+    }
+
+    // -------------------- HASH STREAMS --------------------
+    struct HashJob {
+        bool endless = false;
+        int difficulty = 0;
+        int level = 0;
+    };
+
+    /// World state hash after every tick of one scripted run of @p job.
+    void HashRun(const HashJob& job, const Options& opt, std::vector<uint64_t>& hashes)
+    {
+        SimulationClock clock(opt.tickRate);
+        const float tickDt = clock.GetTickDt();
+        const int maxTicks = opt.maxTicks > 0 ? opt.maxTicks : opt.tickRate * 60;
+        const bool idle = opt.pilot == "idle";
+
+        ScriptedInput script;
+        BuildScript(script, opt.tickRate);
+
+        Simulation sim;
+        LevelManager levels(opt.seed);
+        EndlessWorld world;
+        if (job.endless) {
+            world.Begin(sim, opt.seed);
+            sim.ResetRun();
+        }
+        else {
+            InitLevels(levels, sim, opt);
+            levels.SetDifficulty(job.difficulty, sim);
+            levels.SetLevel(job.level, sim);
+            levels.RestartCurrentLevel(sim);
+        }
+
+        hashes.clear();
+        hashes.reserve((size_t)maxTicks);
+        while (sim.GetOutcome() == SimOutcome::RUNNING && sim.GetTickCount() < maxTicks) {
+            sim.Step(idle ? ControlInput{} : script.Poll(), tickDt);
+            if (job.endless) world.Update(sim);
+            hashes.push_back(sim.GetStateHash());
+        }
+    }
+
+    int WriteHashes(const Options& opt)
+    {
+        HashJob job;
+        job.endless = opt.endless;
+        job.difficulty = opt.difficulty;
+        job.level = opt.level;
+
+        std::vector<uint64_t> hashes;
+        HashRun(job, opt, hashes);
+
+        FILE* file = std::fopen(opt.hashPath.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "cannot write hashes: %s\n", opt.hashPath.c_str());
+            return 1;
+        }
+        for (uint64_t h : hashes) std::fprintf(file, "%016llx\n", (unsigned long long)h);
+        std::fclose(file);
+
+        std::printf("hashes:      %zu ticks written to %s\n", hashes.size(), opt.hashPath.c_str());
+        std::printf("final:       %016llx\n", hashes.empty() ? 0ULL : (unsigned long long)hashes.back());
+        return 0;
+    }
+
+    int CheckDeterminism(const Options& opt)
+    {
+        Simulation presetSim;
+        LevelManager presets;
+        InitLevels(presets, presetSim, opt);
+
+        std::vector<HashJob> jobs;
+        for (int d = 0; d < presets.GetDifficultyCount(); ++d) {
+            for (int l = 0; l < presets.GetLevelCount(); ++l) {
+                HashJob job;
+                job.difficulty = d;
+                job.level = l;
+                jobs.push_back(job);
+            }
+        }
+        HashJob endlessJob;
+        endlessJob.endless = true;
+        jobs.push_back(endlessJob);
+
+        // -------------------- REFERENCE --------------------
+        std::vector<std::vector<uint64_t>> reference(jobs.size());
+        long long ticks = 0;
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            HashRun(jobs[j], opt, reference[j]);
+            ticks += (long long)reference[j].size();
+        }
+
+        // -------------------- CONCURRENT --------------------
+        // Every thread flies every job, each starting at a different one, so
+        // the same world is in flight on several threads at once
+        const int threadCount = opt.determinismThreads;
+        std::vector<int> mismatches((size_t)threadCount, 0);
+        std::vector<int> firstBadTick((size_t)threadCount, -1);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                std::vector<uint64_t> hashes;
+                for (size_t n = 0; n < jobs.size(); ++n) {
+                    size_t j = (n + (size_t)t) % jobs.size();
+                    HashRun(jobs[j], opt, hashes);
+
+                    const std::vector<uint64_t>& ref = reference[j];
+                    size_t common = hashes.size() < ref.size() ? hashes.size() : ref.size();
+                    size_t i = 0;
+                    while (i < common && hashes[i] == ref[i]) ++i;
+                    if (i < common || hashes.size() != ref.size()) {
+                        if (mismatches[t] == 0) firstBadTick[t] = (int)i;
+                        mismatches[t]++;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        int failedRuns = 0;
+        for (int t = 0; t < threadCount; ++t) {
+            failedRuns += mismatches[t];
+            if (mismatches[t] > 0) {
+                std::printf("thread %d:    %d runs diverged, first at tick %d\n", t, mismatches[t], firstBadTick[t]);
+            }
+        }
+
+        std::printf("runs:        %zu (every level and difficulty, plus endless descent)\n", jobs.size());
+        std::printf("ticks:       %lld hashed per pass\n", ticks);
+        std::printf("threads:     1 reference pass, then %d concurrent passes\n", threadCount);
+        std::printf("%s\n", failedRuns == 0 ? "OK" : "FAILED");
+        return failedRuns == 0 ? 0 : 1;
+    }
+
+    int CheckRewind(const Options& opt)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        SimulationClock clock(opt.tickRate);
+        const float tickDt = clock.GetTickDt();
+        const int maxTicks = opt.maxTicks > 0 ? opt.maxTicks : opt.tickRate * 60;
+        const bool idle = opt.pilot == "idle";
+
+        Simulation sim;
+        LevelManager levels(opt.seed);
+        InitLevels(levels, sim, opt);
+        levels.SetDifficulty(opt.difficulty, sim);
+        levels.SetLevel(opt.level, sim);
+        levels.RestartCurrentLevel(sim);
+
+        ScriptedInput script;
+        BuildScript(script, opt.tickRate);
+
+        RewindBuffer::Settings settings;
+        settings.tickRate = opt.tickRate;
+        if (opt.rewindBudgetKb > 0) settings.budgetBytes = (size_t)opt.rewindBudgetKb * 1024;
+        RewindBuffer rewind(settings);
+
+        // -------------------- RECORD --------------------
+        std::vector<SimState> states((size_t)maxTicks);
+        double pushSeconds = 0.0;
+        double worstPush = 0.0;
+        for (int tick = 0; tick < maxTicks; ++tick) {
+            if (sim.GetOutcome() != SimOutcome::RUNNING) {
+                levels.RestartCurrentLevel(sim);
+                script.Restart();
+            }
+            sim.CaptureState(states[tick]);
+
+            auto t0 = Clock::now();
+            rewind.Push(sim);
+            double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+            pushSeconds += seconds;
+            worstPush = seconds > worstPush ? seconds : worstPush;
+
+            sim.Step(idle ? ControlInput{} : script.Poll(), tickDt);
+        }
+
+        const int frames = rewind.GetFrameCount();
+        const float depth = rewind.GetSeconds();
+        const size_t used = rewind.GetUsedBytes();
+
+        // -------------------- REWIND --------------------
+        int mismatches = 0;
+        auto start = Clock::now();
+        for (int tick = maxTicks - 1; tick >= maxTicks - frames; --tick) {
+            rewind.StepBack(sim);
+            SimState state;
+            sim.CaptureState(state);
+            if (!SameState(state, states[tick])) mismatches++;
+        }
+        double rewindSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::printf("level:       %s / %s\n", levels.GetLevelName(), levels.GetDifficultyName());
+        std::printf("ticks:       %d pushed at %d Hz, keyframe every %d\n",
+            maxTicks, opt.tickRate, settings.keyframeInterval);
+        std::printf("history:     %d frames (%.1f s)\n", frames, depth);
+        std::printf("memory:      %zu bytes used (%.1f per frame), %zu reserved of %zu budget\n",
+            used, frames > 0 ? (double)used / frames : 0.0, rewind.GetReservedBytes(), settings.budgetBytes);
+        std::printf("push:        %.0f ns mean, %.0f ns worst\n",
+            pushSeconds / maxTicks * 1e9, worstPush * 1e9);
+        std::printf("step back:   %.0f ns mean, %d mismatched\n",
+            frames > 0 ? rewindSeconds / frames * 1e9 : 0.0, mismatches);
+        std::printf("%s\n", mismatches == 0 && rewind.GetFrameCount() == 0 ? "OK" : "FAILED");
+        return mismatches == 0 && rewind.GetFrameCount() == 0 ? 0 : 1;
+    }
+
+    int PlayReplay(const Options& opt)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        Replay replay;
+        if (!replay.Load(opt.playPath.c_str())) {
+            std::fprintf(stderr, "cannot read replay: %s\n", opt.playPath.c_str());
+            return 2;
+        }
+
+        Simulation sim;
+        LevelManager levels;
+        InitLevels(levels, sim, opt);
+        EndlessWorld endless;
+        ReplayPlayer player(replay);
+        if (!player.LoadWorld(sim, levels, &endless)) {
+            std::fprintf(stderr, "replay was recorded on another level pack (try --pack)\n");
+            return 2;
+        }
+
+        const bool isEndless = replay.header.mode == ReplayMode::ENDLESS;
+        const float dt = 1.0f / (float)replay.header.tickRate;
+
+        // -------------------- STRAIGHT PLAYBACK --------------------
+        // State before every tick, for the seek check below
+        std::vector<SimState> states((size_t)replay.tickCount + 1);
+        int firstBadKeyframe = -1;
+        auto start = Clock::now();
+        for (int tick = 0; tick < replay.tickCount; ++tick) {
+            if (tick % replay.keyframeInterval == 0 && firstBadKeyframe < 0) {
+                size_t k = (size_t)(tick / replay.keyframeInterval);
+                if (k < replay.keyframes.size() && sim.GetStateHash() != replay.keyframes[k].hash) firstBadKeyframe = tick;
+            }
+            sim.CaptureState(states[tick]);
+            sim.Step(player.Poll(), dt);
+            if (isEndless) endless.Update(sim);
+        }
+        double playSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        const SimOutcome outcome = sim.GetOutcome();
+        const float score = sim.score;
+        const uint64_t finalHash = sim.GetStateHash();
+        bool hashOk = firstBadKeyframe < 0 && finalHash == replay.finalHash;
+        bool resultOk = outcome == replay.outcome && std::memcmp(&score, &replay.score, sizeof(float)) == 0 && hashOk;
+
+        // -------------------- SEEKING --------------------
+        // Spread over the run, including keyframe ticks and the ticks just before them
+        int seeks = 0;
+        int seekFailures = 0;
+        double worstSeek = 0.0;
+        for (int i = 0; i < 64 && replay.tickCount > 1; ++i) {
+            int target = (int)((long long)(replay.tickCount - 1) * i / 63);
+            if (i % 3 == 1) target = (target / replay.keyframeInterval) * replay.keyframeInterval;
+            if (i % 3 == 2 && target > 0) target = (target / replay.keyframeInterval) * replay.keyframeInterval - 1;
+            if (target < 0) target = 0;
+
+            if (isEndless) player.LoadWorld(sim, levels, &endless);
+            auto t0 = Clock::now();
+            player.Seek(target, sim, &endless);
+            double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+            worstSeek = seconds > worstSeek ? seconds : worstSeek;
+
+            SimState state;
+            sim.CaptureState(state);
+            seeks++;
+            if (!SameState(state, states[target])) seekFailures++;
+        }
+
+        std::vector<uint8_t> bytes;
+        replay.Serialize(bytes);
+        double minutes = replay.tickCount / (double)replay.header.tickRate / 60.0;
+
+        std::printf("replay:      %s\n", opt.playPath.c_str());
+        if (isEndless) std::printf("world:       endless descent, seed %llu\n", (unsigned long long)replay.header.seed);
+        else std::printf("world:       %s / %s, layout seed %llu\n",
+            levels.GetLevelName(), levels.GetDifficultyName(), (unsigned long long)replay.header.seed);
+        std::printf("ticks:       %d at %d Hz, keyframe every %d\n",
+            replay.tickCount, replay.header.tickRate, replay.keyframeInterval);
+        std::printf("size:        %zu bytes (%zu input, %zu keyframes), %.0f bytes per minute\n",
+            bytes.size(), replay.inputs.size(), replay.keyframes.size(),
+            minutes > 0.0 ? bytes.size() / minutes : 0.0);
+        std::printf("result:      %s, score %.1f (claimed %s, %.1f)\n",
+            outcome == SimOutcome::LANDED ? "landed" : outcome == SimOutcome::CRASHED ? "crashed" : "running",
+            score,
+            replay.outcome == SimOutcome::LANDED ? "landed" : replay.outcome == SimOutcome::CRASHED ? "crashed" : "running",
+            replay.score);
+        if (firstBadKeyframe >= 0) std::printf("hash:        diverged from the recording by tick %d\n", firstBadKeyframe);
+        else std::printf("hash:        %016llx (%s)\n", (unsigned long long)finalHash,
+            finalHash == replay.finalHash ? "matches recording" : "differs from recording");
+        std::printf("playback:    %.2f ms\n", playSeconds * 1e3);
+        std::printf("seeks:       %d, %d mismatched, worst %.2f ms\n", seeks, seekFailures, worstSeek * 1e3);
+        std::printf("%s\n", resultOk && seekFailures == 0 ? "OK" : "FAILED");
+        return resultOk && seekFailures == 0 ? 0 : 1;
+    }
+
+    int RunEndless(const Options& opt, ScriptedInput& script)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        SimulationClock clock(opt.tickRate);
+        const float tickDt = clock.GetTickDt();
+        const long long maxTicks = opt.maxTicks > 0 ? opt.maxTicks : (long long)opt.tickRate * 300;
+        const bool idle = opt.pilot == "idle";
+
+        Simulation sim;
+        EndlessWorld world;
+        world.Begin(sim, opt.seed);
+        sim.ResetRun();
+        script.Restart();
+
+        const size_t reservedAtStart = world.GetStreamer().GetReservedBytes();
+        int maxInUse = world.GetStreamer().GetStats().inUse;
+        int maxObstacles = sim.obstacles.Size();
+        int respawns = 0;
+
+        double totalSeconds = 0.0;
+        double worstStep = 0.0;
+        double worstUpdate = 0.0;
+
+        // -------------------- RUN LOOP --------------------
+        for (long long tick = 0; tick < maxTicks; ++tick) {
+            ControlInput input = idle ? ControlInput{} : script.Poll();
+
+            auto t0 = Clock::now();
+            sim.Step(input, tickDt);
+            auto t1 = Clock::now();
+            world.Update(sim);
+            auto t2 = Clock::now();
+
+            // The game idles between frames; uncapped stepping would starve
+            // the chunk worker on a single core, so give it that time here
+            std::this_thread::yield();
+
+            double update = std::chrono::duration<double>(t2 - t1).count();
+            double step = std::chrono::duration<double>(t2 - t0).count();
+            totalSeconds += step;
+            worstStep = step > worstStep ? step : worstStep;
+            worstUpdate = update > worstUpdate ? update : worstUpdate;
+
+            int inUse = world.GetStreamer().GetStats().inUse;
+            maxInUse = inUse > maxInUse ? inUse : maxInUse;
+            maxObstacles = sim.obstacles.Size() > maxObstacles ? sim.obstacles.Size() : maxObstacles;
+
+            // Respawn half a chunk lower, keeping the speed
+            if (sim.GetOutcome() != SimOutcome::RUNNING) {
+                respawns++;
+                sim.ResetRun();
+                sim.rocket.isAlive = true;
+                sim.rocket.position.y += EndlessWorld::CHUNK_SIZE * 0.5f;
+                sim.rocket.prevPosition = sim.rocket.position;
+            }
+        }
+
+        // -------------------- REPORT --------------------
+        ChunkStreamer::Stats stats = world.GetStreamer().GetStats();
+        double depth = world.GetDepth(sim);
+
+        std::printf("mode:        endless descent, seed %llu\n", opt.seed);
+        std::printf("tick rate:   %d Hz\n", opt.tickRate);
+        std::printf("pilot:       %s\n", opt.pilot.c_str());
+        std::printf("steps:       %lld (%.0f s of game time)\n", maxTicks, maxTicks * (double)tickDt);
+        std::printf("depth:       %.0f px (%.0f chunks), %d respawns, %lld rebases\n",
+            depth, depth / EndlessWorld::CHUNK_SIZE, respawns, world.GetRebaseCount());
+        std::printf("local pos:   (%.1f, %.1f), origin chunk (%lld, %lld)\n",
+            sim.rocket.position.x, sim.rocket.position.y,
+            (long long)world.GetOrigin().x, (long long)world.GetOrigin().y);
+        std::printf("step cost:   %.2f us mean, %.2f us worst (world update %.2f us worst)\n",
+            totalSeconds / maxTicks * 1e6, worstStep * 1e6, worstUpdate * 1e6);
+        std::printf("chunks:      %lld by worker, %lld inline, %lld waits, %lld released\n",
+            stats.prefetched, stats.generatedInline, stats.waits, stats.released);
+        std::printf("hitches:     %lld chunks not ready when reached\n", world.GetHitchCount());
+        std::printf("pool:        %d/%d slots peak, %zu bytes reserved (%zu at start)\n",
+            maxInUse, ChunkStreamer::POOL_SIZE, world.GetStreamer().GetReservedBytes(), reservedAtStart);
+        std::printf("obstacles:   %d merged, %d peak\n", sim.obstacles.Size(), maxObstacles);
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // Preset indices are checked against the pack in use
+    {
+        Simulation sim;
+        LevelManager levels;
+        if (!InitLevels(levels, sim, opt)) return 2;
+        if (opt.level >= levels.GetLevelCount() || opt.difficulty >= levels.GetDifficultyCount()) {
+            std::fprintf(stderr, "invalid option value: the pack has %d levels and %d difficulties\n",
+                levels.GetLevelCount(), levels.GetDifficultyCount());
+            return 2;
+        }
+    }
+
+    if (!opt.playPath.empty()) return PlayReplay(opt);
+    if (!opt.hashPath.empty()) return WriteHashes(opt);
+    if (opt.determinismThreads > 0) return CheckDeterminism(opt);
+    if (opt.rewind) return CheckRewind(opt);
+
+    if (opt.endless) {
+        ScriptedInput script;
+        BuildScript(script, opt.tickRate);
+        return RunEndless(opt, script);
+    }
+
+    SimulationClock clock(opt.tickRate);
+    const float tickDt = clock.GetTickDt();
+    const int maxTicks = opt.maxTicks > 0 ? opt.maxTicks : opt.tickRate * 60;
+
+    Simulation sim;
+    LevelManager levels(opt.seed);
+    InitLevels(levels, sim, opt);
+    levels.SetDifficulty(opt.difficulty, sim);
+    levels.SetLevel(opt.level, sim);
+
+    ScriptedInput script;
+    BuildScript(script, opt.tickRate);
+    const bool idle = opt.pilot == "idle";
+
+    int landed = 0;
+    int crashed = 0;
+    int timedOut = 0;
+    long long totalSteps = 0;
+
+    // -------------------- RUN LOOP --------------------
+    auto start = std::chrono::steady_clock::now();
+
+    ReplayRecorder recorder;
+
+    for (int run = 0; run < opt.runs; ++run) {
+        // A fresh layout every run (a restart would fly the same one again)
+        levels.SetLevel(opt.level, sim);
+        sim.ResetRun();
+        script.Restart();
+
+        const bool record = run == 0 && !opt.recordPath.empty();
+        if (record) {
+            ReplayHeader header;
+            header.difficulty = levels.GetDifficultyIndex();
+            header.level = levels.GetLevelIndex();
+            header.seed = levels.GetLayoutSeed();
+            header.pack = levels.GetPackHash();
+            header.tickRate = opt.tickRate;
+            recorder.Begin(header);
+        }
+
+        while (sim.GetOutcome() == SimOutcome::RUNNING && sim.GetTickCount() < maxTicks) {
+            ControlInput input = idle ? ControlInput{} : script.Poll();
+            if (record) recorder.Record(input, sim);
+            sim.Step(input, tickDt);
+        }
+
+        if (record && !recorder.Finish(sim).Save(opt.recordPath.c_str())) {
+            std::fprintf(stderr, "cannot write replay: %s\n", opt.recordPath.c_str());
+            return 1;
+        }
+
+        totalSteps += sim.GetTickCount();
+        switch (sim.GetOutcome()) {
+        case SimOutcome::LANDED:  landed++;   break;
+        case SimOutcome::CRASHED: crashed++;  break;
+        case SimOutcome::RUNNING: timedOut++; break;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    // -------------------- REPORT --------------------
+    std::printf("level:       %s\n", levels.GetLevelName());
+    std::printf("difficulty:  %s\n", levels.GetDifficultyName());
+    std::printf("tick rate:   %d Hz\n", opt.tickRate);
+    std::printf("pilot:       %s\n", opt.pilot.c_str());
+    std::printf("runs:        %d (landed %d, crashed %d, timed out %d)\n",
+        opt.runs, landed, crashed, timedOut);
+    std::printf("steps:       %lld in %.3f s\n", totalSteps, seconds);
+    std::printf("steps/sec:   %.0f (%.1fx real time)\n",
+        seconds > 0.0 ? totalSteps / seconds : 0.0,
+        seconds > 0.0 ? (totalSteps * (double)tickDt) / seconds : 0.0);
+    std::printf("obstacles:   %d, %.1f posed per step\n",
+        sim.obstacles.Size(), sim.activity.GetMeanPosed());
+    return 0;
+}
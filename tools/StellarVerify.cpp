@@ -0,0 +1,478 @@
+// stellar_verify: parallel headless replay verifier.
+//
+// Re-simulates every replay (*.sdr) in a directory at full speed on all
+// cores and checks each one's claimed outcome, score and final state hash
+// against what its inputs actually produce. Nothing the replay claims about
+// the run is trusted: only the world description (mode, preset, seed) and
+// the inputs are used, never the keyframes. Replays at any tick rate but the
+// game's fixed one, or with inputs no controller can produce (throttle
+// outside [0,1], rotate outside [-1,1]), are rejected outright.
+//
+//   stellar_verify DIR [--threads N] [--max-minutes M] [--verbose] [--pack FILE]
+//   stellar_verify DIR --generate N [--seed S] [--pack FILE]
+//   stellar_verify --self-check
+//
+// Prints one line per rejected replay (every replay with --verbose), then
+// totals and throughput in replays/second. Exits 1 if any replay fails.
+//
+// --generate N first fills DIR with N replays flown by the Monte-Carlo
+// pilots over every preset, as a corpus for measuring throughput.
+//
+// --self-check writes honest and hostile replays (impossible inputs, a
+// foreign tick rate, truncated files, headers claiming huge or overflowing
+// counts, keyframes pointing past their input run) to a temporary directory and checks the verdict on each; the
+// verifier must turn every bad file away without crashing. Exits 1 if any
+// verdict is wrong.
+//
+// --pack FILE uses a compiled level pack instead of the built-in presets;
+// LEVEL replays recorded against any other presets fail as "no such world".
+
+#include "EndlessWorld.h"
+#include "LevelManager.h"
+#include "Pilots.h"
+#include "Random.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "SimulationClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct Options {
+        std::string dir;
+        int threads = 0;              // 0 = all hardware threads
+        float maxMinutes = 30.0f;     // longer claimed runs are rejected unplayed
+        bool verbose = false;
+        int generate = 0;
+        unsigned long long seed = 1;
+        std::string packPath;         // empty = built-in presets
+        bool selfCheck = false;
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: stellar_verify DIR [--threads N] [--max-minutes M] [--verbose] [--pack FILE]\n"
+            "       stellar_verify DIR --generate N [--seed S] [--pack FILE]\n"
+            "       stellar_verify --self-check\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--help" || arg == "-h") { PrintUsage(); std::exit(0); }
+            else if (arg == "--threads" && hasValue) opt.threads = std::atoi(argv[++i]);
+            else if (arg == "--max-minutes" && hasValue) opt.maxMinutes = (float)std::atof(argv[++i]);
+            else if (arg == "--verbose") opt.verbose = true;
+            else if (arg == "--generate" && hasValue) opt.generate = std::atoi(argv[++i]);
+            else if (arg == "--seed" && hasValue) opt.seed = std::strtoull(argv[++i], nullptr, 10);
+            else if (arg == "--pack" && hasValue) opt.packPath = argv[++i];
+            else if (arg == "--self-check") opt.selfCheck = true;
+            else if (arg[0] != '-' && opt.dir.empty()) opt.dir = arg;
+            else {
+                std::fprintf(stderr, "unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        if ((opt.dir.empty() && !opt.selfCheck) || opt.threads < 0 || opt.maxMinutes <= 0.0f || opt.generate < 0) {
+            std::fprintf(stderr, "invalid option value\n");
+            return false;
+        }
+        return true;
+    }
+
+    /// Presets from --pack if given, else the built-in ones; then Init().
+    bool InitLevels(LevelManager& levels, Simulation& sim, const Options& opt)
+    {
+        std::string error;
+        if (!opt.packPath.empty() && !levels.LoadPack(opt.packPath.c_str(), &error)) {
+            std::fprintf(stderr, "cannot load level pack: %s\n", error.c_str());
+            return false;
+        }
+        levels.Init(sim);
+        return true;
+    }
+
+    const char* OutcomeName(SimOutcome o)
+    {
+        return o == SimOutcome::LANDED ? "landed" : o == SimOutcome::CRASHED ? "crashed" : "running";
+    }
+
+    // -------------------- VERIFICATION --------------------
+    enum class Verdict { OK, UNREADABLE, BAD_WORLD, TICK_RATE, TOO_LONG, BAD_INPUT, OUTCOME, SCORE, HASH };
+
+    const char* VerdictName(Verdict v)
+    {
+        switch (v) {
+        case Verdict::OK:         return "ok";
+        case Verdict::UNREADABLE: return "not a readable replay";
+        case Verdict::BAD_WORLD:  return "no such world";
+        case Verdict::TICK_RATE:  return "not at the game's tick rate";
+        case Verdict::TOO_LONG:   return "longer than --max-minutes";
+        case Verdict::BAD_INPUT:  return "input out of range";
+        case Verdict::OUTCOME:    return "outcome does not match";
+        case Verdict::SCORE:      return "score does not match";
+        case Verdict::HASH:       return "final state does not match";
+        }
+        return "?";
+    }
+
+    struct Result {
+        Verdict verdict = Verdict::UNREADABLE;
+        SimOutcome outcome = SimOutcome::RUNNING;   // as re-simulated
+        float score = 0.0f;
+        int ticks = 0;
+    };
+
+    /// Everything a worker reuses from one replay to the next.
+    struct Verifier {
+        Simulation sim;
+        LevelManager levels;
+        EndlessWorld endless;
+        Replay replay;
+        std::vector<uint8_t> bytes;
+
+        explicit Verifier(const Options& opt) { InitLevels(levels, sim, opt); }
+
+        Result Verify(const std::string& path, const Options& opt)
+        {
+            // The header alone decides whether the body is worth decoding
+            Result result;
+            if (!Replay::ReadFile(path.c_str(), bytes) || !replay.DeserializeHeader(bytes.data(), bytes.size())) return result;
+
+            const ReplayHeader& h = replay.header;
+            if (h.tickRate != SimulationClock::DEFAULT_TICK_RATE) {
+                // The tick rate is the integration step: a replay must not choose its own
+                result.verdict = Verdict::TICK_RATE;
+                return result;
+            }
+            if (replay.tickCount > (double)opt.maxMinutes * 60.0 * h.tickRate) {
+                result.verdict = Verdict::TOO_LONG;
+                return result;
+            }
+            if (!replay.Deserialize(bytes.data(), bytes.size())) return result;
+
+            ReplayPlayer player(replay);
+            if (!player.LoadWorld(sim, levels, &endless)) {
+                result.verdict = Verdict::BAD_WORLD;
+                return result;
+            }
+            const bool isEndless = h.mode == ReplayMode::ENDLESS;
+            const float dt = 1.0f / (float)SimulationClock::DEFAULT_TICK_RATE;
+
+            // Recording stops when the run ends, so stepping on past an
+            // outcome would only hide a mismatch
+            while (sim.GetTickCount() < replay.tickCount && sim.GetOutcome() == SimOutcome::RUNNING) {
+                ControlInput input = player.Poll();
+
+                // Physics does not clamp (the controls never exceed these), so
+                // a stream that does was not recorded by the game. Written so
+                // NaN fails too.
+                if (!(input.throttle >= 0.0f && input.throttle <= 1.0f) ||
+                    !(input.rotate >= -1.0f && input.rotate <= 1.0f)) {
+                    result.verdict = Verdict::BAD_INPUT;
+                    result.ticks = (int)sim.GetTickCount();
+                    return result;
+                }
+
+                sim.Step(input, dt);
+                if (isEndless) endless.Update(sim);
+            }
+
+            result.outcome = sim.GetOutcome();
+            result.score = sim.score;
+            result.ticks = (int)sim.GetTickCount();
+
+            if (result.outcome != replay.outcome || result.ticks != replay.tickCount) result.verdict = Verdict::OUTCOME;
+            else if (std::memcmp(&result.score, &replay.score, sizeof(float)) != 0) result.verdict = Verdict::SCORE;
+            else if (sim.GetStateHash() != replay.finalHash) result.verdict = Verdict::HASH;
+            else result.verdict = Verdict::OK;
+            return result;
+        }
+    };
+
+    // Replays are handed out one at a time from an atomic counter: they vary
+    // from a few seconds to many minutes, so chunking would balance badly
+    void Worker(const Options& opt, const std::vector<std::string>& paths,
+        std::atomic<size_t>& next, std::vector<Result>& results)
+    {
+        Verifier verifier(opt);
+        for (;;) {
+            size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= paths.size()) break;
+            results[i] = verifier.Verify(paths[i], opt);
+        }
+    }
+
+    // -------------------- CORPUS --------------------
+    int Generate(const Options& opt)
+    {
+        const int tickRate = SimulationClock::DEFAULT_TICK_RATE;
+        const float dt = 1.0f / (float)tickRate;
+        const long long maxTicks = (long long)tickRate * 60;
+
+        std::error_code ec;
+        fs::create_directories(opt.dir, ec);
+
+        Simulation sim;
+        LevelManager levels;
+        if (!InitLevels(levels, sim, opt)) return 1;
+        RandomPilot randomPilot(0, tickRate);
+        HeuristicPilot heuristicPilot(sim, 0);
+        ReplayRecorder recorder;
+
+        const int presets = levels.GetDifficultyCount() * levels.GetLevelCount();
+        for (int run = 0; run < opt.generate; ++run) {
+            uint64_t runSeed = MixSeed(opt.seed, (uint64_t)run);
+            int preset = run % presets;
+
+            levels.SetSeed(runSeed);
+            levels.SetPreset(preset / levels.GetLevelCount(), preset % levels.GetLevelCount(), sim);
+            sim.ResetRun();
+
+            InputSource* pilot;
+            if ((run / presets) % 2 == 0) {
+                heuristicPilot.Reseed(runSeed);
+                pilot = &heuristicPilot;
+            }
+            else {
+                randomPilot.Reseed(runSeed);
+                pilot = &randomPilot;
+            }
+
+            ReplayHeader header;
+            header.difficulty = levels.GetDifficultyIndex();
+            header.level = levels.GetLevelIndex();
+            header.seed = levels.GetLayoutSeed();
+            header.pack = levels.GetPackHash();
+            header.tickRate = tickRate;
+            recorder.Begin(header);
+
+            while (sim.GetOutcome() == SimOutcome::RUNNING && sim.GetTickCount() < maxTicks) {
+                ControlInput input = pilot->Poll();
+                recorder.Record(input, sim);
+                sim.Step(input, dt);
+            }
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "gen-%06d.sdr", run);
+            std::string path = (fs::path(opt.dir) / name).string();
+            if (!recorder.Finish(sim).Save(path.c_str())) {
+                std::fprintf(stderr, "cannot write replay: %s\n", path.c_str());
+                return 1;
+            }
+        }
+        std::fprintf(stderr, "generated %d replays in %s\n", opt.generate, opt.dir.c_str());
+        return 0;
+    }
+
+    // -------------------- SELF CHECK --------------------
+    /// Fly level 1 with the heuristic pilot; @p tamper may rewrite each input.
+    template <typename Tamper>
+    Replay Fly(int tickRate, Tamper tamper)
+    {
+        Simulation sim;
+        LevelManager levels;
+        levels.Init(sim);
+        levels.SetSeed(7);
+        levels.SetPreset(0, 0, sim);
+        sim.ResetRun();
+        HeuristicPilot pilot(sim, 7);
+
+        ReplayHeader header;
+        header.difficulty = levels.GetDifficultyIndex();
+        header.level = levels.GetLevelIndex();
+        header.seed = levels.GetLayoutSeed();
+        header.pack = levels.GetPackHash();
+        header.tickRate = tickRate;
+        ReplayRecorder recorder;
+        recorder.Begin(header);
+
+        const float dt = 1.0f / (float)tickRate;
+        for (int tick = 0; tick < tickRate * 20 && sim.GetOutcome() == SimOutcome::RUNNING; ++tick) {
+            ControlInput input = pilot.Poll();
+            tamper(tick, input);
+            recorder.Record(input, sim);
+            sim.Step(input, dt);
+        }
+        return recorder.Finish(sim);
+    }
+
+    void PokeU32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i) bytes[offset + i] = (uint8_t)(value >> (8 * i));
+    }
+
+    int SelfCheck(const Options& opt)
+    {
+        std::error_code ec;
+        fs::path temp = fs::temp_directory_path(ec) / "stellar_verify_check";
+        fs::remove_all(temp, ec);
+        fs::create_directories(temp, ec);
+        if (ec) {
+            std::fprintf(stderr, "cannot create %s\n", temp.string().c_str());
+            return 2;
+        }
+
+        struct Case { const char* what; std::vector<uint8_t> bytes; Verdict expected; };
+        std::vector<Case> cases;
+        auto add = [&](const char* what, const Replay& replay, Verdict expected) {
+            Case c{ what, {}, expected };
+            replay.Serialize(c.bytes);
+            cases.push_back(c);
+        };
+        const int rate = SimulationClock::DEFAULT_TICK_RATE;
+
+        Replay honest = Fly(rate, [](int, ControlInput&) {});
+        add("honest run", honest, Verdict::OK);
+        add("throttle 8.0", Fly(rate, [](int tick, ControlInput& in) { if (tick > 30) in.throttle = 8.0f; }), Verdict::BAD_INPUT);
+        add("rotate 40.0", Fly(rate, [](int tick, ControlInput& in) { if (tick > 30) in.rotate = 40.0f; }), Verdict::BAD_INPUT);
+        add("240 Hz", Fly(240, [](int, ControlInput&) {}), Verdict::TICK_RATE);
+
+        Replay skipping = honest;
+        if (skipping.keyframes.size() > 1) skipping.keyframes[1].runSkip = 100000;
+        add("keyframe skips past its input run", skipping, Verdict::UNREADABLE);
+
+        Case truncated{ "truncated body", {}, Verdict::UNREADABLE };
+        honest.Serialize(truncated.bytes);
+        truncated.bytes.resize(truncated.bytes.size() / 2);
+        cases.push_back(truncated);
+
+        // Header only, no inputs, no keyframes: the last word is the
+        // keyframe count, the header's ticks and interval come before
+        Replay empty;
+        empty.header = honest.header;
+        std::vector<uint8_t> bare;
+        empty.Serialize(bare);
+        const size_t countAt = bare.size() - 4;
+        const size_t intervalAt = countAt - 4 - 8 - 4 - 1 - 4 - 4;
+
+        Case huge{ "huge keyframe count, no payload", bare, Verdict::UNREADABLE };
+        PokeU32(huge.bytes, intervalAt, 1);
+        PokeU32(huge.bytes, intervalAt + 4, 200000);        // inside --max-minutes
+        PokeU32(huge.bytes, countAt, 200000);
+        cases.push_back(huge);
+
+        Case longer{ "huge tick count (rejected on the header)", huge.bytes, Verdict::TOO_LONG };
+        PokeU32(longer.bytes, intervalAt + 4, 0x7fffffff);
+        PokeU32(longer.bytes, countAt, 0x7fffffff);
+        cases.push_back(longer);
+
+        Case overflow{ "tick count + interval overflow", bare, Verdict::UNREADABLE };
+        PokeU32(overflow.bytes, intervalAt, 0x7fffffff);
+        PokeU32(overflow.bytes, intervalAt + 4, 200000);
+        PokeU32(overflow.bytes, countAt, 1);
+        cases.push_back(overflow);
+
+        // With no length limit the huge header reaches the body decoder
+        Options unlimited = opt;
+        unlimited.maxMinutes = 1e9f;
+        Verifier verifier(opt);
+        Verifier permissive(unlimited);
+        int wrong = 0;
+        for (size_t i = 0; i < cases.size(); ++i) {
+            std::string path = (temp / ("case-" + std::to_string(i) + ".sdr")).string();
+            FILE* file = std::fopen(path.c_str(), "wb");
+            if (file) {
+                std::fwrite(cases[i].bytes.data(), 1, cases[i].bytes.size(), file);
+                std::fclose(file);
+            }
+
+            Verdict got = verifier.Verify(path, opt).verdict;
+            bool ok = got == cases[i].expected;
+            if (ok && cases[i].expected == Verdict::TOO_LONG) ok = permissive.Verify(path, unlimited).verdict == Verdict::UNREADABLE;
+            if (!ok) wrong++;
+            std::printf("%-44s %-28s %s\n", cases[i].what, VerdictName(got), ok ? "ok" : "WRONG");
+        }
+
+        fs::remove_all(temp, ec);
+        std::printf("self-check: %s\n", wrong == 0 ? "ok" : "FAILED");
+        return wrong == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage();
+        return 2;
+    }
+
+    if (opt.selfCheck) return SelfCheck(opt);
+    if (opt.generate > 0 && Generate(opt) != 0) return 1;
+
+    // Check the pack once here rather than once per worker
+    if (!opt.packPath.empty()) {
+        Simulation probeSim;
+        LevelManager probe;
+        if (!InitLevels(probe, probeSim, opt)) return 2;
+    }
+
+    // -------------------- REPLAY LIST --------------------
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (fs::directory_iterator it(opt.dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file() && it->path().extension() == ".sdr") paths.push_back(it->path().string());
+    }
+    if (ec) {
+        std::fprintf(stderr, "cannot read directory: %s\n", opt.dir.c_str());
+        return 2;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    int threadCount = opt.threads > 0 ? opt.threads : (int)std::thread::hardware_concurrency();
+    if (threadCount < 1) threadCount = 1;
+
+    // -------------------- RUN --------------------
+    std::vector<Result> results(paths.size());
+    std::atomic<size_t> next(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back(Worker, std::cref(opt), std::cref(paths), std::ref(next), std::ref(results));
+    }
+    for (auto& w : workers) w.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    // -------------------- REPORT --------------------
+    int failed = 0;
+    long long ticks = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const Result& r = results[i];
+        ticks += r.ticks;
+        if (r.verdict != Verdict::OK) failed++;
+        if (r.verdict != Verdict::OK || opt.verbose) {
+            std::printf("%-4s %s: %s (%s, score %.1f, %d ticks)\n",
+                r.verdict == Verdict::OK ? "ok" : "FAIL", paths[i].c_str(), VerdictName(r.verdict),
+                OutcomeName(r.outcome), r.score, r.ticks);
+        }
+    }
+
+    std::printf("replays:     %zu (%zu verified, %d rejected)\n", paths.size(), paths.size() - failed, failed);
+    std::printf("ticks:       %lld re-simulated\n", ticks);
+    std::printf("threads:     %d\n", threadCount);
+    std::printf("time:        %.2f s (%.0f replays/sec, %.0f steps/sec)\n", seconds,
+        seconds > 0.0 ? paths.size() / seconds : 0.0, seconds > 0.0 ? ticks / seconds : 0.0);
+    return failed == 0 ? 0 : 1;
+}
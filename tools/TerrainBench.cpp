@@ -0,0 +1,322 @@
+// Terrain query benchmark + property test.
+//
+// Checks the heightfield queries against brute-force references on
+// generated terrains:
+//   HeightAt          linear search for the segment under x
+//   IntersectSegment  the segment stepped in small increments
+//   Clearance         the box outline sampled densely against HeightAt
+//   SweepBox          the sweep stepped in small increments; the contact
+//                     may come early by the contact tolerance, never late
+// then times each query against a scan over every sample, which is what
+// a query that does not index its columns would cost. Exit code is
+// non-zero on any mismatch.
+//
+//   terrain_bench            verify + benchmark
+//   terrain_bench --verify   property test only
+
+#include "SimMath.h"
+#include "SweptCollision.h"
+#include "Terrain.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    const Vector2 ROCKET_HALF = { 5.0f, 15.0f };
+
+    Terrain MakeTerrain(unsigned seed, float width)
+    {
+        Terrain::Settings s;
+        s.minX = -width * 0.5f;
+        s.maxX = width * 0.5f;
+        s.padCenterX = 0.0f;
+        s.craterCount = (int)(width / 600.0f);
+
+        Terrain terrain;
+        terrain.Generate(s, seed);
+        return terrain;
+    }
+
+    // -------------------- REFERENCES --------------------
+    float ReferenceHeight(const Terrain& terrain, float x)
+    {
+        for (int i = 0; i + 1 < terrain.GetSampleCount(); ++i) {
+            float x0 = terrain.GetSampleX(i), x1 = terrain.GetSampleX(i + 1);
+            if (x >= x0 && x <= x1) {
+                float u = (x - x0) / (x1 - x0);
+                return terrain.GetSample(i) + (terrain.GetSample(i + 1) - terrain.GetSample(i)) * u;
+            }
+        }
+        return Terrain::NO_GROUND;
+    }
+
+    // Largest y of the box outline at x, over all four edges
+    float ReferenceOutline(const SimMath::OrientedBox& box, float x)
+    {
+        float lowest = -INFINITY;
+        for (int i = 0; i < 4; ++i) {
+            Vector2 a = box.verts[i], b = box.verts[(i + 1) & 3];
+            float lo = a.x < b.x ? a.x : b.x, hi = a.x < b.x ? b.x : a.x;
+            if (x < lo || x > hi || hi <= lo) continue;
+            float y = a.y + (b.y - a.y) * ((x - a.x) / (b.x - a.x));
+            lowest = y > lowest ? y : lowest;
+        }
+        return lowest;
+    }
+
+    float ReferenceClearance(const Terrain& terrain, const SimMath::OrientedBox& box)
+    {
+        float minX = box.verts[0].x, maxX = box.verts[0].x;
+        for (int i = 1; i < 4; ++i) {
+            minX = box.verts[i].x < minX ? box.verts[i].x : minX;
+            maxX = box.verts[i].x > maxX ? box.verts[i].x : maxX;
+        }
+
+        const int steps = 2000;
+        float best = Terrain::NO_GROUND;
+        for (int k = 0; k <= steps; ++k) {
+            float x = minX + (maxX - minX) * ((float)k / steps);
+            float h = terrain.HeightAt(x);
+            float y = ReferenceOutline(box, x);
+            if (h == Terrain::NO_GROUND || y == -INFINITY) continue;
+            best = (h - y) < best ? (h - y) : best;
+        }
+        return best;
+    }
+
+    void PoseAt(const BoxSweep& sweep, float t, SimMath::OrientedBox& out)
+    {
+        Vector2 c = { sweep.startCenter.x + (sweep.endCenter.x - sweep.startCenter.x) * t,
+                      sweep.startCenter.y + (sweep.endCenter.y - sweep.startCenter.y) * t };
+        SimMath::BuildOrientedBox(c, sweep.half, sweep.startRotation + (sweep.endRotation - sweep.startRotation) * t, out);
+    }
+
+    // -------------------- PROPERTY TEST --------------------
+    bool Verify()
+    {
+        bool ok = true;
+        long long checks = 0, hits = 0;
+        std::mt19937 rng(7u);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        for (unsigned seed = 1; seed <= 20; ++seed) {
+            Terrain terrain = MakeTerrain(seed, 2000.0f);
+            float minX = terrain.GetMinX(), maxX = terrain.GetMaxX();
+            auto randX = [&]() { return minX - 40.0f + (maxX - minX + 80.0f) * unit(rng); };
+            auto randY = [&]() { return 200.0f + 180.0f * unit(rng); };
+
+            // Heights, including samples exactly and the edges
+            for (int k = 0; k < 2000; ++k) {
+                float x = (k & 7) == 0 ? terrain.GetSampleX(k % terrain.GetSampleCount()) : randX();
+                float fast = terrain.HeightAt(x), ref = ReferenceHeight(terrain, x);
+                bool bothVoid = fast == Terrain::NO_GROUND && ref == Terrain::NO_GROUND;
+                if (!bothVoid && fabsf(fast - ref) > 1e-3f) {
+                    std::printf("MISMATCH: HeightAt(%g) seed=%u: %g vs %g\n", x, seed, fast, ref);
+                    ok = false;
+                }
+                checks++;
+            }
+
+            // Segments: short (one step of motion) and long (across many columns)
+            for (int k = 0; k < 500; ++k) {
+                float len = (k & 1) ? 4.0f : 300.0f;
+                Vector2 a = { randX(), randY() };
+                Vector2 b = { a.x + (unit(rng) - 0.5f) * 2.0f * len, a.y + (unit(rng) - 0.5f) * 2.0f * len };
+                if (k % 10 == 0) b.x = a.x;   // vertical
+
+                const int steps = 20000;
+                int first = -1;
+                float minGap = INFINITY;
+                for (int j = 0; j <= steps; ++j) {
+                    float s = (float)j / steps;
+                    float h = terrain.HeightAt(a.x + (b.x - a.x) * s);
+                    if (h == Terrain::NO_GROUND) continue;
+                    float gap = h - (a.y + (b.y - a.y) * s);
+                    minGap = gap < minGap ? gap : minGap;
+                    if (gap <= 0.0f && first < 0) first = j;
+                }
+
+                // Compared in pixels along the segment: near an edge the
+                // reference rounds x, and a steep segment turns that into t
+                float t;
+                Vector2 n;
+                bool hit = terrain.IntersectSegment(a, b, t, n);
+                float tRef = (float)first / steps;
+                float length = sqrtf((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+                bool bad = (first >= 0 && (!hit || (t - tRef) * length > 1e-2f)) ||
+                    (hit && first < 0 && minGap > 1e-2f) ||
+                    (hit && first >= 0 && (tRef - t) * length > 2.0f * length / steps + 1e-2f);
+                if (bad) {
+                    std::printf("MISMATCH: IntersectSegment seed=%u k=%d: %s t=%g vs %s t=%g\n",
+                        seed, k, hit ? "hit" : "miss", hit ? t : 0.0f, first >= 0 ? "hit" : "miss", tRef);
+                    ok = false;
+                }
+                hits += hit;
+                checks++;
+            }
+
+            // Boxes at rest: any rotation, near the surface
+            for (int k = 0; k < 300; ++k) {
+                Vector2 c = { randX(), terrain.HeightAt(0.0f) - 20.0f + 40.0f * unit(rng) };
+                float h = terrain.HeightAt(c.x);
+                if (h != Terrain::NO_GROUND) c.y = h - 20.0f + 40.0f * unit(rng);
+                float rot = (k % 4 == 0) ? 90.0f * (float)(k % 3) : 360.0f * unit(rng);
+
+                SimMath::OrientedBox box;
+                SimMath::BuildOrientedBox(c, ROCKET_HALF, rot, box);
+                Vector2 p;
+                float fast = terrain.Clearance(box, p);
+                float ref = ReferenceClearance(terrain, box);
+
+                // The dense reference can only miss the exact minimum by a sliver
+                bool bothVoid = fast == Terrain::NO_GROUND && ref == Terrain::NO_GROUND;
+                if (!bothVoid && (fast > ref + 1e-3f || fast < ref - 0.05f)) {
+                    std::printf("MISMATCH: Clearance seed=%u k=%d: %g vs %g\n", seed, k, fast, ref);
+                    ok = false;
+                }
+                checks++;
+            }
+
+            // Sweeps: a few ticks of descent with drift and spin
+            for (int k = 0; k < 200; ++k) {
+                BoxSweep sweep;
+                sweep.half = ROCKET_HALF;
+                sweep.startCenter = { randX(), 0.0f };
+                float h = terrain.HeightAt(sweep.startCenter.x);
+                sweep.startCenter.y = (h == Terrain::NO_GROUND ? 310.0f : h) - 16.0f - 30.0f * unit(rng);
+                sweep.endCenter = { sweep.startCenter.x + (unit(rng) - 0.5f) * 40.0f,
+                                    sweep.startCenter.y + 40.0f * unit(rng) };
+                sweep.startRotation = 60.0f * (unit(rng) - 0.5f);
+                sweep.endRotation = sweep.startRotation + 30.0f * (unit(rng) - 0.5f);
+
+                SimMath::OrientedBox start;
+                PoseAt(sweep, 0.0f, start);
+                SweptContact c;
+                bool hit = terrain.SweepBox(sweep, start, c);
+
+                const int steps = 4000;
+                int first = -1;
+                for (int j = 0; j <= steps && first < 0; ++j) {
+                    SimMath::OrientedBox box;
+                    PoseAt(sweep, (float)j / steps, box);
+                    Vector2 p;
+                    if (terrain.Clearance(box, p) <= 0.0f) first = j;
+                }
+
+                float tRef = (float)first / steps;
+                bool bad = (first >= 0 && (!hit || c.toi > tRef + 1.0f / steps));
+                if (hit) {
+                    SimMath::OrientedBox box;
+                    PoseAt(sweep, c.toi, box);
+                    Vector2 p;
+                    bad = bad || terrain.Clearance(box, p) > SweptCollision::CONTACT_TOLERANCE;
+                }
+                if (bad) {
+                    std::printf("MISMATCH: SweepBox seed=%u k=%d: %s toi=%g vs %s t=%g\n",
+                        seed, k, hit ? "hit" : "miss", hit ? c.toi : 0.0f, first >= 0 ? "hit" : "miss", tRef);
+                    ok = false;
+                }
+                hits += hit;
+                checks++;
+            }
+        }
+
+        std::printf("property test: %s (%lld queries, %lld hits)\n", ok ? "ok" : "FAILED", checks, hits);
+        return ok;
+    }
+
+    // -------------------- BENCHMARK --------------------
+    // Clearance over every sample, as an unindexed query would do
+    float ScanClearance(const Terrain& terrain, const SimMath::OrientedBox& box)
+    {
+        float best = Terrain::NO_GROUND;
+        for (int i = 0; i < terrain.GetSampleCount(); ++i) {
+            float y = ReferenceOutline(box, terrain.GetSampleX(i));
+            if (y == -INFINITY) continue;
+            float gap = terrain.GetSample(i) - y;
+            best = gap < best ? gap : best;
+        }
+        return best;
+    }
+
+    void Benchmark()
+    {
+        const float widths[] = { 2000.0f, 20000.0f, 200000.0f };
+        const int queries = 4096;
+
+        std::printf("\n%10s %8s %10s %10s %10s %10s %10s\n", "width", "samples",
+            "height ns", "segment ns", "clear ns", "sweep ns", "scan ns");
+
+        for (float width : widths) {
+            Terrain terrain = MakeTerrain(99u, width);
+            std::mt19937 rng(5u);
+            std::uniform_real_distribution<float> xs(terrain.GetMinX(), terrain.GetMaxX());
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            std::vector<Vector2> points(queries);
+            std::vector<SimMath::OrientedBox> boxes(queries);
+            std::vector<BoxSweep> sweeps(queries);
+            for (int i = 0; i < queries; ++i) {
+                float x = xs(rng);
+                points[i] = { x, terrain.HeightAt(x) - 30.0f * unit(rng) };
+                sweeps[i].half = ROCKET_HALF;
+                sweeps[i].startCenter = { x, points[i].y - 15.0f };
+                sweeps[i].endCenter = { x + 1.0f, points[i].y - 14.0f + unit(rng) };
+                sweeps[i].startRotation = 20.0f * unit(rng);
+                sweeps[i].endRotation = sweeps[i].startRotation + 1.0f;
+                PoseAt(sweeps[i], 0.0f, boxes[i]);
+            }
+
+            volatile float sink = 0.0f;
+            auto time = [&](auto&& body) {
+                const int reps = 50;
+                auto t0 = Clock::now();
+                for (int r = 0; r < reps; ++r) {
+                    for (int i = 0; i < queries; ++i) body(i);
+                }
+                return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / ((double)reps * queries);
+            };
+
+            double heightNs = time([&](int i) { sink = sink + terrain.HeightAt(points[i].x); });
+            double segmentNs = time([&](int i) {
+                float t;
+                Vector2 n;
+                Vector2 b = { points[i].x + 3.0f, points[i].y + 40.0f };
+                if (terrain.IntersectSegment(points[i], b, t, n)) sink = sink + t;
+            });
+            double clearNs = time([&](int i) {
+                Vector2 p;
+                sink = sink + terrain.Clearance(boxes[i], p);
+            });
+            double sweepNs = time([&](int i) {
+                SweptContact c;
+                if (terrain.SweepBox(sweeps[i], boxes[i], c)) sink = sink + c.toi;
+            });
+
+            // Full scans are slow on wide terrains; time a slice of the queries
+            auto t0 = Clock::now();
+            const int scanQueries = 256;
+            for (int i = 0; i < scanQueries; ++i) sink = sink + ScanClearance(terrain, boxes[i]);
+            double scanNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / scanQueries;
+
+            std::printf("%10.0f %8d %10.1f %10.1f %10.1f %10.1f %10.0f\n", width, terrain.GetSampleCount(),
+                heightNs, segmentNs, clearNs, sweepNs, scanNs);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool verifyOnly = argc > 1 && std::strcmp(argv[1], "--verify") == 0;
+
+    if (!Verify()) return 1;
+    if (!verifyOnly) Benchmark();
+    return 0;
+}